@@ -6,7 +6,7 @@
 
 /**
  * @file axis_control_demo.cpp
- * @brief 四足机器人轴控制Demo - 心跳+运动控制 (Windows版)
+ * @brief 四足机器人轴控制Demo - 心跳+运动控制 (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
  * 运行: axis_control_demo.exe
@@ -22,26 +22,23 @@
 
 #include <cstring>
 #include <cstdint>
-#include <thread>
-#include <atomic>
 #include <iostream>
 
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include "control_loop.h"
+#include "motion_monitor.h"
+#include "net_platform.h"
+#include "udp_transport.h"
+
+using namespace q25;
 
 // ============ 配置 ============
 const char* ROBOT_IP = "192.168.3.20";
 const int ROBOT_PORT = 43893;
 
-// ============ 命令码 ============
-constexpr uint32_t CMD_HEARTBEAT     = 0x21040001;
-constexpr uint32_t CMD_STAND_UP      = 0x21010202;
-constexpr uint32_t CMD_LIE_DOWN   = 0x21010222;
-constexpr uint32_t CMD_LEFT_YAXIS    = 0x21010130;  // 左摇杆Y轴（前后）
-constexpr uint32_t CMD_LEFT_XAXIS    = 0x21010131;  // 左摇杆X轴（左右）
-constexpr uint32_t CMD_RIGHT_XAXIS   = 0x21010135;  // 右摇杆X轴（旋转）
+// 站立 / 趴下以上报的机身高度判定，依赖暂定的 MotionData 布局（见 status_protocol.h）
+// 状态等待超时（毫秒），超时后给出警告并继续
+const int STAND_TIMEOUT_MS = 15000;
+const int TRANSITION_TIMEOUT_MS = 10000;
 
 // ============ 轴值定义 ============
 // 左摇杆Y轴（前后）死区: -6553 ~ 6553
@@ -58,117 +55,85 @@ constexpr int32_t AXIS_TURN_RIGHT = 30000;   // 右转（超过28212即可）
 
 constexpr int32_t AXIS_STOP = 0;  // 停止（所有轴）
 
-// ============ UDP命令结构 ============
-#pragma pack(push, 1)
-struct UDPCommand {
-    uint32_t code;
-    uint32_t parameters_size;  // 对于轴指令，这个字段存储轴值
-    uint32_t type;
-
-    UDPCommand(uint32_t cmd, int32_t param = 0)
-        : code(cmd)
-        , parameters_size(static_cast<uint32_t>(param))  // 将int32_t转为uint32_t
-        , type(0) {}
-};
-#pragma pack(pop)
-
-// ============ UDP发送函数 ============
-void sendCommand(const char* ip, int port, uint32_t cmd_code, int32_t param = 0) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) return;
-
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
-
-    UDPCommand cmd(cmd_code, param);
-    sendto(sock, reinterpret_cast<const char*>(&cmd), sizeof(cmd), 0, 
-           (struct sockaddr*)&addr, sizeof(addr));
-
-    closesocket(sock);
+// ============ 轴值发送频率 ============
+// 默认 100Hz，可按需要调整为 200~500Hz
+constexpr double AXIS_RATE_HZ = 100.0;
+
+// ============ 单轴指令转换 ============
+// 单轴轴值换算后合并为扩展轴值指令 0x21010140 发送（见 axis_translator.h），
+// 轴值不变时只每 AXIS_KEEPALIVE_MS 重发一次；改为 false 时按原单轴指令逐周期发送
+constexpr bool MERGE_AXIS_VALUES = true;
+constexpr int AXIS_KEEPALIVE_MS = 100;
+
+// ============ 发送通道 ============
+// 所有指令复用同一个已 connect 的 socket
+UdpTransport transport;
+
+// ============ 控制循环 ============
+// 心跳、轴值流与一次性指令由同一个线程按 AXIS_RATE_HZ 统一发送
+ControlLoopConfig axisLoopConfig() {
+    ControlLoopConfig config;
+    config.axis_rate_hz = AXIS_RATE_HZ;
+    config.merge_axis_values = MERGE_AXIS_VALUES;
+    config.axis_keepalive_ms = MERGE_AXIS_VALUES ? AXIS_KEEPALIVE_MS : 0;
+    return config;
 }
 
-// ============ 心跳线程 ============
-std::atomic<bool> heartbeat_running(true);
+ControlLoop loop(transport, axisLoopConfig());
 
-void heartbeatThread() {
-    while (heartbeat_running) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_HEARTBEAT);
-        Sleep(500);  // 500ms = 2Hz
-    }
+// ============ 状态监视 ============
+// 接收机器人上报的运动状态，指令发出后等待到达目标状态，而不是固定 Sleep
+MotionMonitor monitor;
+
+// ============ 轴值流发送 ============
+// 由控制循环按 AXIS_RATE_HZ 持续发送单轴指令 duration_sec 秒，到期由控制循环的定时器发送停止轴值
+void streamAxis(uint32_t axis_code, int32_t axis_value, int duration_sec) {
+    loop.setAxisValue(axis_code, axis_value, static_cast<uint32_t>(duration_sec * 1000));
+    sleepMs(duration_sec * 1000);
 }
 
 // ============ 运动控制函数 ============
-// 50Hz = 20ms间隔
+// 轴值以 AXIS_RATE_HZ 频率发送
 
 // 前进（左摇杆Y轴正向）
 void moveForward(int duration_sec) {
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_YAXIS, AXIS_FORWARD);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_YAXIS, AXIS_STOP);
+    streamAxis(CMD_LEFT_YAXIS, AXIS_FORWARD, duration_sec);
 }
 
 // 后退（左摇杆Y轴负向）
 void moveBackward(int duration_sec) {
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_YAXIS, AXIS_BACKWARD);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_YAXIS, AXIS_STOP);
+    streamAxis(CMD_LEFT_YAXIS, AXIS_BACKWARD, duration_sec);
 }
 
 // 左转（右摇杆X轴负向）
 void turnLeft(int duration_sec) {
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_RIGHT_XAXIS, AXIS_TURN_LEFT);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_RIGHT_XAXIS, AXIS_STOP);
+    streamAxis(CMD_RIGHT_XAXIS, AXIS_TURN_LEFT, duration_sec);
 }
 
 // 右转（右摇杆X轴正向）
 void turnRight(int duration_sec) {
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_RIGHT_XAXIS, AXIS_TURN_RIGHT);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_RIGHT_XAXIS, AXIS_STOP);
+    streamAxis(CMD_RIGHT_XAXIS, AXIS_TURN_RIGHT, duration_sec);
 }
 
 // 左移（左摇杆X轴负向）
 void moveLeft(int duration_sec) {
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_XAXIS, AXIS_MOVE_LEFT);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_XAXIS, AXIS_STOP);
+    streamAxis(CMD_LEFT_XAXIS, AXIS_MOVE_LEFT, duration_sec);
 }
 
 // 右移（左摇杆X轴正向）
 void moveRight(int duration_sec) {
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_XAXIS, AXIS_MOVE_RIGHT);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LEFT_XAXIS, AXIS_STOP);
+    streamAxis(CMD_LEFT_XAXIS, AXIS_MOVE_RIGHT, duration_sec);
 }
 
 // ============ 主函数 ============
 int main() {
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    if (!transport.open(ROBOT_IP, ROBOT_PORT)) {
         return -1;
     }
 
@@ -178,60 +143,74 @@ int main() {
     std::cout << "Target Robot: " << ROBOT_IP << ":" << ROBOT_PORT << std::endl;
     std::cout << std::endl;
 
-    // 启动心跳线程
-    std::thread hb_thread(heartbeatThread);
-    std::cout << "[INFO] Heartbeat thread started (2Hz)" << std::endl;
+    // 启动控制循环（内含2Hz心跳）
+    if (!loop.start()) {
+        transport.close();
+        return -1;
+    }
+    std::cout << "[INFO] Control loop started (heartbeat 2Hz)" << std::endl;
+
+    // 机器人需把状态上报到本机 DEFAULT_LOCAL_PORT；监视未启动时各等待退化为固定时长
+    if (!monitor.start()) {
+        std::cout << "[WARNING] Status monitor unavailable, falling back to fixed waits" << std::endl;
+    }
 
     // 等待1s确保心跳已启动
-    Sleep(1000);
+    sleepMs(1000);
 
     // 站立
     std::cout << "[INFO] Sending stand up command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_STAND_UP);
-    std::cout << "[INFO] Waiting 10 seconds..." << std::endl;
-    Sleep(10000);
+    loop.send<cmd::StandUp>();
+    monitor.await("Stand up", bodyHeightAbove(STAND_BODY_HEIGHT_M), STAND_TIMEOUT_MS);
 
     // 前进1秒
     std::cout << "[INFO] Moving forward 2s..." << std::endl;
     moveForward(2);
-    Sleep(1000);
+    sleepMs(1000);
 
     // 后退1秒
     std::cout << "[INFO] Moving backward 2s..." << std::endl;
     moveBackward(2);
-    Sleep(1000);
+    sleepMs(1000);
 
     // 左转2秒
     std::cout << "[INFO] Turning left 2s..." << std::endl;
     turnLeft(2);
-    Sleep(1000);
+    sleepMs(1000);
 
     // 右转2秒
     std::cout << "[INFO] Turning right 2s..." << std::endl;
     turnRight(2);
-    Sleep(1000);
+    sleepMs(1000);
 
     // 左移1秒
     std::cout << "[INFO] Moving left 2s..." << std::endl;
     moveLeft(2);
-    Sleep(1000);
+    sleepMs(1000);
 
     // 右移1秒
     std::cout << "[INFO] Moving right 2s..." << std::endl;
     moveRight(2);
-    Sleep(1000);
+    sleepMs(1000);
 
     // 趴下
     std::cout << "[INFO] Sending lie down command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LIE_DOWN);
-    Sleep(1000);
-
-    // 停止心跳线程
-    heartbeat_running = false;
-    hb_thread.join();
-
-    // 清理 Winsock
-    WSACleanup();
+    loop.send<cmd::LieDown>();
+    monitor.await("Lie down", bodyHeightBelow(LIE_BODY_HEIGHT_M), TRANSITION_TIMEOUT_MS);
+
+    // 停止状态监视与控制循环
+    monitor.stop();
+    loop.stop();
+
+    ControlLoopStats stats = loop.stats();
+    std::cout << "[INFO] Control loop: " << stats.ticks << " ticks, "
+              << stats.axis_packets << " axis packets, "
+              << stats.suppressed_axis << " unchanged axis suppressed, "
+              << stats.heartbeats << " heartbeats, "
+              << stats.missed_deadlines << " missed deadlines" << std::endl;
+
+    // 关闭发送通道并释放网络环境
+    transport.close();
 
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
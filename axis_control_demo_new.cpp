@@ -6,43 +6,63 @@
 
 /**
  * @file axis_control_demo_new.cpp
- * @brief 四足机器人轴控制Demo - 使用0x21010140复杂指令 (Windows版)
+ * @brief 四足机器人轴控制Demo - 使用0x21010140复杂指令 (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
- * 运行: axis_control_demo_new.exe
+ * 运行: axis_control_demo_new.exe [配置文件]
+ *       配置文件可设置控制指令的 DSCP 标记、发送缓冲区以及指令记录 (示例见 config/axis_control.conf)
  *
  * 流程:
  *   1. 启动2Hz心跳线程（每500ms发送一次）
  *   2. 发送站立指令
- *   3. 等待10秒确保站立完成
- *   4. 前进1秒
- *   5. 后退1秒
- *   6. 左转2秒
- *   7. 右转2秒
- *   8. 停止并退出
+ *   3. 等待运动状态上报站立完成
+ *   4. 按一条路线依次前进、后退、左转、右转、左移、右移各2秒（平滑加减速）
+ *   5. 趴下并退出
  */
 
 #include <cstring>
 #include <cstdint>
-#include <thread>
-#include <atomic>
 #include <iostream>
 
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include "config.h"
+#include "control_loop.h"
+#include "motion_monitor.h"
+#include "net_platform.h"
+#include "telemetry_recorder.h"
+#include "udp_transport.h"
+
+using namespace q25;
 
 // ============ 配置 ============
 const char* ROBOT_IP = "192.168.3.20";
 const int ROBOT_PORT = 43893;
 
-// ============ 命令码 ============
-constexpr uint32_t CMD_HEARTBEAT    = 0x21040001;
-constexpr uint32_t CMD_STAND_UP     = 0x21010202;
-constexpr uint32_t CMD_LIE_DOWN   = 0x21010222;
-constexpr uint32_t CMD_AXIS_CONTROL = 0x21010140;  // 轴控制指令码（复杂指令）
-constexpr uint32_t EXTENDED_CMD     = 1;           // 扩展指令类型
+// 站立 / 趴下以上报的机身高度判定，依赖暂定的 MotionData 布局（见 status_protocol.h）
+// 状态等待超时（毫秒），超时后给出警告并继续
+const int STAND_TIMEOUT_MS = 15000;
+const int TRANSITION_TIMEOUT_MS = 10000;
+
+// 控制指令默认使用 EF 标记，沿途设备优先转发
+SocketTuning controlTuning(const Config& config) {
+    SocketTuning tuning;
+    tuning.dscp = config.getInt("control.dscp", DSCP_EF);
+    tuning.send_buffer_bytes = config.getInt("control.sndbuf_bytes", tuning.send_buffer_bytes);
+    return tuning;
+}
+
+// 记录全部发出的指令，可用 telemetry_replay 回放到仿真器
+TelemetryRecorderConfig commandRecorderConfig(const Config& config) {
+    TelemetryRecorderConfig recorder;
+    recorder.prefix = "commands";
+    recorder.channel = TELEMETRY_CHANNEL_COMMAND;
+    recorder.segment_bytes = 16u * 1024 * 1024;
+    recorder.chunk_bytes = 64u * 1024;
+    recorder.ring_capacity = 1024;
+    recorder.slot_size = 256;
+    recorder.directory = config.getString("record.directory", recorder.directory);
+    recorder.prefix = config.getString("record.prefix", recorder.prefix);
+    return recorder;
+}
 
 // ============ 轴值定义 ============
 // 轴值区间: [-1000, 1000]，无死区
@@ -57,232 +77,79 @@ constexpr int32_t AXIS_TURN_RIGHT = 500;   // 右转
 
 constexpr int32_t AXIS_STOP = 0;  // 停止（所有轴）
 
-// ============ 指令头结构体（复杂指令） ============
-#pragma pack(push, 1)
-struct CommandHead {
-	uint32_t command_id;     // 指令码
-    uint32_t parameter_size; // 数据体字节数
-    uint32_t command_type;   // 1 = 扩展指令
-};
-#pragma pack(pop)
-
-// ============ 轴指令数据体结构 ============
-#pragma pack(push, 1)
-struct AxisCommand {
-    uint32_t left_x;   // 平移摇杆X轴值
-    uint32_t left_y;   // 平移摇杆Y轴值
-    uint32_t right_x;  // 转向摇杆X轴值
-    uint32_t right_y;  // 转向摇杆Y轴值
-};
-#pragma pack(pop)
+// ============ 轴值发送频率 ============
+// 默认 100Hz，可按需要调整为 200~500Hz
+constexpr double AXIS_RATE_HZ = 100.0;
 
-// ============ 完整轴控制消息结构 ============
-#pragma pack(push, 1)
-struct AxisControlMessage {
-    CommandHead head;
-    uint8_t      data[64];  // 存储 AxisCommand
-};
-#pragma pack(pop)
-
-// ============ UDP命令结构（简单指令） ============
-#pragma pack(push, 1)
-struct UDPCommand {
-    uint32_t code;
-    uint32_t parameters_size;
-    uint32_t type;
-
-    UDPCommand(uint32_t cmd, int32_t param = 0)
-        : code(cmd)
-        , parameters_size(static_cast<uint32_t>(param))
-        , type(0) {}
-};
-#pragma pack(pop)
-
-// ============ UDP发送函数（简单指令） ============
-void sendCommand(const char* ip, int port, uint32_t cmd_code, int32_t param = 0) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) {
-        std::cerr << "[ERROR] Failed to create socket" << std::endl;
-        return;
-    }
+// ============ 发送通道 ============
+// 所有指令复用同一个已 connect 的 socket
+UdpTransport transport;
 
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
+// ============ 控制循环 ============
+// 心跳、轴值流与一次性指令由同一个线程按 AXIS_RATE_HZ 统一发送
+ControlLoopConfig axisLoopConfig() {
+    ControlLoopConfig config;
+    config.axis_rate_hz = AXIS_RATE_HZ;
+    return config;
+}
 
-    UDPCommand cmd(cmd_code, param);
-    sendto(sock, reinterpret_cast<const char*>(&cmd), sizeof(cmd), 0,
-           (struct sockaddr*)&addr, sizeof(addr));
+ControlLoop loop(transport, axisLoopConfig());
 
-    closesocket(sock);
-}
+// ============ 状态监视 ============
+// 接收机器人上报的运动状态，指令发出后等待到达目标状态，而不是固定 Sleep
+MotionMonitor monitor;
 
 // ============ 站立函数 ============
-void standUp(const char* ip, int port) {
+void standUp() {
     std::cout << "[INFO] Sending stand up command..." << std::endl;
-    sendCommand(ip, port, CMD_STAND_UP);
-}
-
-// ============ UDP发送函数（复杂指令-轴控制） ============
-void sendAxisControl(const char* ip, int port, const AxisCommand& axisCmd) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) {
-        std::cerr << "[ERROR] Failed to create socket" << std::endl;
-        return;
-    }
-
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
-
-    // 构造复杂指令消息
-    AxisControlMessage msg;
-    msg.head.command_type = EXTENDED_CMD;           // 1 = 扩展指令
-    msg.head.command_id = CMD_AXIS_CONTROL;         // 0x21010140
-    msg.head.parameter_size = sizeof(AxisCommand);  // 16 字节
-
-    // 将 AxisCommand 数据复制到 data 字段
-    memcpy(msg.data, &axisCmd, sizeof(AxisCommand));
-
-    // 发送大小 = sizeof(head) + parameter_size
-    int sendLen = sendto(sock, reinterpret_cast<const char*>(&msg),
-                         sizeof(CommandHead) + msg.head.parameter_size, 0,
-                         (struct sockaddr*)&addr, sizeof(addr));
-
-    if (sendLen < 0) {
-        std::cerr << "[ERROR] Failed to send axis control command" << std::endl;
-    } else {
-        std::cout << "[INFO] Send axis control: left_x=" << axisCmd.left_x
-                  << ", left_y=" << axisCmd.left_y
-                  << ", right_x=" << axisCmd.right_x
-                  << ", right_y=" << axisCmd.right_y << std::endl;
-    }
-
-    closesocket(sock);
-}
-
-// ============ 全局控制变量 ============
-std::atomic<bool> heartbeat_running(true);
-
-// ============ 心跳线程 ============
-void heartbeatThread() {
-    while (heartbeat_running) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_HEARTBEAT);
-        Sleep(500);  // 500ms = 2Hz
-    }
-}
-
-// ============ 运动控制函数 ============
-// 50Hz = 20ms间隔
-
-// 前进（左摇杆Y轴正向）
-void moveForward(int duration_sec) {
-    AxisCommand cmd;
-    cmd.left_x = 0;
-    cmd.left_y = AXIS_FORWARD;
-    cmd.right_x = 0;
-    cmd.right_y = 0;
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    cmd.left_y = AXIS_STOP;
-    sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
+    loop.send<cmd::StandUp>();
 }
 
-// 后退（左摇杆Y轴负向）
-void moveBackward(int duration_sec) {
-    AxisCommand cmd;
-    cmd.left_x = 0;
-    cmd.left_y = AXIS_BACKWARD;
-    cmd.right_x = 0;
-    cmd.right_y = 0;
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    cmd.left_y = AXIS_STOP;
-    sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-}
+// ============ 运动路线 ============
+// 每段: 段长ms, left_x, left_y, right_x, right_y, 斜坡ms, 斜坡曲线
+// 运动段之间插入 1 秒减速停止段；由控制循环按 AXIS_RATE_HZ 逐周期插值发送，见 trajectory.h
+constexpr uint32_t MOVE_MS  = 2000;
+constexpr uint32_t PAUSE_MS = 1000;
+constexpr uint32_t RAMP_MS  = 300;
+
+const TrajectorySegment ROUTE[] = {
+    { MOVE_MS,  0,               AXIS_FORWARD,  0,               0, RAMP_MS, RAMP_SMOOTH },  // 前进
+    { PAUSE_MS, 0,               0,             0,               0, RAMP_MS, RAMP_SMOOTH },
+    { MOVE_MS,  0,               AXIS_BACKWARD, 0,               0, RAMP_MS, RAMP_SMOOTH },  // 后退
+    { PAUSE_MS, 0,               0,             0,               0, RAMP_MS, RAMP_SMOOTH },
+    { MOVE_MS,  0,               0,             AXIS_TURN_LEFT,  0, RAMP_MS, RAMP_SMOOTH },  // 左转
+    { PAUSE_MS, 0,               0,             0,               0, RAMP_MS, RAMP_SMOOTH },
+    { MOVE_MS,  0,               0,             AXIS_TURN_RIGHT, 0, RAMP_MS, RAMP_SMOOTH },  // 右转
+    { PAUSE_MS, 0,               0,             0,               0, RAMP_MS, RAMP_SMOOTH },
+    { MOVE_MS,  AXIS_MOVE_LEFT,  0,             0,               0, RAMP_MS, RAMP_SMOOTH },  // 左移
+    { PAUSE_MS, 0,               0,             0,               0, RAMP_MS, RAMP_SMOOTH },
+    { MOVE_MS,  AXIS_MOVE_RIGHT, 0,             0,               0, RAMP_MS, RAMP_SMOOTH },  // 右移
+    { PAUSE_MS, 0,               0,             0,               0, RAMP_MS, RAMP_SMOOTH },
+};
 
-// 左转（右摇杆X轴负向）
-void turnLeft(int duration_sec) {
-    AxisCommand cmd;
-    cmd.left_x = 0;
-    cmd.left_y = 0;
-    cmd.right_x = AXIS_TURN_LEFT;
-    cmd.right_y = 0;
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-        Sleep(10);  // 100Hz = 10ms
+// ============ 主函数 ============
+int main(int argc, char* argv[]) {
+    Config config;
+    if (argc > 1 && !config.load(argv[1])) {
+        std::cerr << "[ERROR] Cannot open config file: " << argv[1] << std::endl;
+        return -1;
     }
-    cmd.right_x = AXIS_STOP;
-    sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-}
 
-// 右转（右摇杆X轴正向）
-void turnRight(int duration_sec) {
-    AxisCommand cmd;
-    cmd.left_x = 0;
-    cmd.left_y = 0;
-    cmd.right_x = AXIS_TURN_RIGHT;
-    cmd.right_y = 0;
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-        Sleep(10);  // 100Hz = 10ms
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
     }
-    cmd.right_x = AXIS_STOP;
-    sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-}
 
-// 左移（左摇杆X轴负向）
-void moveLeft(int duration_sec) {
-    AxisCommand cmd;
-    cmd.left_x = AXIS_MOVE_LEFT;
-    cmd.left_y = 0;
-    cmd.right_x = 0;
-    cmd.right_y = 0;
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-        Sleep(10);  // 100Hz = 10ms
+    if (!transport.open(ROBOT_IP, ROBOT_PORT)) {
+        return -1;
     }
-    cmd.left_x = AXIS_STOP;
-    sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-}
+    transport.applyTuning(controlTuning(config));
 
-// 右移（左摇杆X轴正向）
-void moveRight(int duration_sec) {
-    AxisCommand cmd;
-    cmd.left_x = AXIS_MOVE_RIGHT;
-    cmd.left_y = 0;
-    cmd.right_x = 0;
-    cmd.right_y = 0;
-    int total_ms = duration_sec * 1000;
-    for (int i = 0; i < total_ms; i += 10) {
-        sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-        Sleep(10);  // 100Hz = 10ms
-    }
-    cmd.left_x = AXIS_STOP;
-    sendAxisControl(ROBOT_IP, ROBOT_PORT, cmd);
-}
-
-// ============ 主函数 ============
-int main() {
-
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
-        return -1;
+    // 所有发送都经由控制循环线程，满足记录器单生产者要求
+    TelemetryRecorder recorder(commandRecorderConfig(config));
+    if (config.getBool("record.enabled", false) && recorder.start()) {
+        transport.setRecorder(&recorder);
     }
 
     std::cout << "========================================" << std::endl;
@@ -293,59 +160,51 @@ int main() {
     std::cout << "Axis Control Code: 0x" << std::hex << CMD_AXIS_CONTROL << std::dec << std::endl;
     std::cout << std::endl;
 
-    // 启动心跳线程
-    std::thread hb_thread(heartbeatThread);
-    std::cout << "[INFO] Heartbeat thread started (2Hz)" << std::endl;
+    // 启动控制循环（内含2Hz心跳）
+    if (!loop.start()) {
+        transport.close();
+        return -1;
+    }
+    std::cout << "[INFO] Control loop started (heartbeat 2Hz)" << std::endl;
+
+    // 机器人需把状态上报到本机 DEFAULT_LOCAL_PORT；监视未启动时各等待退化为固定时长
+    if (!monitor.start()) {
+        std::cout << "[WARNING] Status monitor unavailable, falling back to fixed waits" << std::endl;
+    }
 
     // 等待1s确保心跳已启动
-    Sleep(1000);
+    sleepMs(1000);
 
     // 站立
-    standUp(ROBOT_IP, ROBOT_PORT);
-    std::cout << "[INFO] Waiting 10 seconds for stand up..." << std::endl;
-    Sleep(10000);
-
-    // 前进1秒
-    std::cout << "[INFO] Moving forward 2s..." << std::endl;
-    moveForward(2);
-    Sleep(1000);
-
-    // 后退1秒
-    std::cout << "[INFO] Moving backward 2s..." << std::endl;
-    moveBackward(2);
-    Sleep(1000);
-
-    // 左转2秒
-    std::cout << "[INFO] Turning left 2s..." << std::endl;
-    turnLeft(2);
-    Sleep(1000);
-
-    // 右转2秒
-    std::cout << "[INFO] Turning right 2s..." << std::endl;
-    turnRight(2);
-    Sleep(1000);
-
-    // 左移1秒
-    std::cout << "[INFO] Moving left 2s..." << std::endl;
-    moveLeft(2);
-    Sleep(1000);
-
-    // 右移1秒
-    std::cout << "[INFO] Moving right 2s..." << std::endl;
-    moveRight(2);
-    Sleep(1000);
+    standUp();
+    monitor.await("Stand up", bodyHeightAbove(STAND_BODY_HEIGHT_M), STAND_TIMEOUT_MS);
+
+    // 按路线依次前进、后退、左转、右转、左移、右移各2秒
+    std::cout << "[INFO] Running route: " << (sizeof(ROUTE) / sizeof(ROUTE[0])) << " segments, "
+              << trajectoryDurationMs(ROUTE) << " ms..." << std::endl;
+    loop.playTrajectory(ROUTE);
+    sleepMs(static_cast<int>(trajectoryDurationMs(ROUTE)) + 100);
 
     // 趴下
     std::cout << "[INFO] Sending lie down command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LIE_DOWN);
-    Sleep(1000);
-
-    // 停止心跳线程
-    heartbeat_running = false;
-    hb_thread.join();
-
-    // 清理 Winsock
-    WSACleanup();
+    loop.send<cmd::LieDown>();
+    monitor.await("Lie down", bodyHeightBelow(LIE_BODY_HEIGHT_M), TRANSITION_TIMEOUT_MS);
+
+    // 停止状态监视与控制循环
+    monitor.stop();
+    loop.stop();
+    transport.setRecorder(nullptr);
+    recorder.stop();
+
+    ControlLoopStats stats = loop.stats();
+    std::cout << "[INFO] Control loop: " << stats.ticks << " ticks, "
+              << stats.axis_packets << " axis packets, "
+              << stats.heartbeats << " heartbeats, "
+              << stats.trajectories << " trajectories, "
+              << stats.missed_deadlines << " missed deadlines" << std::endl;
+
+    // 关闭发送通道并释放网络环境
+    transport.close();
 
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
@@ -0,0 +1,325 @@
+// ====================================================================
+//          Created:    2026/10/14/ 16:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file command_latency_bench.cpp
+ * @brief 指令到生效的往返延迟基准测试 (Windows / Linux)
+ *
+ * 编译: 使用 CMake 或 Visual Studio
+ * 运行: command_latency_bench.exe [配置文件]
+ *
+ * 测量从控制端提交新的轴值设定（ControlLoop::setAxis）到机器人在运动状态流
+ * (DATA_TYPE_MOTION) 中体现该设定所经过的时间，分别在 50/100/200/500Hz 的
+ * 轴值发送频率下统计 p50/p99/p99.9 延迟与发送/接收吞吐。
+ *
+ * 测量方式:
+ *   - 原地交替"左转 / 停止"，每步保持 bench.step_ms 毫秒，尽量减小活动范围
+ *   - 每次切换设定时记录 steady_clock 时间戳
+ *   - 接收线程收到的运动状态 |yaw_rate| 越过 bench.yaw_threshold 即认为生效，
+ *     与切换时间戳之差即为一次样本（包含控制循环采样等待、网络、机器人响应与上报）
+ *   - 一步内未观察到生效记为超时
+ *   - yaw_rate 的位置取自暂定的 MotionData 布局（见 status_protocol.h），确认布局前结果只有参考意义
+ *
+ * 前提: 本机需能收到机器人状态数据（网络配置同 status_receiver_demo），
+ *       机器人周围需有足够空间。
+ */
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "batch_receiver.h"
+#include "config.h"
+#include "control_loop.h"
+#include "latency_histogram.h"
+#include "motion_monitor.h"
+#include "net_platform.h"
+#include "socket_options.h"
+#include "status_dispatcher.h"
+#include "udp_transport.h"
+
+using namespace q25;
+
+// ============ 配置 ============
+// 依次测试的轴值发送频率
+const double BENCH_RATES_HZ[] = { 50.0, 100.0, 200.0, 500.0 };
+
+constexpr int RECV_TIMEOUT_MS = 100;
+
+// 站立 / 趴下等待超时（毫秒），超时后给出警告并继续
+constexpr int STAND_TIMEOUT_MS = 15000;
+constexpr int TRANSITION_TIMEOUT_MS = 10000;
+constexpr size_t RECV_BATCH_SIZE = 32;
+
+struct BenchSettings {
+    std::string robot_ip;
+    int robot_port;
+    int local_port;
+    int steps_per_rate;     // 每个频率的切换次数（每次切换产生一个样本）
+    int step_ms;            // 每步保持时间，同时是等待生效的超时
+    int turn_value;         // 左转轴值（右摇杆X轴）
+    double yaw_threshold;   // 判定生效的转向角速度阈值 (rad/s)
+
+    BenchSettings()
+        : robot_ip(DEFAULT_ROBOT_IP)
+        , robot_port(DEFAULT_ROBOT_PORT)
+        , local_port(DEFAULT_LOCAL_PORT)
+        , steps_per_rate(20)
+        , step_ms(1000)
+        , turn_value(-300)
+        , yaw_threshold(0.1) {}
+};
+
+BenchSettings loadSettings(const Config& config) {
+    BenchSettings settings;
+    settings.robot_ip = config.getString("bench.robot_ip", settings.robot_ip);
+    settings.robot_port = config.getInt("bench.robot_port", settings.robot_port);
+    settings.local_port = config.getInt("bench.local_port", settings.local_port);
+    settings.steps_per_rate = config.getInt("bench.steps_per_rate", settings.steps_per_rate);
+    settings.step_ms = config.getInt("bench.step_ms", settings.step_ms);
+    settings.turn_value = config.getInt("bench.turn_value", settings.turn_value);
+    settings.yaw_threshold = config.getDouble("bench.yaw_threshold", settings.yaw_threshold);
+    return settings;
+}
+
+// ============ 全局变量 ============
+std::atomic<bool> running(true);
+std::atomic<uint64_t> motion_packets(0);
+
+// 当前等待生效的设定：切换时间戳（0 表示没有待测样本）与期望状态
+std::atomic<int64_t> pending_since_ns(0);
+std::atomic<bool> expect_turning(false);
+
+// 样本只在生效/超时时记录，频率很低，用互斥锁保护即可
+std::mutex sample_mutex;
+LatencyHistogram latency_us;
+uint64_t timeouts = 0;
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double usToMs(uint64_t us) { return static_cast<double>(us) / 1e3; }
+
+// ============ 接收线程 ============
+// 在接收线程内同步解析，避免额外的线程切换计入延迟
+void receiverThread(BatchReceiver* receiver, StatusDispatcher* dispatcher) {
+    while (running) {
+        size_t count = receiver->receive(RECV_TIMEOUT_MS);
+        for (size_t i = 0; i < count; i++) {
+            const ReceivedDatagram& datagram = receiver->datagram(i);
+            dispatcher->parsePacket(datagram.data, datagram.len);
+        }
+    }
+}
+
+void onMotion(const MotionData& motion, double yaw_threshold) {
+    motion_packets++;
+
+    int64_t since = pending_since_ns.load(std::memory_order_acquire);
+    if (since == 0) {
+        return;
+    }
+    bool turning = std::fabs(motion.yaw_rate) > yaw_threshold;
+    if (turning != expect_turning.load(std::memory_order_relaxed)) {
+        return;
+    }
+    // 只有把 since 清零成功的一方记录样本，与超时处理互斥
+    if (pending_since_ns.compare_exchange_strong(since, 0)) {
+        std::lock_guard<std::mutex> lock(sample_mutex);
+        latency_us.record(static_cast<uint64_t>((steadyNowNs() - since) / 1000));
+    }
+}
+
+// ============ 单个频率的测试 ============
+bool runRate(UdpTransport& transport, const BenchSettings& settings, double rate_hz) {
+    ControlLoopConfig loop_config;
+    loop_config.axis_rate_hz = rate_hz;
+    ControlLoop loop(transport, loop_config);
+    if (!loop.start()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sample_mutex);
+        latency_us.reset();
+        timeouts = 0;
+    }
+    uint64_t sent_before = transport.sentPackets();
+    uint64_t motion_before = motion_packets.load();
+    int64_t start_ns = steadyNowNs();
+
+    AxisCommand turn;
+    memset(&turn, 0, sizeof(turn));
+    turn.right_x = static_cast<uint32_t>(settings.turn_value);
+
+    for (int step = 0; step < settings.steps_per_rate; step++) {
+        bool turning = (step % 2) == 0;
+        expect_turning = turning;
+        pending_since_ns.store(steadyNowNs(), std::memory_order_release);
+        if (turning) {
+            loop.setAxis(turn);
+        } else {
+            loop.stopAxis();
+        }
+
+        sleepMs(settings.step_ms);
+
+        int64_t since = pending_since_ns.load();
+        if (since != 0 && pending_since_ns.compare_exchange_strong(since, 0)) {
+            std::lock_guard<std::mutex> lock(sample_mutex);
+            timeouts++;
+        }
+    }
+
+    loop.stopAxis();
+    sleepMs(settings.step_ms);
+    loop.stop();
+
+    double elapsed_sec = static_cast<double>(steadyNowNs() - start_ns) / 1e9;
+    uint64_t sent = transport.sentPackets() - sent_before;
+    uint64_t received = motion_packets.load() - motion_before;
+    ControlLoopStats loop_stats = loop.stats();
+
+    std::lock_guard<std::mutex> lock(sample_mutex);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "[Bench] " << std::setw(6) << rate_hz << " Hz"
+              << "  samples " << latency_us.count() << ", timeouts " << timeouts
+              << "  p50 " << usToMs(latency_us.percentile(50.0))
+              << "  p99 " << usToMs(latency_us.percentile(99.0))
+              << "  p99.9 " << usToMs(latency_us.percentile(99.9))
+              << "  max " << usToMs(latency_us.max()) << " ms"
+              << "  send " << sent / elapsed_sec << " pkt/s"
+              << "  motion " << received / elapsed_sec << " pkt/s"
+              << "  missed " << loop_stats.missed_deadlines << std::endl;
+    return true;
+}
+
+// ============ 站立 / 趴下 ============
+
+/**
+ * @brief 由单独的控制循环维持心跳，发送姿态指令并等待运动状态上报完成
+ * @return 等待期间是否收到过运动状态
+ */
+template <typename Cmd>
+bool changePosture(UdpTransport& transport, const BenchSettings& settings, const char* what,
+                   const MotionPredicate& done, int timeout_ms) {
+    MotionMonitorConfig monitor_config;
+    monitor_config.local_port = settings.local_port;
+    MotionMonitor monitor(monitor_config);
+    monitor.start();
+
+    ControlLoop loop(transport);
+    if (!loop.start()) {
+        return false;
+    }
+    sleepMs(1000);
+    std::cout << "[INFO] Sending " << what << " command..." << std::endl;
+    loop.send<Cmd>();
+    monitor.await(what, done, timeout_ms);
+    loop.stop();
+    return monitor.motionPackets() > 0;
+}
+
+// ============ 主函数 ============
+int main(int argc, char* argv[]) {
+    Config config;
+    if (argc > 1 && !config.load(argv[1])) {
+        std::cerr << "[ERROR] Cannot open config file: " << argv[1] << std::endl;
+        return -1;
+    }
+    BenchSettings settings = loadSettings(config);
+
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  Command-to-Effect Latency Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Target Robot: " << settings.robot_ip << ":" << settings.robot_port << std::endl;
+    std::cout << "Status Port: " << settings.local_port << std::endl;
+    std::cout << std::endl;
+
+    // 控制通道
+    UdpTransport transport;
+    if (!transport.open(settings.robot_ip.c_str(), settings.robot_port)) {
+        return -1;
+    }
+    SocketTuning tuning;
+    tuning.dscp = DSCP_EF;
+    transport.applyTuning(tuning);
+
+    // 站立：按上报的机身高度判定完成；监视器在此期间占用状态端口，结束后释放给测量用的接收 socket
+    if (!changePosture<cmd::StandUp>(transport, settings, "Stand up", bodyHeightAbove(STAND_BODY_HEIGHT_M),
+                                     STAND_TIMEOUT_MS)) {
+        std::cerr << "[WARNING] No motion status received yet, check the status network config" << std::endl;
+    }
+
+    // 状态接收 socket
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET) {
+        std::cerr << "[ERROR] Socket creation failed: " << lastSocketError() << std::endl;
+        return -1;
+    }
+    int opt = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
+
+    struct sockaddr_in local_addr;
+    memset(&local_addr, 0, sizeof(local_addr));
+    local_addr.sin_family = AF_INET;
+    local_addr.sin_port = htons(static_cast<uint16_t>(settings.local_port));
+    local_addr.sin_addr.s_addr = INADDR_ANY;
+    if (bind(sock, (struct sockaddr*)&local_addr, sizeof(local_addr)) == SOCKET_ERROR) {
+        std::cerr << "[ERROR] Bind port " << settings.local_port << " failed: " << lastSocketError() << std::endl;
+        closeSocketHandle(sock);
+        return -1;
+    }
+
+    StatusDispatcher dispatcher;
+    double yaw_threshold = settings.yaw_threshold;
+    dispatcher.onMotion([yaw_threshold](const PacketHeader&, const MotionData& motion) {
+        onMotion(motion, yaw_threshold);
+    });
+
+    BatchReceiver receiver(RECV_BATCH_SIZE, RECV_BUFFER_SIZE);
+    if (!receiver.open(sock)) {
+        closeSocketHandle(sock);
+        return -1;
+    }
+    std::thread recv_thread(receiverThread, &receiver, &dispatcher);
+
+    for (size_t i = 0; i < sizeof(BENCH_RATES_HZ) / sizeof(BENCH_RATES_HZ[0]); i++) {
+        std::cout << "[INFO] Running at " << BENCH_RATES_HZ[i] << " Hz, "
+                  << settings.steps_per_rate << " steps..." << std::endl;
+        if (!runRate(transport, settings, BENCH_RATES_HZ[i])) {
+            break;
+        }
+    }
+
+    running = false;
+    recv_thread.join();
+    receiver.close();
+    closeSocketHandle(sock);
+
+    // 趴下
+    changePosture<cmd::LieDown>(transport, settings, "Lie down", bodyHeightBelow(LIE_BODY_HEIGHT_M),
+                                TRANSITION_TIMEOUT_MS);
+    transport.close();
+
+    std::cout << "[INFO] Benchmark finished" << std::endl;
+    return 0;
+}
@@ -0,0 +1,245 @@
+// ====================================================================
+//          Created:    2026/10/14/ 20:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file micro_bench.h
+ * @brief 微基准测试框架（仅头文件，用法参照 Google Benchmark）
+ *
+ *     void benchEncode(bench::State& state) {
+ *         uint8_t buf[MAX_COMMAND_SIZE];
+ *         while (state.keepRunning()) {          // 第一次调用时开始计时
+ *             bench::doNotOptimize(encode<cmd::StandUp>(buf));
+ *         }
+ *         state.setItemsProcessed(state.iterations());
+ *     }
+ *
+ *     const bench::Benchmark BENCHMARKS[] = {
+ *         { "encode/StandUp", benchEncode, 0 },
+ *     };
+ *     return bench::runBenchmarks(BENCHMARKS, count, argc, argv);
+ *
+ * 迭代次数自动放大到单次运行不短于 --min_time 秒，输出最后一次运行的每次迭代耗时与吞吐。
+ * 命令行: --filter=<子串>  --min_time=<秒>  --list  --csv
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace q25 {
+namespace bench {
+
+inline int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ============ 防止编译器优化掉被测代码 ============
+
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const volatile void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    _ReadWriteBarrier();
+#endif
+}
+
+// ============ 单次运行状态 ============
+class State {
+public:
+    State(uint64_t iterations, int64_t arg)
+        : iterations_(iterations)
+        , remaining_(0)
+        , started_(false)
+        , arg_(arg)
+        , start_ns_(0)
+        , end_ns_(0)
+        , items_(0)
+        , bytes_(0) {}
+
+    // 循环条件；热路径只有一次比较，开始与结束计时放在慢路径
+    bool keepRunning() {
+        if (remaining_ != 0) {
+            remaining_--;
+            return true;
+        }
+        return startOrStop();
+    }
+
+    uint64_t iterations() const { return iterations_; }
+    int64_t arg() const { return arg_; }
+
+    void setItemsProcessed(uint64_t items) { items_ = items; }
+    void setBytesProcessed(uint64_t bytes) { bytes_ = bytes; }
+    // 附加在结果行末尾的说明（如接收比例）
+    void setLabel(const std::string& label) { label_ = label; }
+
+    int64_t elapsedNs() const { return end_ns_ - start_ns_; }
+    uint64_t itemsProcessed() const { return items_; }
+    uint64_t bytesProcessed() const { return bytes_; }
+    const std::string& label() const { return label_; }
+
+private:
+    bool startOrStop() {
+        if (!started_) {
+            started_ = true;
+            remaining_ = iterations_ - 1;
+            start_ns_ = nowNs();
+            return true;
+        }
+        end_ns_ = nowNs();
+        return false;
+    }
+
+    uint64_t    iterations_;
+    uint64_t    remaining_;
+    bool        started_;
+    int64_t     arg_;
+    int64_t     start_ns_;
+    int64_t     end_ns_;
+    uint64_t    items_;
+    uint64_t    bytes_;
+    std::string label_;
+};
+
+// ============ 注册表 ============
+struct Benchmark {
+    const char* name;
+    void      (*fn)(State&);
+    int64_t     arg;  // 经 State::arg() 传给被测函数，如关节数 / 批大小
+};
+
+namespace detail {
+
+inline std::string formatRate(double per_sec, const char* unit) {
+    const char* prefix = "";
+    if (per_sec >= 1e9) {
+        per_sec /= 1e9;
+        prefix = "G";
+    } else if (per_sec >= 1e6) {
+        per_sec /= 1e6;
+        prefix = "M";
+    } else if (per_sec >= 1e3) {
+        per_sec /= 1e3;
+        prefix = "k";
+    }
+    char text[32];
+    snprintf(text, sizeof(text), "%.2f%s%s/s", per_sec, prefix, unit);
+    return text;
+}
+
+inline const char* optionValue(const char* argument, const char* option) {
+    size_t len = strlen(option);
+    return strncmp(argument, option, len) == 0 ? argument + len : nullptr;
+}
+
+} // namespace detail
+
+/**
+ * @brief 依次运行名字包含 --filter 子串的基准
+ * @return 参数错误时返回 -1，否则返回 0
+ */
+inline int runBenchmarks(const Benchmark* benchmarks, size_t count, int argc, char* argv[]) {
+    double min_time_sec = 0.2;
+    const char* filter = "";
+    bool list_only = false;
+    bool csv = false;
+    for (int i = 1; i < argc; i++) {
+        const char* value = nullptr;
+        if ((value = detail::optionValue(argv[i], "--filter=")) != nullptr) {
+            filter = value;
+        } else if ((value = detail::optionValue(argv[i], "--min_time=")) != nullptr) {
+            min_time_sec = atof(value);
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list_only = true;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            std::cerr << "[ERROR] Unknown option: " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [--filter=<substring>] [--min_time=<sec>] [--list] [--csv]"
+                      << std::endl;
+            return -1;
+        }
+    }
+    const int64_t min_time_ns = static_cast<int64_t>(min_time_sec * 1e9);
+
+    if (csv) {
+        std::cout << "name,iterations,ns_per_iter,items_per_sec,bytes_per_sec,label" << std::endl;
+    } else if (!list_only) {
+        printf("%-40s %14s %14s %16s %16s\n", "Benchmark", "Time", "Iterations", "Items", "Bytes");
+        printf("%s\n", std::string(104, '-').c_str());
+    }
+
+    for (size_t b = 0; b < count; b++) {
+        const Benchmark& benchmark = benchmarks[b];
+        if (strstr(benchmark.name, filter) == nullptr) {
+            continue;
+        }
+        if (list_only) {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+
+        // 迭代次数按上一次耗时预测，每轮最多放大 10 倍，直到运行时间不短于 min_time
+        uint64_t iterations = 1;
+        for (;;) {
+            State state(iterations, benchmark.arg);
+            benchmark.fn(state);
+            int64_t elapsed_ns = state.elapsedNs() > 0 ? state.elapsedNs() : 1;
+            bool done = elapsed_ns >= min_time_ns || iterations >= 1000000000ull;
+            if (done) {
+                double ns_per_iter = static_cast<double>(elapsed_ns) / static_cast<double>(iterations);
+                double items_per_sec = state.itemsProcessed() * 1e9 / static_cast<double>(elapsed_ns);
+                double bytes_per_sec = state.bytesProcessed() * 1e9 / static_cast<double>(elapsed_ns);
+                if (csv) {
+                    std::cout << benchmark.name << "," << iterations << "," << ns_per_iter << ","
+                              << items_per_sec << "," << bytes_per_sec << "," << state.label() << std::endl;
+                } else {
+                    char time_text[32];
+                    snprintf(time_text, sizeof(time_text), "%.2f ns", ns_per_iter);
+                    std::string items = state.itemsProcessed() > 0 ? detail::formatRate(items_per_sec, "") : "";
+                    std::string bytes = state.bytesProcessed() > 0 ? detail::formatRate(bytes_per_sec, "B") : "";
+                    printf("%-40s %14s %14llu %16s %16s  %s\n", benchmark.name, time_text,
+                           static_cast<unsigned long long>(iterations), items.c_str(), bytes.c_str(),
+                           state.label().c_str());
+                }
+                fflush(stdout);
+                break;
+            }
+            double scale = static_cast<double>(min_time_ns) * 1.4 / static_cast<double>(elapsed_ns);
+            if (scale > 10.0) {
+                scale = 10.0;
+            }
+            uint64_t next = static_cast<uint64_t>(static_cast<double>(iterations) * scale);
+            iterations = next > iterations ? next : iterations + 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace bench
+} // namespace q25
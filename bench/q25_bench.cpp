@@ -0,0 +1,576 @@
+// ====================================================================
+//          Created:    2026/10/14/ 20:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file q25_bench.cpp
+ * @brief 热路径微基准：指令编码、状态包解析分发、快照缓存读写、回环收发 (Windows / Linux)
+ *
+ * 编译: 使用 CMake 或 Visual Studio
+ * 运行: q25_bench.exe [--filter=<子串>] [--min_time=<秒>] [--list] [--csv]
+ *       例如 q25_bench.exe --filter=parse/ 只运行解析基准；--csv 便于与上一次结果比较
+ *
+ * 不需要机器人：收发基准使用本机回环地址上的临时端口。各组基准:
+ *   - encode/    每种指令描述符的编码、运行期指令码编码、预编码包拷贝，
+ *                 以及旧式 UDPCommand / AxisControlMessage 结构体拷贝
+ *   - parse/     parsePacket() 按 DATA_TYPE_* 分发到一个读取数据的订阅者，关节数据按关节数分档
+ *   - cache/     StatusCache 经分发器写入、读者读取，及另一线程同时写 / 读时的开销
+ *   - transport/ UdpTransport 逐包发送与批量发送、BatchSender 按批大小发往回环接收线程，
+ *                 结果行末尾给出接收线程实际收到的比例
+ *
+ * 多线程基准的结果与核数有关，单核机器上只有参考意义。
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch_receiver.h"
+#include "batch_sender.h"
+#include "micro_bench.h"
+#include "net_platform.h"
+#include "packet_cache.h"
+#include "q25_codec.h"
+#include "socket_options.h"
+#include "status_cache.h"
+#include "status_dispatcher.h"
+#include "udp_transport.h"
+
+using namespace q25;
+
+// ============ 配置 ============
+constexpr int RECV_TIMEOUT_MS = 10;
+constexpr size_t RECV_BATCH_SIZE = 64;
+constexpr int SINK_RCVBUF_BYTES = 4 * 1024 * 1024;
+// 发送结束后等待在途数据报到达接收线程的最长时间
+constexpr int64_t DRAIN_TIMEOUT_NS = 200000000;
+
+// ============ 指令编码 ============
+
+// 无参数指令：编译期编码
+template <typename Cmd>
+void benchEncode(bench::State& state) {
+    uint8_t buf[MAX_COMMAND_SIZE];
+    while (state.keepRunning()) {
+        bench::doNotOptimize(encode<Cmd>(buf));
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * Cmd::SIZE);
+}
+
+// 带参数指令：参数每次变化，防止整段被常量折叠
+template <typename Cmd>
+void benchEncodeParam(bench::State& state) {
+    uint8_t buf[MAX_COMMAND_SIZE];
+    int32_t param = 0;
+    while (state.keepRunning()) {
+        bench::doNotOptimize(encode<Cmd>(buf, param++));
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * Cmd::SIZE);
+}
+
+void benchEncodeAxisControl(bench::State& state) {
+    uint8_t buf[MAX_COMMAND_SIZE];
+    AxisCommand axis;
+    axis.left_x = 0;
+    axis.left_y = 500;
+    axis.right_x = 0;
+    axis.right_y = 0;
+    while (state.keepRunning()) {
+        axis.right_x++;
+        bench::doNotOptimize(encode<cmd::AxisControl>(buf, axis));
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * cmd::AxisControl::SIZE);
+}
+
+// 运行期指令码（指令队列的路径）
+void benchEncodeSimple(bench::State& state) {
+    static const uint32_t CODES[] = { CMD_STAND_UP, CMD_LIE_DOWN, CMD_WALK_STATE, CMD_CHANGE_HEIGHT };
+    uint8_t buf[MAX_COMMAND_SIZE];
+    uint32_t i = 0;
+    while (state.keepRunning()) {
+        bench::doNotOptimize(encodeSimple(buf, CODES[i & 3], static_cast<int32_t>(i)));
+        bench::clobberMemory();
+        i++;
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 预编码包：发送路径只取指针 + 长度，这里包含一次拷贝
+void benchPacketImage(bench::State& state) {
+    uint8_t buf[MAX_COMMAND_SIZE];
+    while (state.keepRunning()) {
+        PacketImage image = packetImage<cmd::ChangeHeight, HEIGHT_LOW>();
+        memcpy(buf, image.data, image.size);
+        bench::doNotOptimize(buf);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 旧式结构体：构造 UDPCommand 后整体拷贝
+void benchLegacyUDPCommand(bench::State& state) {
+    uint8_t buf[sizeof(UDPCommand)];
+    int32_t param = 0;
+    while (state.keepRunning()) {
+        UDPCommand command(CMD_CHANGE_HEIGHT, param++);
+        memcpy(buf, &command, sizeof(command));
+        bench::doNotOptimize(buf);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * sizeof(UDPCommand));
+}
+
+// 旧式结构体：填写 AxisControlMessage 头与数据体后拷贝已用部分
+void benchLegacyAxisControlMessage(bench::State& state) {
+    uint8_t buf[sizeof(AxisControlMessage)];
+    AxisCommand axis;
+    axis.left_x = 0;
+    axis.left_y = 500;
+    axis.right_x = 0;
+    axis.right_y = 0;
+    const size_t size = sizeof(CommandHead) + sizeof(AxisCommand);
+    while (state.keepRunning()) {
+        AxisControlMessage message;
+        message.head.command_id = CMD_AXIS_CONTROL;
+        message.head.parameter_size = sizeof(AxisCommand);
+        message.head.command_type = EXTENDED_CMD;
+        axis.right_x++;
+        memcpy(message.data, &axis, sizeof(axis));
+        memcpy(buf, &message, size);
+        bench::doNotOptimize(buf);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * size);
+}
+
+// ============ 状态包解析 ============
+
+std::vector<uint8_t> makePacket(uint32_t type, size_t body_len) {
+    std::vector<uint8_t> packet(sizeof(PacketHeader) + body_len, 0);
+    PacketHeader header;
+    header.type = type;
+    header.length = static_cast<uint32_t>(body_len);
+    header.timestamp = 0;
+    memcpy(&packet[0], &header, sizeof(header));
+    return packet;
+}
+
+// 订阅者读取一个字段，模拟最小的实际处理
+void runParse(bench::State& state, StatusDispatcher& dispatcher, std::vector<uint8_t>& packet) {
+    while (state.keepRunning()) {
+        dispatcher.parsePacket(&packet[0], packet.size());
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * packet.size());
+}
+
+void benchParseBattery(bench::State& state) {
+    StatusDispatcher dispatcher;
+    dispatcher.onBattery([](const PacketHeader&, const BatteryData& battery) {
+        bench::doNotOptimize(battery.percentage);
+    });
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_BATTERY, sizeof(BatteryData));
+    runParse(state, dispatcher, packet);
+}
+
+void benchParseIMU(bench::State& state) {
+    StatusDispatcher dispatcher;
+    dispatcher.onIMU([](const PacketHeader&, const IMUData& imu) {
+        bench::doNotOptimize(imu.acc_z);
+    });
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_IMU, sizeof(IMUData));
+    runParse(state, dispatcher, packet);
+}
+
+void benchParseMotion(bench::State& state) {
+    StatusDispatcher dispatcher;
+    dispatcher.onMotion([](const PacketHeader&, const MotionData& motion) {
+        bench::doNotOptimize(motion.gait);
+    });
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_MOTION, sizeof(MotionData));
+    runParse(state, dispatcher, packet);
+}
+
+void benchParseSystem(bench::State& state) {
+    StatusDispatcher dispatcher;
+    dispatcher.onSystem([](const PacketHeader&, const SystemData& system) {
+        bench::doNotOptimize(system.error_code);
+    });
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_SYSTEM, sizeof(SystemData));
+    runParse(state, dispatcher, packet);
+}
+
+// arg = 关节数；订阅者遍历全部关节取最高温度
+void benchParseJoint(bench::State& state) {
+    StatusDispatcher dispatcher;
+    dispatcher.onJoint([](const PacketHeader&, JointSpan joints) {
+        float max_temperature = 0.0f;
+        for (size_t i = 0; i < joints.size; i++) {
+            if (joints[i].temperature > max_temperature) {
+                max_temperature = joints[i].temperature;
+            }
+        }
+        bench::doNotOptimize(max_temperature);
+    });
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_JOINT, static_cast<size_t>(state.arg()) * sizeof(JointData));
+    runParse(state, dispatcher, packet);
+}
+
+// 未订阅的类型与长度不足的包：只有长度校验与计数
+void benchParseUnknown(bench::State& state) {
+    StatusDispatcher dispatcher;
+    std::vector<uint8_t> packet = makePacket(0x99, 32);
+    runParse(state, dispatcher, packet);
+}
+
+void benchParseShort(bench::State& state) {
+    StatusDispatcher dispatcher;
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_IMU, sizeof(IMUData) / 2);
+    runParse(state, dispatcher, packet);
+}
+
+// ============ 快照缓存 ============
+
+// 后台线程重复执行 fn 直到对象析构
+class BackgroundLoop {
+public:
+    template <typename Fn>
+    explicit BackgroundLoop(Fn fn)
+        : running_(true)
+        , thread_([this, fn]() {
+              while (running_.load(std::memory_order_relaxed)) {
+                  fn();
+              }
+          }) {}
+
+    ~BackgroundLoop() {
+        running_ = false;
+        thread_.join();
+    }
+
+private:
+    std::atomic<bool> running_;
+    std::thread thread_;
+};
+
+// 写入路径：分发器 -> StatusCache，arg = 同时读取的线程数
+void benchCacheUpdateMotion(bench::State& state) {
+    StatusCache cache;
+    StatusDispatcher dispatcher;
+    cache.attach(dispatcher);
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_MOTION, sizeof(MotionData));
+    dispatcher.parsePacket(&packet[0], packet.size());
+
+    std::vector<BackgroundLoop*> readers;
+    for (int64_t i = 0; i < state.arg(); i++) {
+        readers.push_back(new BackgroundLoop([&cache]() {
+            MotionSnapshot snapshot = MotionSnapshot();
+            if (cache.motion(snapshot)) {
+                bench::doNotOptimize(snapshot.sequence);
+            }
+        }));
+    }
+    int64_t recv_time_ns = 0;
+    while (state.keepRunning()) {
+        cache.setReceiveTime(recv_time_ns++);
+        dispatcher.parsePacket(&packet[0], packet.size());
+    }
+    for (size_t i = 0; i < readers.size(); i++) {
+        delete readers[i];
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void benchCacheUpdateJoints(bench::State& state) {
+    StatusCache cache;
+    StatusDispatcher dispatcher;
+    cache.attach(dispatcher);
+    std::vector<uint8_t> packet = makePacket(DATA_TYPE_JOINT, static_cast<size_t>(state.arg()) * sizeof(JointData));
+    while (state.keepRunning()) {
+        dispatcher.parsePacket(&packet[0], packet.size());
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * packet.size());
+}
+
+// 读取路径，arg = 1 时另一线程持续写入同一类型
+template <typename Snapshot, bool (StatusCache::*Read)(Snapshot&) const>
+void runCacheRead(bench::State& state, uint32_t type, size_t body_len) {
+    StatusCache cache;
+    StatusDispatcher dispatcher;
+    cache.attach(dispatcher);
+    std::vector<uint8_t> packet = makePacket(type, body_len);
+    dispatcher.parsePacket(&packet[0], packet.size());
+
+    BackgroundLoop* writer = nullptr;
+    if (state.arg() > 0) {
+        writer = new BackgroundLoop([&dispatcher, &packet]() {
+            dispatcher.parsePacket(&packet[0], packet.size());
+        });
+    }
+    Snapshot snapshot = Snapshot();
+    uint64_t empty_reads = 0;
+    while (state.keepRunning()) {
+        if ((cache.*Read)(snapshot)) {
+            bench::doNotOptimize(snapshot.sequence);
+        } else {
+            empty_reads++;
+        }
+    }
+    delete writer;
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * sizeof(Snapshot));
+    // 缓存已预先写入，读取不应失败
+    if (empty_reads > 0) {
+        state.setLabel(std::to_string(empty_reads) + " empty reads");
+    }
+}
+
+void benchCacheReadMotion(bench::State& state) {
+    runCacheRead<MotionSnapshot, &StatusCache::motion>(state, DATA_TYPE_MOTION, sizeof(MotionData));
+}
+
+void benchCacheReadJoints(bench::State& state) {
+    runCacheRead<JointSnapshot, &StatusCache::joints>(state, DATA_TYPE_JOINT, 12 * sizeof(JointData));
+}
+
+// ============ 回环收发 ============
+
+// 回环接收端：绑定 127.0.0.1 的临时端口，后台线程批量接收并计数
+class LoopbackSink {
+public:
+    LoopbackSink()
+        : sock_(INVALID_SOCKET)
+        , port_(0)
+        , receiver_(RECV_BATCH_SIZE, 2048)
+        , running_(false)
+        , received_(0) {
+        sock_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sock_ == INVALID_SOCKET) {
+            std::cerr << "[ERROR] Socket creation failed: " << lastSocketError() << std::endl;
+            return;
+        }
+        SocketTuning tuning;
+        tuning.recv_buffer_bytes = SINK_RCVBUF_BYTES;
+        applySocketTuning(sock_, tuning);
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = 0;
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        socklen_t addr_len = sizeof(addr);
+        if (bind(sock_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR ||
+            getsockname(sock_, reinterpret_cast<sockaddr*>(&addr), &addr_len) == SOCKET_ERROR ||
+            !receiver_.open(sock_)) {
+            std::cerr << "[ERROR] Loopback bind failed: " << lastSocketError() << std::endl;
+            closeSocketHandle(sock_);
+            sock_ = INVALID_SOCKET;
+            return;
+        }
+        port_ = ntohs(addr.sin_port);
+
+        running_ = true;
+        thread_ = std::thread([this]() {
+            while (running_.load(std::memory_order_relaxed)) {
+                size_t count = receiver_.receive(RECV_TIMEOUT_MS);
+                received_.fetch_add(count, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    ~LoopbackSink() {
+        if (thread_.joinable()) {
+            running_ = false;
+            thread_.join();
+        }
+        if (sock_ != INVALID_SOCKET) {
+            receiver_.close();
+            closeSocketHandle(sock_);
+        }
+    }
+
+    bool ok() const { return sock_ != INVALID_SOCKET; }
+    int port() const { return port_; }
+    uint64_t received() const { return received_.load(std::memory_order_relaxed); }
+
+    // 等待已发出的数据报到达，返回实际收到的比例说明
+    std::string drain(uint64_t sent) const {
+        int64_t deadline = bench::nowNs() + DRAIN_TIMEOUT_NS;
+        while (received() < sent && bench::nowNs() < deadline) {
+            std::this_thread::yield();
+        }
+        char text[64];
+        snprintf(text, sizeof(text), "rx %.1f%%", sent > 0 ? 100.0 * received() / sent : 0.0);
+        return text;
+    }
+
+private:
+    LoopbackSink(const LoopbackSink&) = delete;
+    LoopbackSink& operator=(const LoopbackSink&) = delete;
+
+    SOCKET sock_;
+    int port_;
+    BatchReceiver receiver_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> received_;
+    std::thread thread_;
+};
+
+// UdpTransport::sendRaw：每个数据包一次系统调用
+void benchTransportSend(bench::State& state) {
+    LoopbackSink sink;
+    UdpTransport transport;
+    if (!sink.ok() || !transport.open("127.0.0.1", sink.port())) {
+        while (state.keepRunning()) {}
+        state.setLabel("loopback unavailable");
+        return;
+    }
+    PacketImage heartbeat = packetImage<cmd::Heartbeat>();
+    while (state.keepRunning()) {
+        transport.sendRaw(heartbeat.data, heartbeat.size);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setBytesProcessed(state.iterations() * heartbeat.size);
+    state.setLabel(sink.drain(state.iterations()));
+}
+
+// UdpTransport 批量路径：每次迭代入队 arg 个轴值包后 flush()（超过发送槽位时自动提前发出）
+void benchTransportQueue(bench::State& state) {
+    LoopbackSink sink;
+    UdpTransport transport;
+    if (!sink.ok() || !transport.open("127.0.0.1", sink.port())) {
+        while (state.keepRunning()) {}
+        state.setLabel("loopback unavailable");
+        return;
+    }
+    const size_t batch = static_cast<size_t>(state.arg());
+    AxisCommand axis;
+    axis.left_x = 0;
+    axis.left_y = 500;
+    axis.right_x = 0;
+    axis.right_y = 0;
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < batch; i++) {
+            transport.queueAxisControl(axis);
+        }
+        transport.flush();
+    }
+    uint64_t packets = state.iterations() * batch;
+    state.setItemsProcessed(packets);
+    state.setBytesProcessed(packets * cmd::AxisControl::SIZE);
+    state.setLabel(sink.drain(packets));
+}
+
+// BatchSender：每次迭代发出 arg 个数据包（Linux 为一次 sendmmsg）
+void benchBatchSender(bench::State& state) {
+    LoopbackSink sink;
+    const size_t batch = static_cast<size_t>(state.arg());
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(static_cast<uint16_t>(sink.port()));
+    inet_pton(AF_INET, "127.0.0.1", &to.sin_addr);
+    BatchSender sender(batch, MAX_COMMAND_SIZE);
+    if (!sink.ok() || sock == INVALID_SOCKET || !sender.open(sock)) {
+        while (state.keepRunning()) {}
+        state.setLabel("loopback unavailable");
+        if (sock != INVALID_SOCKET) {
+            closeSocketHandle(sock);
+        }
+        return;
+    }
+    PacketImage heartbeat = packetImage<cmd::Heartbeat>();
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < batch; i++) {
+            sender.enqueue(heartbeat.data, heartbeat.size, &to);
+        }
+        sender.flush();
+    }
+    sender.close();
+    closeSocketHandle(sock);
+    uint64_t packets = state.iterations() * batch;
+    state.setItemsProcessed(packets);
+    state.setBytesProcessed(packets * heartbeat.size);
+    state.setLabel(sink.drain(packets));
+}
+
+// ============ 基准列表 ============
+const bench::Benchmark BENCHMARKS[] = {
+    { "encode/Heartbeat",             benchEncode<cmd::Heartbeat>,              0 },
+    { "encode/StandUp",               benchEncode<cmd::StandUp>,                0 },
+    { "encode/LieDown",               benchEncode<cmd::LieDown>,                0 },
+    { "encode/EmergencyStop",         benchEncode<cmd::EmergencyStop>,          0 },
+    { "encode/WalkGait",              benchEncode<cmd::WalkGait>,               0 },
+    { "encode/RunGait",               benchEncode<cmd::RunGait>,                0 },
+    { "encode/ManualMode",            benchEncode<cmd::ManualMode>,             0 },
+    { "encode/NaviMode",              benchEncode<cmd::NaviMode>,               0 },
+    { "encode/AssistantMode",         benchEncode<cmd::AssistantMode>,          0 },
+    { "encode/PowerStatus",           benchEncode<cmd::PowerStatus>,            0 },
+    { "encode/LeftYAxis",             benchEncodeParam<cmd::LeftYAxis>,         0 },
+    { "encode/LeftXAxis",             benchEncodeParam<cmd::LeftXAxis>,         0 },
+    { "encode/RightXAxis",            benchEncodeParam<cmd::RightXAxis>,        0 },
+    { "encode/ChangeHeight",          benchEncodeParam<cmd::ChangeHeight>,      0 },
+    { "encode/AutoCharge",            benchEncodeParam<cmd::AutoCharge>,        0 },
+    { "encode/PowerDriverMotor",      benchEncodeParam<cmd::PowerDriverMotor>,  0 },
+    { "encode/PowerUpload",           benchEncodeParam<cmd::PowerUpload>,       0 },
+    { "encode/PowerLidarFU",          benchEncodeParam<cmd::PowerLidarFU>,      0 },
+    { "encode/PowerLidarFL",          benchEncodeParam<cmd::PowerLidarFL>,      0 },
+    { "encode/PowerLidarBU",          benchEncodeParam<cmd::PowerLidarBU>,      0 },
+    { "encode/PowerLidarBL",          benchEncodeParam<cmd::PowerLidarBL>,      0 },
+    { "encode/AxisControl",           benchEncodeAxisControl,                   0 },
+    { "encode/encodeSimple",          benchEncodeSimple,                        0 },
+    { "encode/packetImage",           benchPacketImage,                         0 },
+    { "encode/legacy_UDPCommand",     benchLegacyUDPCommand,                    0 },
+    { "encode/legacy_AxisControlMsg", benchLegacyAxisControlMessage,            0 },
+
+    { "parse/battery",                benchParseBattery,                        0 },
+    { "parse/imu",                    benchParseIMU,                            0 },
+    { "parse/motion",                 benchParseMotion,                         0 },
+    { "parse/system",                 benchParseSystem,                         0 },
+    { "parse/joint/12",               benchParseJoint,                          12 },
+    { "parse/joint/16",               benchParseJoint,                          16 },
+    { "parse/joint/32",               benchParseJoint,                          32 },
+    { "parse/joint/64",               benchParseJoint,                          64 },
+    { "parse/unknown_type",           benchParseUnknown,                        0 },
+    { "parse/short_packet",           benchParseShort,                          0 },
+
+    { "cache/update_motion",          benchCacheUpdateMotion,                   0 },
+    { "cache/update_motion/readers:2", benchCacheUpdateMotion,                  2 },
+    { "cache/update_joints/12",       benchCacheUpdateJoints,                   12 },
+    { "cache/update_joints/64",       benchCacheUpdateJoints,                   64 },
+    { "cache/read_motion",            benchCacheReadMotion,                     0 },
+    { "cache/read_motion/writer",     benchCacheReadMotion,                     1 },
+    { "cache/read_joints",            benchCacheReadJoints,                     0 },
+    { "cache/read_joints/writer",     benchCacheReadJoints,                     1 },
+
+    { "transport/send",               benchTransportSend,                       0 },
+    { "transport/queue_flush/4",      benchTransportQueue,                      4 },
+    { "transport/queue_flush/16",     benchTransportQueue,                      16 },
+    { "transport/batch_sender/1",     benchBatchSender,                         1 },
+    { "transport/batch_sender/8",     benchBatchSender,                         8 },
+    { "transport/batch_sender/32",    benchBatchSender,                         32 },
+    { "transport/batch_sender/64",    benchBatchSender,                         64 },
+};
+
+// ============ 主函数 ============
+int main(int argc, char* argv[]) {
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+    return bench::runBenchmarks(BENCHMARKS, sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]), argc, argv);
+}
@@ -0,0 +1,145 @@
+// ====================================================================
+//          Created:    2026/10/14/ 19:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file alloc_counter.cpp
+ * @brief 分配计数实现；Q25_COUNT_ALLOCATIONS 下替换全局 operator new / delete
+ */
+
+#include "alloc_counter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace q25 {
+
+namespace {
+
+// 只在本线程读写，不需要原子操作
+thread_local uint64_t thread_allocations = 0;
+thread_local uint64_t thread_bytes = 0;
+
+} // namespace
+
+#ifdef Q25_COUNT_ALLOCATIONS
+
+namespace {
+
+void* countedAlloc(size_t size) {
+    thread_allocations++;
+    thread_bytes += size;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* countedAllocOrThrow(size_t size) {
+    for (;;) {
+        void* ptr = countedAlloc(size);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+bool allocationCountingEnabled() {
+    return true;
+}
+
+#else
+
+bool allocationCountingEnabled() {
+    return false;
+}
+
+#endif
+
+AllocationCount threadAllocationCount() {
+    AllocationCount count;
+    count.allocations = thread_allocations;
+    count.bytes = thread_bytes;
+    return count;
+}
+
+// ============ AllocationWatch ============
+
+AllocationWatch::AllocationWatch(const char* name, uint64_t warmup_iterations)
+    : name_(name)
+    , warmup_iterations_(warmup_iterations)
+    , iterations_(0)
+    , violations_(0) {
+    last_ = threadAllocationCount();
+    steady_.allocations = 0;
+    steady_.bytes = 0;
+}
+
+bool AllocationWatch::tick() {
+    AllocationCount now = threadAllocationCount();
+    bool was_armed = armed();
+    iterations_++;
+
+    uint64_t allocations = now.allocations - last_.allocations;
+    uint64_t bytes = now.bytes - last_.bytes;
+    last_ = now;
+    if (!was_armed || allocations == 0) {
+        return true;
+    }
+
+    steady_.allocations += allocations;
+    steady_.bytes += bytes;
+    if (violations_++ == 0) {
+        std::cerr << "[ERROR] " << name_ << " thread allocated " << bytes << " bytes in " << allocations
+                  << " allocation(s) after " << warmup_iterations_ << " warm-up iterations" << std::endl;
+    }
+    return false;
+}
+
+} // namespace q25
+
+#ifdef Q25_COUNT_ALLOCATIONS
+
+// ============ 全局 operator new / delete 替换 ============
+// 必须位于全局命名空间；引用 threadAllocationCount() 的程序会链接进本目标文件
+
+void* operator new(size_t size) {
+    return q25::countedAllocOrThrow(size);
+}
+
+void* operator new[](size_t size) {
+    return q25::countedAllocOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return q25::countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return q25::countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#endif
@@ -0,0 +1,78 @@
+// ====================================================================
+//          Created:    2026/10/14/ 19:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file alloc_counter.h
+ * @brief 按线程统计堆分配，用于验证接收 - 解析 - 分发热路径稳态下零分配
+ *
+ * 热路径所用内存均在启动时一次性分配：BatchReceiver 的预投递缓冲区、PacketRing 的槽位池、
+ * 记录器的缓冲环；StatusDispatcher 的订阅者直接拿到指向槽位的视图。AllocationWatch
+ * 用于在运行中确认这一点：
+ *
+ *     AllocationWatch watch("receiver", 1000);
+ *     while (running) {
+ *         ... 处理一批数据 ...
+ *         if (!watch.tick()) {
+ *             // 预热之后本线程仍有堆分配
+ *         }
+ *     }
+ *
+ * 计数需以 CMake 选项 Q25_COUNT_ALLOCATIONS=ON 构建：alloc_counter.cpp 替换全局
+ * operator new / delete，每次分配只增加线程局部计数。默认构建不替换，
+ * allocationCountingEnabled() 返回 false，计数恒为 0，tick() 总是返回 true。
+ * 只统计经 operator new 的分配（含 std::vector / std::string / std::function 等），
+ * 不统计直接调用 malloc 的分配。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace q25 {
+
+// ============ 分配计数 ============
+struct AllocationCount {
+    uint64_t allocations;  // operator new 调用次数
+    uint64_t bytes;        // 申请的总字节数
+};
+
+// 是否以 Q25_COUNT_ALLOCATIONS 构建
+bool allocationCountingEnabled();
+
+// 当前线程自启动以来的累计分配
+AllocationCount threadAllocationCount();
+
+// ============ 稳态零分配检查 ============
+// 在被检查线程的循环中使用，不可跨线程调用
+class AllocationWatch {
+public:
+    /**
+     * @param name              日志中显示的线程名
+     * @param warmup_iterations 预热迭代数，之后开始检查
+     */
+    AllocationWatch(const char* name, uint64_t warmup_iterations);
+
+    /**
+     * @brief 每次循环迭代末尾调用
+     * @return 预热结束后本次迭代有堆分配时输出一次 [ERROR] 并返回 false
+     */
+    bool tick();
+
+    bool armed() const { return iterations_ >= warmup_iterations_; }
+    uint64_t violations() const { return violations_; }
+    // 预热结束后累计的分配
+    AllocationCount steadyAllocations() const { return steady_; }
+
+private:
+    const char*     name_;
+    uint64_t        warmup_iterations_;
+    uint64_t        iterations_;
+    uint64_t        violations_;
+    AllocationCount last_;
+    AllocationCount steady_;
+};
+
+} // namespace q25
@@ -0,0 +1,90 @@
+// ====================================================================
+//          Created:    2026/10/14/ 12:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file axis_mailbox.h
+ * @brief 轴值设定邮箱：最新值覆盖旧值
+ *
+ * 摇杆读取、规划器、遥操作桥接等生产者只需把最新轴值写入邮箱，
+ * 控制循环每个周期采样一次并发送。生产者频率高于发送频率时（例如 1kHz 摇杆轮询），
+ * 中间的旧设定值直接被覆盖丢弃，不会排队，也不会阻塞发送线程。
+ *
+ * 写入端只允许一个线程（单写者），读取端可有任意多个线程。
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "q25_protocol.h"
+#include "seqlock.h"
+
+namespace q25 {
+
+// ============ 轴值设定 ============
+#pragma pack(push, 1)
+struct AxisSetpoint {
+    enum Mode : uint32_t {
+        MODE_NONE       = 0,  // 不发送轴值
+        MODE_AXIS       = 1,  // 扩展轴值指令 0x21010140
+        MODE_AXIS_VALUE = 2   // 单轴指令（0x21010130 等），value 存放轴值
+    };
+
+    uint32_t    mode;
+    uint32_t    axis_code;   // MODE_AXIS_VALUE 时的单轴指令码
+    int32_t     axis_value;  // MODE_AXIS_VALUE 时的轴值
+    AxisCommand axis;        // MODE_AXIS 时的四轴值
+    uint32_t    duration_ms; // 大于 0 时持续 duration_ms 后自动停止（由控制循环的定时器计时）
+};
+#pragma pack(pop)
+
+class AxisMailbox {
+public:
+    AxisMailbox() {}
+
+    // ============ 写入端（单写者） ============
+
+    // duration_ms 为 0 时持续发送，直到下一次写入
+    void publish(const AxisCommand& axis_cmd, uint32_t duration_ms = 0) {
+        AxisSetpoint setpoint;
+        memset(&setpoint, 0, sizeof(setpoint));
+        setpoint.mode = AxisSetpoint::MODE_AXIS;
+        setpoint.axis = axis_cmd;
+        setpoint.duration_ms = duration_ms;
+        slot_.store(setpoint);
+    }
+
+    void publishValue(uint32_t axis_code, int32_t axis_value, uint32_t duration_ms = 0) {
+        AxisSetpoint setpoint;
+        memset(&setpoint, 0, sizeof(setpoint));
+        setpoint.mode = AxisSetpoint::MODE_AXIS_VALUE;
+        setpoint.axis_code = axis_code;
+        setpoint.axis_value = axis_value;
+        setpoint.duration_ms = duration_ms;
+        slot_.store(setpoint);
+    }
+
+    void clear() {
+        AxisSetpoint setpoint;
+        memset(&setpoint, 0, sizeof(setpoint));
+        slot_.store(setpoint);
+    }
+
+    // ============ 读取端 ============
+
+    // 与写者冲突时返回 false，调用者应继续使用上一次读到的值
+    bool sample(AxisSetpoint& out, uint32_t* version = nullptr) const {
+        return slot_.tryLoad(out, version);
+    }
+
+    uint32_t version() const { return slot_.version(); }
+
+private:
+    Seqlock<AxisSetpoint> slot_;
+};
+
+} // namespace q25
@@ -0,0 +1,193 @@
+// ====================================================================
+//          Created:    2026/10/14/ 21:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file axis_stream.cpp
+ * @brief AxisStream 实现
+ */
+
+#include "axis_stream.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace q25 {
+
+AxisStream::AxisStream()
+    : wheel_(nullptr)
+    , tick_us_(1000.0)
+    , segment_timer_data_(0)
+    , merge_legacy_(false)
+    , version_(0)
+    , segment_timer_(INVALID_TIMER_ID)
+    , trajectory_start_tick_(0) {
+    memset(&setpoint_, 0, sizeof(setpoint_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+void AxisStream::init(TimerWheel* wheel, double tick_us, uint64_t segment_timer_data,
+                      const SendHandler& send) {
+    wheel_ = wheel;
+    tick_us_ = tick_us > 0.0 ? tick_us : 1000.0;
+    segment_timer_data_ = segment_timer_data;
+    send_ = send;
+}
+
+void AxisStream::setKeepalive(uint32_t keepalive_periods) {
+    filter_.setKeepalive(keepalive_periods);
+    filter_.reset();
+}
+
+bool AxisStream::tick(AxisMailbox& mailbox) {
+    sample(mailbox);
+    if (trajectory_.active()) {
+        stepTrajectory();
+    }
+
+    bool sent = true;
+    if (filter_.shouldSend(setpoint_)) {
+        send(setpoint_);
+    } else if (setpoint_.mode != AxisSetpoint::MODE_NONE) {
+        stats_.suppressed++;
+        sent = false;
+    }
+    // 合并后的单轴更新全部归零时，零轴值发出一次即停止轴值流
+    if (merge_legacy_ && !trajectory_.active() &&
+        setpoint_.mode == AxisSetpoint::MODE_AXIS && isZeroAxis(setpoint_.axis)) {
+        setpoint_.mode = AxisSetpoint::MODE_NONE;
+    }
+    return sent;
+}
+
+void AxisStream::sample(AxisMailbox& mailbox) {
+    AxisSetpoint next;
+    uint32_t version = 0;
+    if (!mailbox.sample(next, &version)) {
+        return;  // 生产者正在写入，本周期沿用上一次的设定值
+    }
+    if (version == version_) {
+        return;
+    }
+    if (version - version_ > 1) {
+        stats_.coalesced += version - version_ - 1;
+    }
+    version_ = version;
+    // 新的邮箱设定值优先于正在播放的轨迹
+    trajectory_.stop();
+
+    // 单轴设定转换为只有该轴的扩展轴值设定，之前的其他轴由扩展指令一并归零
+    if (merge_legacy_ && next.mode == AxisSetpoint::MODE_AXIS_VALUE &&
+        isLegacyAxis(next.axis_code)) {
+        memset(&next.axis, 0, sizeof(next.axis));
+        mergeLegacyAxis(next.axis, next.axis_code, next.axis_value);
+        next.mode = AxisSetpoint::MODE_AXIS;
+    }
+
+    // 轴值流停止或切换到另一个单轴指令时，先把之前的轴归零
+    bool stopped = (next.mode == AxisSetpoint::MODE_NONE);
+    bool axis_switched = (setpoint_.mode == AxisSetpoint::MODE_AXIS_VALUE &&
+                          (next.mode != AxisSetpoint::MODE_AXIS_VALUE ||
+                           next.axis_code != setpoint_.axis_code));
+    if (stopped || axis_switched) {
+        sendStop(setpoint_);
+    }
+    setpoint_ = next;
+
+    // 新设定值替换未结束的运动段；时长换算允许浮点误差，整数个 tick 不多等一个
+    cancelSegment();
+    if (next.mode != AxisSetpoint::MODE_NONE && next.duration_ms > 0) {
+        uint64_t ticks = static_cast<uint64_t>(
+            std::ceil(next.duration_ms * 1000.0 / tick_us_ - 1e-6));
+        segment_timer_ = wheel_->schedule(wheel_->currentTick() + ticks, segment_timer_data_);
+    }
+}
+
+void AxisStream::mergeValue(uint32_t axis_code, int32_t axis_value) {
+    if (setpoint_.mode != AxisSetpoint::MODE_AXIS) {
+        if (setpoint_.mode == AxisSetpoint::MODE_AXIS_VALUE) {
+            sendStop(setpoint_);
+        }
+        memset(&setpoint_, 0, sizeof(setpoint_));
+        setpoint_.mode = AxisSetpoint::MODE_AXIS;
+    }
+    mergeLegacyAxis(setpoint_.axis, axis_code, axis_value);
+    stats_.merged_axis++;
+    trajectory_.stop();
+
+    // 与新的邮箱设定值一样，替换未结束的运动段
+    cancelSegment();
+    setpoint_.duration_ms = 0;
+}
+
+void AxisStream::startTrajectory(const TrajectorySegment* segments, size_t count,
+                                 uint64_t start_tick) {
+    // 从当前扩展轴值平滑过渡；单轴轴值流先归零
+    AxisCommand from;
+    memset(&from, 0, sizeof(from));
+    if (setpoint_.mode == AxisSetpoint::MODE_AXIS) {
+        from = setpoint_.axis;
+    } else if (setpoint_.mode == AxisSetpoint::MODE_AXIS_VALUE) {
+        sendStop(setpoint_);
+    }
+    cancelSegment();
+
+    memset(&setpoint_, 0, sizeof(setpoint_));
+    setpoint_.mode = AxisSetpoint::MODE_AXIS;
+    setpoint_.axis = from;
+    trajectory_.start(segments, count, from);
+    trajectory_start_tick_ = start_tick;
+}
+
+void AxisStream::stepTrajectory() {
+    uint64_t now = wheel_->currentTick();
+    uint64_t ticks = now > trajectory_start_tick_ ? now - trajectory_start_tick_ : 0;
+    uint64_t elapsed_us = static_cast<uint64_t>(std::llround(ticks * tick_us_));
+    AxisCommand axis;
+    if (trajectory_.evaluate(elapsed_us, axis)) {
+        setpoint_.axis = axis;
+        return;
+    }
+    // 路线结束：最后一段的目标值一般已为 0，仍发送一次零轴值确保停止
+    sendStop(setpoint_);
+    setpoint_.mode = AxisSetpoint::MODE_NONE;
+    stats_.trajectories++;
+}
+
+void AxisStream::onSegmentEnd() {
+    // 期间有新的设定值时定时器已被取消，这里一定是同一设定值
+    segment_timer_ = INVALID_TIMER_ID;
+    sendStop(setpoint_);
+    setpoint_.mode = AxisSetpoint::MODE_NONE;
+}
+
+void AxisStream::halt() {
+    trajectory_.stop();
+    cancelSegment();
+    sendStop(setpoint_);
+    setpoint_.mode = AxisSetpoint::MODE_NONE;
+}
+
+void AxisStream::cancelSegment() {
+    if (segment_timer_ != INVALID_TIMER_ID) {
+        wheel_->cancel(segment_timer_);
+        segment_timer_ = INVALID_TIMER_ID;
+    }
+}
+
+void AxisStream::send(const AxisSetpoint& setpoint) {
+    if (setpoint.mode != AxisSetpoint::MODE_NONE) {
+        send_(setpoint, false);
+    }
+}
+
+void AxisStream::sendStop(const AxisSetpoint& setpoint) {
+    if (setpoint.mode != AxisSetpoint::MODE_NONE) {
+        send_(setpoint, true);
+    }
+    filter_.reset();
+}
+
+} // namespace q25
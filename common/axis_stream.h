@@ -0,0 +1,114 @@
+// ====================================================================
+//          Created:    2026/10/14/ 21:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file axis_stream.h
+ * @brief 一台机器人的轴值流状态机，ControlLoop 与 FleetController 共用
+ *
+ * 每个发送周期从轴值邮箱采样最新设定值，处理运动段（持续时间到期后发送零轴值）、
+ * 轴值路线插值与单轴指令合并（merge_legacy 打开时 0x21010130 等转换为 0x21010140），
+ * 并通过 AxisDeltaFilter 抑制不变的轴值。
+ *
+ * 不持有 socket 与线程：数据包经 SendHandler 交给所属循环入队，
+ * 运动段定时器放在所属循环的定时器轮中，tick 长度由 init() 给出
+ * （ControlLoop 为一个控制周期，FleetController 为 tick_us）。
+ * 全部方法只在所属循环的线程中调用。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "axis_mailbox.h"
+#include "axis_translator.h"
+#include "q25_protocol.h"
+#include "timer_wheel.h"
+#include "trajectory.h"
+
+namespace q25 {
+
+// ============ 轴值流统计 ============
+struct AxisStreamStats {
+    uint64_t coalesced;     // 两次采样之间被后续写入覆盖的邮箱设定值
+    uint64_t merged_axis;   // 合并为扩展轴值指令的单轴更新
+    uint64_t suppressed;    // 轴值未变化而跳过的发送
+    uint64_t trajectories;  // 播放完毕的轴值路线
+};
+
+class AxisStream {
+public:
+    // stop 为 true 时发送 setpoint 对应的零轴值；只对 MODE_AXIS / MODE_AXIS_VALUE 回调
+    typedef std::function<void(const AxisSetpoint& setpoint, bool stop)> SendHandler;
+
+    AxisStream();
+
+    /**
+     * @param wheel 运动段定时器所在的定时器轮
+     * @param tick_us 定时器轮 tick 长度（微秒）
+     * @param segment_timer_data 运动段定时器的 user_data，到期时调用方调用 onSegmentEnd()
+     */
+    void init(TimerWheel* wheel, double tick_us, uint64_t segment_timer_data,
+              const SendHandler& send);
+
+    // 单轴指令合并为扩展轴值指令 0x21010140
+    void setMergeLegacy(bool merge) { merge_legacy_ = merge; }
+    bool mergeLegacy() const { return merge_legacy_; }
+
+    /** @param keepalive_periods 轴值不变时的重发间隔（发送周期数），0 表示每周期发送 */
+    void setKeepalive(uint32_t keepalive_periods);
+
+    /**
+     * @brief 每个发送周期调用一次：采样邮箱、推进路线并按需发送当前设定值
+     * @return 本周期因轴值未变化而跳过发送时返回 false
+     */
+    bool tick(AxisMailbox& mailbox);
+
+    // 单轴更新合并进当前扩展轴值设定（一次性指令提交的单轴指令，需 merge_legacy）
+    void mergeValue(uint32_t axis_code, int32_t axis_value);
+
+    /**
+     * @brief 开始播放路线，替换当前轴值流
+     * @param start_tick 路线 0 时刻对应的定时器轮 tick
+     */
+    void startTrajectory(const TrajectorySegment* segments, size_t count, uint64_t start_tick);
+
+    // 运动段定时器到期
+    void onSegmentEnd();
+
+    // 停止路线、运动段与轴值流
+    void halt();
+
+    bool trajectoryActive() const { return trajectory_.active(); }
+    const AxisSetpoint& setpoint() const { return setpoint_; }
+    const AxisStreamStats& stats() const { return stats_; }
+
+private:
+    void sample(AxisMailbox& mailbox);
+    void stepTrajectory();
+    void cancelSegment();
+    void send(const AxisSetpoint& setpoint);
+    void sendStop(const AxisSetpoint& setpoint);
+
+    TimerWheel* wheel_;
+    double      tick_us_;
+    uint64_t    segment_timer_data_;
+    SendHandler send_;
+    bool        merge_legacy_;
+
+    AxisSetpoint    setpoint_;
+    uint32_t        version_;
+    AxisDeltaFilter filter_;
+    TimerId         segment_timer_;  // 未结束的运动段
+
+    TrajectoryEngine trajectory_;
+    uint64_t         trajectory_start_tick_;
+
+    AxisStreamStats stats_;
+};
+
+} // namespace q25
@@ -0,0 +1,97 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:05
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file axis_translator.cpp
+ * @brief 单轴指令转换与 AxisDeltaFilter 实现
+ */
+
+#include "axis_translator.h"
+
+#include <cstring>
+
+namespace q25 {
+
+namespace {
+
+int32_t legacyDeadzone(uint32_t axis_code) {
+    switch (axis_code) {
+    case CMD_LEFT_YAXIS:  return LEGACY_LEFT_Y_DEADZONE;
+    case CMD_LEFT_XAXIS:  return LEGACY_LEFT_X_DEADZONE;
+    case CMD_RIGHT_XAXIS: return LEGACY_RIGHT_X_DEADZONE;
+    default:              return 0;
+    }
+}
+
+} // namespace
+
+// ============ 单轴指令转换 ============
+
+bool isLegacyAxis(uint32_t axis_code) {
+    return axis_code == CMD_LEFT_YAXIS || axis_code == CMD_LEFT_XAXIS || axis_code == CMD_RIGHT_XAXIS;
+}
+
+int32_t legacyToExtendedAxis(uint32_t axis_code, int32_t value) {
+    int32_t deadzone = legacyDeadzone(axis_code);
+    if (value >= -deadzone && value <= deadzone) {
+        return 0;
+    }
+    int64_t scaled = static_cast<int64_t>(value) * EXTENDED_AXIS_MAX / LEGACY_AXIS_MAX;
+    if (scaled > EXTENDED_AXIS_MAX) {
+        return EXTENDED_AXIS_MAX;
+    }
+    if (scaled < -EXTENDED_AXIS_MAX) {
+        return -EXTENDED_AXIS_MAX;
+    }
+    return static_cast<int32_t>(scaled);
+}
+
+bool mergeLegacyAxis(AxisCommand& axis, uint32_t axis_code, int32_t value) {
+    uint32_t extended = static_cast<uint32_t>(legacyToExtendedAxis(axis_code, value));
+    switch (axis_code) {
+    case CMD_LEFT_YAXIS:  axis.left_y = extended;  return true;
+    case CMD_LEFT_XAXIS:  axis.left_x = extended;  return true;
+    case CMD_RIGHT_XAXIS: axis.right_x = extended; return true;
+    default:              return false;
+    }
+}
+
+bool isZeroAxis(const AxisCommand& axis) {
+    return axis.left_x == 0 && axis.left_y == 0 && axis.right_x == 0 && axis.right_y == 0;
+}
+
+// ============ AxisDeltaFilter ============
+
+AxisDeltaFilter::AxisDeltaFilter(uint32_t keepalive_ticks)
+    : keepalive_ticks_(keepalive_ticks)
+    , idle_ticks_(0)
+    , has_last_(false) {
+    memset(&last_, 0, sizeof(last_));
+}
+
+bool AxisDeltaFilter::shouldSend(const AxisSetpoint& setpoint) {
+    if (setpoint.mode == AxisSetpoint::MODE_NONE) {
+        has_last_ = false;
+        return false;
+    }
+
+    // duration_ms 只影响控制循环的计时，不影响发出的数据包
+    bool unchanged = has_last_ &&
+        last_.mode == setpoint.mode &&
+        (setpoint.mode == AxisSetpoint::MODE_AXIS
+            ? memcmp(&last_.axis, &setpoint.axis, sizeof(AxisCommand)) == 0
+            : last_.axis_code == setpoint.axis_code && last_.axis_value == setpoint.axis_value);
+    if (unchanged && keepalive_ticks_ > 0 && ++idle_ticks_ < keepalive_ticks_) {
+        return false;
+    }
+
+    last_ = setpoint;
+    has_last_ = true;
+    idle_ticks_ = 0;
+    return true;
+}
+
+} // namespace q25
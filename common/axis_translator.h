@@ -0,0 +1,77 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:05
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file axis_translator.h
+ * @brief 单轴指令到扩展轴值指令的转换，以及未变化轴值的抑制
+ *
+ * 单轴指令（0x21010130 / 0x21010131 / 0x21010135）每个轴一个数据报，
+ * 三个轴同时运动时每周期最多三个数据报。mergeLegacyAxis() 把单轴轴值换算后
+ * 写入 AxisCommand 的对应字段，控制循环每周期只需发送一个 0x21010140。
+ *
+ * 两种协议的轴值范围不同：单轴指令为 [-32767, 32767] 且机器人端有死区，
+ * 扩展指令为 [-1000, 1000] 且没有死区。换算时死区内的轴值记为 0
+ * （与单轴指令下机器人不动一致），死区外按满量程线性换算。
+ *
+ * AxisDeltaFilter 在设定值不变时只按保活间隔重发，设定值变化时立即发送。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "axis_mailbox.h"
+#include "q25_protocol.h"
+
+namespace q25 {
+
+// ============ 轴值范围 ============
+constexpr int32_t LEGACY_AXIS_MAX   = 32767;  // 单轴指令轴值上限
+constexpr int32_t EXTENDED_AXIS_MAX = 1000;   // 扩展指令轴值上限
+
+// 单轴指令的机器人端死区，绝对值不超过死区的轴值不产生运动
+constexpr int32_t LEGACY_LEFT_Y_DEADZONE  = 6553;
+constexpr int32_t LEGACY_LEFT_X_DEADZONE  = 24576;
+constexpr int32_t LEGACY_RIGHT_X_DEADZONE = 28212;
+
+// ============ 单轴指令转换 ============
+
+bool isLegacyAxis(uint32_t axis_code);
+
+// 单轴轴值换算为扩展指令轴值：死区内为 0，死区外线性换算并截断到 [-1000, 1000]
+int32_t legacyToExtendedAxis(uint32_t axis_code, int32_t value);
+
+// 换算后写入 axis 的对应字段，其他字段不变；不是单轴指令码时返回 false
+bool mergeLegacyAxis(AxisCommand& axis, uint32_t axis_code, int32_t value);
+
+bool isZeroAxis(const AxisCommand& axis);
+
+// ============ 未变化轴值抑制 ============
+class AxisDeltaFilter {
+public:
+    /** @param keepalive_ticks 设定值不变时的重发间隔（周期数），0 表示每周期都发送 */
+    explicit AxisDeltaFilter(uint32_t keepalive_ticks = 0);
+
+    void setKeepalive(uint32_t keepalive_ticks) { keepalive_ticks_ = keepalive_ticks; }
+
+    /**
+     * @brief 每个发送周期调用一次，判断本周期是否需要发送 setpoint
+     * @return 设定值与上次发送的不同、或距上次发送已达保活间隔时返回 true；
+     *         MODE_NONE 时总是返回 false
+     */
+    bool shouldSend(const AxisSetpoint& setpoint);
+
+    // 已通过别的途径发送了停止轴值（运动段结束等），下一次 shouldSend() 必然返回 true
+    void reset() { has_last_ = false; }
+
+private:
+    AxisSetpoint last_;
+    uint32_t keepalive_ticks_;
+    uint32_t idle_ticks_;  // 上次发送后被抑制的周期数
+    bool has_last_;
+};
+
+} // namespace q25
@@ -0,0 +1,337 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file batch_receiver.cpp
+ * @brief BatchReceiver 实现（Windows: IOCP + 重叠 WSARecvFrom；Linux: epoll + recvmmsg）
+ */
+
+#include "batch_receiver.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "trace.h"
+
+#ifdef _WIN32
+#include <mswsock.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace q25 {
+
+#ifdef _WIN32
+
+// ============ Windows: I/O 完成端口 ============
+
+#ifndef SIO_UDP_CONNRESET
+#define SIO_UDP_CONNRESET _WSAIOW(IOC_VENDOR, 12)
+#endif
+
+namespace {
+
+// 每个预投递的接收缓冲区
+struct RecvSlot {
+    OVERLAPPED  overlapped;  // 必须为第一个成员，完成通知中据此找回 RecvSlot
+    WSABUF      wsabuf;
+    DWORD       flags;
+    sockaddr_in from;
+    int         from_len;
+    uint8_t*    buffer;
+    bool        pending;
+};
+
+} // namespace
+
+struct BatchReceiver::Impl {
+    SOCKET sock;
+    HANDLE iocp;
+    std::vector<uint8_t> storage;
+    std::vector<RecvSlot> slots;
+    std::vector<OVERLAPPED_ENTRY> entries;
+    std::vector<RecvSlot*> completed;      // 上一批已交给调用者、待重新投递的缓冲区
+    std::vector<ReceivedDatagram> datagrams;
+    size_t pending;
+
+    Impl() : sock(INVALID_SOCKET), iocp(NULL), pending(0) {}
+
+    bool post(RecvSlot& slot, size_t buffer_size) {
+        memset(&slot.overlapped, 0, sizeof(slot.overlapped));
+        slot.wsabuf.buf = reinterpret_cast<CHAR*>(slot.buffer);
+        slot.wsabuf.len = static_cast<ULONG>(buffer_size);
+        slot.flags = 0;
+        slot.from_len = sizeof(slot.from);
+        int rc = WSARecvFrom(sock, &slot.wsabuf, 1, NULL, &slot.flags,
+                             (struct sockaddr*)&slot.from, &slot.from_len,
+                             &slot.overlapped, NULL);
+        if (rc == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING) {
+            return false;
+        }
+        // 立即完成时同样会投递完成通知，统一在 receive() 中处理
+        slot.pending = true;
+        pending++;
+        return true;
+    }
+};
+
+BatchReceiver::BatchReceiver(size_t batch_size, size_t buffer_size)
+    : batch_size_(batch_size)
+    , buffer_size_(buffer_size)
+    , impl_(new Impl()) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+BatchReceiver::~BatchReceiver() {
+    close();
+}
+
+bool BatchReceiver::open(SOCKET sock) {
+    close();
+
+    // 关闭 ICMP 端口不可达导致的 WSAECONNRESET，否则会打断后续接收
+    BOOL report_reset = FALSE;
+    DWORD bytes = 0;
+    WSAIoctl(sock, SIO_UDP_CONNRESET, &report_reset, sizeof(report_reset),
+             NULL, 0, &bytes, NULL, NULL);
+
+    HANDLE iocp = CreateIoCompletionPort(reinterpret_cast<HANDLE>(sock), NULL, 0, 1);
+    if (iocp == NULL) {
+        std::cerr << "[ERROR] Failed to create completion port: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    Impl& impl = *impl_;
+    impl.sock = sock;
+    impl.iocp = iocp;
+    impl.storage.assign(batch_size_ * buffer_size_, 0);
+    impl.slots.assign(batch_size_, RecvSlot());
+    impl.entries.assign(batch_size_, OVERLAPPED_ENTRY());
+    impl.datagrams.assign(batch_size_, ReceivedDatagram());
+    impl.completed.clear();
+    impl.completed.reserve(batch_size_);
+    impl.pending = 0;
+
+    for (size_t i = 0; i < batch_size_; i++) {
+        RecvSlot& slot = impl.slots[i];
+        slot.buffer = &impl.storage[i * buffer_size_];
+        slot.pending = false;
+        if (!impl.post(slot, buffer_size_)) {
+            std::cerr << "[ERROR] WSARecvFrom failed: " << WSAGetLastError() << std::endl;
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void BatchReceiver::close() {
+    Impl& impl = *impl_;
+    if (impl.iocp == NULL) {
+        return;
+    }
+
+    // 取消未完成的接收，并等待其完成通知，确保内核不再写入缓冲区
+    CancelIoEx(reinterpret_cast<HANDLE>(impl.sock), NULL);
+    while (impl.pending > 0) {
+        ULONG removed = 0;
+        if (!GetQueuedCompletionStatusEx(impl.iocp, &impl.entries[0],
+                                         static_cast<ULONG>(impl.entries.size()),
+                                         &removed, 1000, FALSE)) {
+            break;
+        }
+        impl.pending -= removed;
+    }
+
+    CloseHandle(impl.iocp);
+    impl.iocp = NULL;
+    impl.sock = INVALID_SOCKET;
+}
+
+size_t BatchReceiver::receive(int timeout_ms) {
+    Impl& impl = *impl_;
+
+    // 上一批数据报的视图已失效，重新投递对应缓冲区
+    {
+        Q25_TRACE_SCOPE(trace, "recv.post");
+        Q25_TRACE_ARG(trace, impl.completed.size());
+        for (size_t i = 0; i < impl.completed.size(); i++) {
+            if (!impl.post(*impl.completed[i], buffer_size_)) {
+                stats_.errors++;
+            }
+        }
+        impl.completed.clear();
+    }
+
+    ULONG removed = 0;
+    if (!GetQueuedCompletionStatusEx(impl.iocp, &impl.entries[0],
+                                     static_cast<ULONG>(impl.entries.size()),
+                                     &removed, static_cast<DWORD>(timeout_ms), FALSE)) {
+        return 0;  // 超时
+    }
+    stats_.syscalls++;
+    Q25_TRACE_SCOPE(trace, "recv.batch");
+    Q25_TRACE_ARG(trace, removed);
+
+    size_t count = 0;
+    for (ULONG i = 0; i < removed; i++) {
+        const OVERLAPPED_ENTRY& entry = impl.entries[i];
+        RecvSlot* slot = reinterpret_cast<RecvSlot*>(entry.lpOverlapped);
+        slot->pending = false;
+        impl.pending--;
+        impl.completed.push_back(slot);
+
+        // Internal 保存 NTSTATUS，非 0 表示接收失败或数据报被截断
+        if (entry.Internal != 0) {
+            stats_.errors++;
+            continue;
+        }
+        ReceivedDatagram& datagram = impl.datagrams[count++];
+        datagram.data = slot->buffer;
+        datagram.len = entry.dwNumberOfBytesTransferred;
+        datagram.from = slot->from;
+    }
+
+    stats_.datagrams += count;
+    if (count > stats_.max_batch) {
+        stats_.max_batch = static_cast<uint32_t>(count);
+    }
+    return count;
+}
+
+#else
+
+// ============ Linux: epoll + recvmmsg ============
+
+struct BatchReceiver::Impl {
+    SOCKET sock;
+    int epoll_fd;
+    std::vector<uint8_t> storage;
+    std::vector<mmsghdr> msgs;
+    std::vector<iovec> iovecs;
+    std::vector<sockaddr_in> addrs;
+    std::vector<ReceivedDatagram> datagrams;
+
+    Impl() : sock(-1), epoll_fd(-1) {}
+};
+
+BatchReceiver::BatchReceiver(size_t batch_size, size_t buffer_size)
+    : batch_size_(batch_size)
+    , buffer_size_(buffer_size)
+    , impl_(new Impl()) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+BatchReceiver::~BatchReceiver() {
+    close();
+}
+
+bool BatchReceiver::open(SOCKET sock) {
+    close();
+
+    // 边沿触发不适用：一次 recvmmsg 可能取不完，水平触发保证剩余数据报下次立即返回
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        std::cerr << "[ERROR] Failed to create epoll instance: " << errno << std::endl;
+        return false;
+    }
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = sock;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock, &event) != 0) {
+        std::cerr << "[ERROR] Failed to register socket with epoll: " << errno << std::endl;
+        ::close(epoll_fd);
+        return false;
+    }
+
+    Impl& impl = *impl_;
+    impl.sock = sock;
+    impl.epoll_fd = epoll_fd;
+    impl.storage.assign(batch_size_ * buffer_size_, 0);
+    impl.msgs.assign(batch_size_, mmsghdr());
+    impl.iovecs.assign(batch_size_, iovec());
+    impl.addrs.assign(batch_size_, sockaddr_in());
+    impl.datagrams.assign(batch_size_, ReceivedDatagram());
+
+    for (size_t i = 0; i < batch_size_; i++) {
+        impl.iovecs[i].iov_base = &impl.storage[i * buffer_size_];
+        impl.iovecs[i].iov_len = buffer_size_;
+        memset(&impl.msgs[i], 0, sizeof(mmsghdr));
+        impl.msgs[i].msg_hdr.msg_iov = &impl.iovecs[i];
+        impl.msgs[i].msg_hdr.msg_iovlen = 1;
+        impl.msgs[i].msg_hdr.msg_name = &impl.addrs[i];
+    }
+    return true;
+}
+
+void BatchReceiver::close() {
+    Impl& impl = *impl_;
+    if (impl.epoll_fd >= 0) {
+        ::close(impl.epoll_fd);
+        impl.epoll_fd = -1;
+    }
+    impl.sock = -1;
+}
+
+size_t BatchReceiver::receive(int timeout_ms) {
+    Impl& impl = *impl_;
+
+    if (impl.epoll_fd < 0) {
+        return 0;
+    }
+    epoll_event event;
+    if (epoll_wait(impl.epoll_fd, &event, 1, timeout_ms) <= 0) {
+        return 0;  // 超时或被信号打断
+    }
+
+    for (size_t i = 0; i < batch_size_; i++) {
+        impl.msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        impl.msgs[i].msg_hdr.msg_flags = 0;
+    }
+
+    Q25_TRACE_SCOPE(trace, "recv.batch");
+    int received = recvmmsg(impl.sock, &impl.msgs[0], static_cast<unsigned int>(batch_size_),
+                            MSG_DONTWAIT, NULL);
+    stats_.syscalls++;
+    Q25_TRACE_ARG(trace, received);
+    if (received <= 0) {
+        stats_.errors++;
+        return 0;
+    }
+
+    size_t count = 0;
+    for (int i = 0; i < received; i++) {
+        const mmsghdr& msg = impl.msgs[i];
+        if (msg.msg_hdr.msg_flags & MSG_TRUNC) {
+            stats_.errors++;
+            continue;
+        }
+        ReceivedDatagram& datagram = impl.datagrams[count++];
+        datagram.data = static_cast<const uint8_t*>(impl.iovecs[i].iov_base);
+        datagram.len = msg.msg_len;
+        datagram.from = impl.addrs[i];
+    }
+
+    stats_.datagrams += count;
+    if (count > stats_.max_batch) {
+        stats_.max_batch = static_cast<uint32_t>(count);
+    }
+    return count;
+}
+
+#endif
+
+const ReceivedDatagram& BatchReceiver::datagram(size_t index) const {
+    return impl_->datagrams[index];
+}
+
+} // namespace q25
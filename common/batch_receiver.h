@@ -0,0 +1,89 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file batch_receiver.h
+ * @brief 批量 UDP 数据报接收
+ *
+ * 一次系统调用取回多个数据报，降低机器人满速上报时（关节 / IMU 数据突发）
+ * 每个数据包的 CPU 开销和丢包率:
+ *   - Windows: 套接字关联到 I/O 完成端口，预先投递一圈重叠 WSARecvFrom 缓冲区，
+ *              GetQueuedCompletionStatusEx 一次取回全部已完成的数据报
+ *   - Linux:   epoll 等待可读后用 recvmmsg 一次读取一批
+ *
+ * receive() 返回的数据报视图（ReceivedDatagram::data）指向内部缓冲区，
+ * 在下一次调用 receive() 之前有效。只允许一个线程调用 receive()。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "net_types.h"
+
+namespace q25 {
+
+// ============ 接收到的数据报 ============
+struct ReceivedDatagram {
+    const uint8_t* data;
+    size_t len;
+    sockaddr_in from;
+};
+
+// ============ 接收统计 ============
+struct BatchReceiverStats {
+    uint64_t syscalls;    // 取回数据的系统调用次数
+    uint64_t datagrams;   // 收到的数据报
+    uint64_t errors;      // 接收失败 / 被截断的数据报
+    uint32_t max_batch;   // 单次取回的最大数据报数
+};
+
+class BatchReceiver {
+public:
+    /**
+     * @param batch_size  预投递缓冲区个数，即单次最多取回的数据报数
+     * @param buffer_size 每个缓冲区的字节数，需不小于最大数据报长度
+     */
+    explicit BatchReceiver(size_t batch_size = 32, size_t buffer_size = 65535);
+    ~BatchReceiver();
+
+    BatchReceiver(const BatchReceiver&) = delete;
+    BatchReceiver& operator=(const BatchReceiver&) = delete;
+
+    /**
+     * @brief 绑定到已 bind 的 UDP socket（不接管 socket 的所有权）
+     */
+    bool open(SOCKET sock);
+
+    /**
+     * @brief 取消未完成的接收并释放资源；需在关闭 socket 之前、接收线程退出之后调用
+     */
+    void close();
+
+    /**
+     * @brief 等待并取回一批数据报
+     * @param timeout_ms 最长等待时间，超时返回 0
+     * @return 本批数据报个数，通过 datagram(i) 访问
+     */
+    size_t receive(int timeout_ms);
+
+    const ReceivedDatagram& datagram(size_t index) const;
+
+    size_t batchSize() const { return batch_size_; }
+    const BatchReceiverStats& stats() const { return stats_; }
+
+private:
+    struct Impl;
+
+    size_t batch_size_;
+    size_t buffer_size_;
+    std::unique_ptr<Impl> impl_;
+    BatchReceiverStats stats_;
+};
+
+} // namespace q25
@@ -0,0 +1,190 @@
+// ====================================================================
+//          Created:    2026/10/14/ 16:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file batch_sender.cpp
+ * @brief BatchSender 实现（Linux: sendmmsg；Windows: 顺序 sendto）
+ */
+
+#include "batch_sender.h"
+
+#include <cstring>
+#include <vector>
+
+#include "trace.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+
+namespace q25 {
+
+// ============ 发送槽位 ============
+
+struct BatchSender::Impl {
+    SOCKET sock;
+    std::vector<uint8_t> storage;
+    std::vector<size_t> lens;
+    std::vector<sockaddr_in> addrs;
+    std::vector<bool> has_addr;
+#ifndef _WIN32
+    std::vector<mmsghdr> msgs;
+    std::vector<iovec> iovecs;
+#endif
+
+    Impl() : sock(INVALID_SOCKET) {}
+};
+
+BatchSender::BatchSender(size_t batch_size, size_t packet_size)
+    : batch_size_(batch_size == 0 ? 1 : batch_size)
+    , packet_size_(packet_size)
+    , count_(0)
+    , impl_(new Impl()) {
+    memset(&stats_, 0, sizeof(stats_));
+
+    Impl& impl = *impl_;
+    impl.storage.assign(batch_size_ * packet_size_, 0);
+    impl.lens.assign(batch_size_, 0);
+    impl.addrs.assign(batch_size_, sockaddr_in());
+    impl.has_addr.assign(batch_size_, false);
+#ifndef _WIN32
+    impl.msgs.assign(batch_size_, mmsghdr());
+    impl.iovecs.assign(batch_size_, iovec());
+    for (size_t i = 0; i < batch_size_; i++) {
+        impl.iovecs[i].iov_base = &impl.storage[i * packet_size_];
+        memset(&impl.msgs[i], 0, sizeof(mmsghdr));
+        impl.msgs[i].msg_hdr.msg_iov = &impl.iovecs[i];
+        impl.msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+BatchSender::~BatchSender() {
+    close();
+}
+
+bool BatchSender::open(SOCKET sock) {
+    close();
+    impl_->sock = sock;
+    return true;
+}
+
+void BatchSender::close() {
+    impl_->sock = INVALID_SOCKET;
+    count_ = 0;
+}
+
+bool BatchSender::enqueue(const void* data, size_t len, const sockaddr_in* to) {
+    Impl& impl = *impl_;
+    if (impl.sock == INVALID_SOCKET || len > packet_size_) {
+        stats_.errors++;
+        return false;
+    }
+    // 槽位用满时先发出已入队的数据报，保持顺序
+    if (count_ == batch_size_) {
+        flush();
+    }
+
+    size_t slot = count_++;
+    memcpy(&impl.storage[slot * packet_size_], data, len);
+    impl.lens[slot] = len;
+    impl.has_addr[slot] = (to != nullptr);
+    if (to != nullptr) {
+        impl.addrs[slot] = *to;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+
+// ============ Windows: 顺序 sendto ============
+
+size_t BatchSender::flush() {
+    Impl& impl = *impl_;
+    size_t count = count_;
+    count_ = 0;
+    Q25_TRACE_SCOPE(trace, "send.flush");
+    Q25_TRACE_ARG(trace, count);
+
+    size_t sent = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char* data = reinterpret_cast<const char*>(&impl.storage[i * packet_size_]);
+        int len = static_cast<int>(impl.lens[i]);
+        int rc = impl.has_addr[i]
+            ? sendto(impl.sock, data, len, 0,
+                     reinterpret_cast<const sockaddr*>(&impl.addrs[i]), sizeof(sockaddr_in))
+            : ::send(impl.sock, data, len, 0);
+        stats_.syscalls++;
+        if (rc == SOCKET_ERROR) {
+            stats_.errors++;
+        } else {
+            sent++;
+            if (on_sent_) {
+                on_sent_(&impl.storage[i * packet_size_], impl.lens[i]);
+            }
+        }
+    }
+
+    stats_.datagrams += sent;
+    if (count > stats_.max_batch) {
+        stats_.max_batch = static_cast<uint32_t>(count);
+    }
+    return sent;
+}
+
+#else
+
+// ============ Linux: sendmmsg ============
+
+size_t BatchSender::flush() {
+    Impl& impl = *impl_;
+    size_t count = count_;
+    count_ = 0;
+    Q25_TRACE_SCOPE(trace, "send.flush");
+    Q25_TRACE_ARG(trace, count);
+
+    for (size_t i = 0; i < count; i++) {
+        msghdr& hdr = impl.msgs[i].msg_hdr;
+        impl.iovecs[i].iov_len = impl.lens[i];
+        hdr.msg_name = impl.has_addr[i] ? &impl.addrs[i] : NULL;
+        hdr.msg_namelen = impl.has_addr[i] ? sizeof(sockaddr_in) : 0;
+    }
+
+    // sendmmsg 在第 k 个数据报出错时返回已发送的 k 个，再次调用时该数据报作为首个
+    // 返回 -1，跳过它继续发送后面的数据报
+    size_t sent = 0;
+    size_t offset = 0;
+    while (offset < count) {
+        int rc = sendmmsg(impl.sock, &impl.msgs[offset], static_cast<unsigned int>(count - offset), 0);
+        stats_.syscalls++;
+        if (rc <= 0) {
+            if (rc < 0 && errno == EINTR) {
+                continue;
+            }
+            stats_.errors++;
+            offset++;
+            continue;
+        }
+        if (on_sent_) {
+            for (size_t i = offset; i < offset + static_cast<size_t>(rc); i++) {
+                on_sent_(&impl.storage[i * packet_size_], impl.lens[i]);
+            }
+        }
+        sent += static_cast<size_t>(rc);
+        offset += static_cast<size_t>(rc);
+    }
+
+    stats_.datagrams += sent;
+    if (count > stats_.max_batch) {
+        stats_.max_batch = static_cast<uint32_t>(count);
+    }
+    return sent;
+}
+
+#endif
+
+} // namespace q25
@@ -0,0 +1,95 @@
+// ====================================================================
+//          Created:    2026/10/14/ 16:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file batch_sender.h
+ * @brief 批量 UDP 数据报发送
+ *
+ * 一个周期内要发出的已编码数据包（心跳、步态/高度指令、轴值等）先复制进
+ * 预分配的发送槽位，周期末 flush() 一次交给内核:
+ *   - Linux:   sendmmsg，一次系统调用发送整批；部分发送时从中断处继续
+ *   - Windows: 没有批量 UDP 发送的系统调用（WSASendMsg 一次只发一个报文，
+ *              RIO 需要注册缓冲区和专用 socket），按入队顺序逐个 sendto
+ *
+ * 顺序保证：同一批内的数据报严格按 enqueue() 顺序交给内核；
+ * 某个数据报发送失败只计入错误，不影响其后的数据报，也不会重排。
+ * 槽位用满时 enqueue() 先 flush() 已入队的数据报，因此顺序同样保持。
+ *
+ * 不接管 socket 的所有权。非线程安全，只应在发送线程中使用。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "net_types.h"
+
+namespace q25 {
+
+// ============ 发送统计 ============
+struct BatchSenderStats {
+    uint64_t syscalls;    // 发送的系统调用次数
+    uint64_t datagrams;   // 已交给内核的数据报
+    uint64_t errors;      // 发送失败 / 超长被拒绝的数据报
+    uint32_t max_batch;   // 单次 flush() 的最大数据报数
+};
+
+class BatchSender {
+public:
+    // 每个成功交给内核的数据报调用一次，按发送顺序
+    typedef std::function<void(const uint8_t* data, size_t len)> SentHandler;
+
+    /**
+     * @param batch_size  发送槽位个数，即单次 flush() 最多发送的数据报数
+     * @param packet_size 每个槽位的字节数，需不小于最大数据包长度
+     */
+    explicit BatchSender(size_t batch_size = 64, size_t packet_size = 64);
+    ~BatchSender();
+
+    BatchSender(const BatchSender&) = delete;
+    BatchSender& operator=(const BatchSender&) = delete;
+
+    /** @brief 绑定到 UDP socket，丢弃尚未发送的数据报 */
+    bool open(SOCKET sock);
+
+    /** @brief 丢弃尚未发送的数据报并解除绑定；需在关闭 socket 之前调用 */
+    void close();
+
+    /**
+     * @brief 复制一个已编码的数据包到发送槽位
+     * @param to 目的地址；nullptr 表示 socket 已 connect()，发往默认地址
+     * @return 数据包超长或未 open() 时返回 false
+     */
+    bool enqueue(const void* data, size_t len, const sockaddr_in* to = nullptr);
+
+    /**
+     * @brief 按入队顺序发送全部已入队的数据报
+     * @return 成功交给内核的数据报个数，其余计入 stats().errors
+     */
+    size_t flush();
+
+    /** @brief 设置发送成功回调（指令记录等），传空函数关闭；enqueue() 内部触发的发送同样回调 */
+    void onSent(SentHandler handler) { on_sent_ = handler; }
+
+    size_t pending() const { return count_; }
+    size_t batchSize() const { return batch_size_; }
+    const BatchSenderStats& stats() const { return stats_; }
+
+private:
+    struct Impl;
+
+    size_t batch_size_;
+    size_t packet_size_;
+    size_t count_;
+    std::unique_ptr<Impl> impl_;
+    BatchSenderStats stats_;
+    SentHandler on_sent_;
+};
+
+} // namespace q25
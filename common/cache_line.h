@@ -0,0 +1,47 @@
+// ====================================================================
+//          Created:    2026/10/14/ 11:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file cache_line.h
+ * @brief 缓存行大小定义，用于无锁结构中隔离读写索引，避免伪共享；
+ *        以及按缓存行对齐的内存分配（C++11 的 new 不保证超对齐）
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace q25 {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// 分配按 alignment 对齐的内存，失败返回 nullptr；需用 alignedFree 释放
+inline void* alignedAlloc(size_t size, size_t alignment = CACHE_LINE_SIZE) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        return nullptr;
+    }
+    return ptr;
+#endif
+}
+
+inline void alignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+} // namespace q25
@@ -0,0 +1,95 @@
+// ====================================================================
+//          Created:    2026/10/14/ 11:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file command_queue.h
+ * @brief 定长无锁多生产者/单消费者队列
+ *
+ * 基于每个槽位的序号实现（Vyukov bounded queue）:
+ *   - 生产者通过 CAS 抢占写入位置，队列满时 tryPush() 立即返回 false，不会阻塞
+ *   - 消费者只有一个（控制循环线程），出队无需 CAS
+ *
+ * 容量必须为 2 的幂。元素在槽位内按值存储，不进行任何堆分配。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "cache_line.h"
+
+namespace q25 {
+
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() : enqueue_pos_(0), dequeue_pos_(0) {
+        for (size_t i = 0; i < Capacity; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // 任意线程调用；队列满时返回 false
+    bool tryPush(const T& value) {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // 队列已满
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅消费者线程调用；队列空时返回 false
+    bool tryPop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell = &cells_[pos & MASK];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;
+        }
+        value = cell->value;
+        cell->sequence.store(pos + Capacity, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Cell cells_[Capacity];
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_;
+};
+
+} // namespace q25
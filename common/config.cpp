@@ -0,0 +1,121 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file config.cpp
+ * @brief Config 实现
+ */
+
+#include "config.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace q25 {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    const char* whitespace = " \t\r\n";
+    size_t begin = text.find_first_not_of(whitespace);
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+bool Config::load(const std::string& path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << "[WARNING] " << path << ":" << line_no << ": expected key = value" << std::endl;
+            continue;
+        }
+        std::string key = trim(line.substr(0, eq));
+        if (key.empty()) {
+            std::cerr << "[WARNING] " << path << ":" << line_no << ": empty key" << std::endl;
+            continue;
+        }
+        values_[key] = trim(line.substr(eq + 1));
+    }
+    return true;
+}
+
+bool Config::has(const std::string& key) const {
+    return values_.find(key) != values_.end();
+}
+
+std::string Config::getString(const std::string& key, const std::string& default_value) const {
+    std::map<std::string, std::string>::const_iterator it = values_.find(key);
+    return it != values_.end() ? it->second : default_value;
+}
+
+int Config::getInt(const std::string& key, int default_value) const {
+    std::map<std::string, std::string>::const_iterator it = values_.find(key);
+    if (it == values_.end()) {
+        return default_value;
+    }
+    char* end = nullptr;
+    long value = strtol(it->second.c_str(), &end, 0);
+    if (end == it->second.c_str() || *end != '\0') {
+        std::cerr << "[WARNING] Invalid integer for " << key << ": " << it->second << std::endl;
+        return default_value;
+    }
+    return static_cast<int>(value);
+}
+
+double Config::getDouble(const std::string& key, double default_value) const {
+    std::map<std::string, std::string>::const_iterator it = values_.find(key);
+    if (it == values_.end()) {
+        return default_value;
+    }
+    char* end = nullptr;
+    double value = strtod(it->second.c_str(), &end);
+    if (end == it->second.c_str() || *end != '\0') {
+        std::cerr << "[WARNING] Invalid number for " << key << ": " << it->second << std::endl;
+        return default_value;
+    }
+    return value;
+}
+
+bool Config::getBool(const std::string& key, bool default_value) const {
+    std::map<std::string, std::string>::const_iterator it = values_.find(key);
+    if (it == values_.end()) {
+        return default_value;
+    }
+    const std::string& v = it->second;
+    if (v == "true" || v == "yes" || v == "on" || v == "1") {
+        return true;
+    }
+    if (v == "false" || v == "no" || v == "off" || v == "0") {
+        return false;
+    }
+    std::cerr << "[WARNING] Invalid boolean for " << key << ": " << v << std::endl;
+    return default_value;
+}
+
+} // namespace q25
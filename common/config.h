@@ -0,0 +1,51 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file config.h
+ * @brief 简单的 key = value 配置文件读取
+ *
+ * 格式:
+ *   # 注释
+ *   receiver.local_port = 43893
+ *   receiver.rcvbuf_bytes = 8388608
+ *
+ * 键名区分大小写，值两端的空白会被去掉。未配置的键使用调用方给出的默认值，
+ * 因此配置文件可以只写需要修改的项。
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace q25 {
+
+class Config {
+public:
+    Config() {}
+
+    /**
+     * @brief 读取配置文件
+     * @return 文件无法打开时返回 false；格式错误的行会输出警告并跳过
+     */
+    bool load(const std::string& path);
+
+    bool has(const std::string& key) const;
+
+    std::string getString(const std::string& key, const std::string& default_value) const;
+    int getInt(const std::string& key, int default_value) const;
+    double getDouble(const std::string& key, double default_value) const;
+    // 接受 true/false、yes/no、on/off、1/0
+    bool getBool(const std::string& key, bool default_value) const;
+
+    void set(const std::string& key, const std::string& value) { values_[key] = value; }
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+} // namespace q25
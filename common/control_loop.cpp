@@ -0,0 +1,244 @@
+// ====================================================================
+//          Created:    2026/10/14/ 11:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file control_loop.cpp
+ * @brief ControlLoop 实现
+ */
+
+#include "control_loop.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "periodic_timer.h"
+#include "thread_utils.h"
+#include "trace.h"
+
+namespace q25 {
+
+ControlLoop::ControlLoop(UdpTransport& transport, const ControlLoopConfig& config)
+    : transport_(transport)
+    , config_(config)
+    , wheel_(16)
+    , heartbeat_ticks_(1)
+    , running_(false)
+    , ticks_(0)
+    , missed_deadlines_(0)
+    , heartbeats_(0)
+    , axis_packets_(0)
+    , commands_(0)
+    , coalesced_(0)
+    , merged_axis_(0)
+    , suppressed_axis_(0)
+    , trajectories_(0)
+    , queue_full_(0) {
+    // 定时器轮每个控制周期前进一个 tick
+    axis_stream_.init(&wheel_, 1e6 / config_.axis_rate_hz, TIMER_SEGMENT_END,
+                      [this](const AxisSetpoint& setpoint, bool stop) { sendAxis(setpoint, stop); });
+    axis_stream_.setMergeLegacy(config_.merge_axis_values);
+}
+
+ControlLoop::~ControlLoop() {
+    stop();
+}
+
+bool ControlLoop::start() {
+    if (running_) {
+        return true;
+    }
+    if (!transport_.isOpen()) {
+        std::cerr << "[ERROR] Control loop requires an open transport" << std::endl;
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&ControlLoop::run, this);
+    return true;
+}
+
+void ControlLoop::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool ControlLoop::sendCommand(uint32_t cmd_code, int32_t param) {
+    return pushRequest(cmd_code, param, nullptr);
+}
+
+bool ControlLoop::pushRequest(uint32_t code, int32_t param, const uint8_t* image) {
+    LoopRequest request;
+    request.code = code;
+    request.param = param;
+    request.image = image;
+    request.trajectory = nullptr;
+    request.trajectory_count = 0;
+    return pushRequest(request);
+}
+
+bool ControlLoop::pushRequest(const LoopRequest& request) {
+    if (!requests_.tryPush(request)) {
+        queue_full_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void ControlLoop::setAxis(const AxisCommand& axis_cmd, uint32_t duration_ms) {
+    axis_mailbox_.publish(axis_cmd, duration_ms);
+}
+
+void ControlLoop::setAxisValue(uint32_t axis_code, int32_t axis_value, uint32_t duration_ms) {
+    axis_mailbox_.publishValue(axis_code, axis_value, duration_ms);
+}
+
+void ControlLoop::stopAxis() {
+    axis_mailbox_.clear();
+}
+
+bool ControlLoop::playTrajectory(const TrajectorySegment* segments, size_t count) {
+    if (segments == nullptr || count == 0) {
+        return false;
+    }
+    LoopRequest request;
+    request.code = 0;
+    request.param = 0;
+    request.image = nullptr;
+    request.trajectory = segments;
+    request.trajectory_count = count;
+    return pushRequest(request);
+}
+
+ControlLoopStats ControlLoop::stats() const {
+    ControlLoopStats s;
+    s.ticks = ticks_.load(std::memory_order_relaxed);
+    s.missed_deadlines = missed_deadlines_.load(std::memory_order_relaxed);
+    s.heartbeats = heartbeats_.load(std::memory_order_relaxed);
+    s.axis_packets = axis_packets_.load(std::memory_order_relaxed);
+    s.commands = commands_.load(std::memory_order_relaxed);
+    s.coalesced = coalesced_.load(std::memory_order_relaxed);
+    s.merged_axis = merged_axis_.load(std::memory_order_relaxed);
+    s.suppressed_axis = suppressed_axis_.load(std::memory_order_relaxed);
+    s.trajectories = trajectories_.load(std::memory_order_relaxed);
+    s.queue_full = queue_full_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void ControlLoop::run() {
+    Q25_TRACE_THREAD("ControlLoop");
+    pinCurrentThread(config_.cpu_core);
+    if (config_.realtime_priority) {
+        setCurrentThreadRealtime();
+    }
+
+    // 心跳按控制周期的整数倍发送
+    heartbeat_ticks_ = static_cast<uint64_t>(
+        std::lround(config_.axis_rate_hz / config_.heartbeat_rate_hz));
+    if (heartbeat_ticks_ == 0) {
+        heartbeat_ticks_ = 1;
+    }
+    axis_stream_.setKeepalive(config_.axis_keepalive_ms > 0
+        ? static_cast<uint32_t>(std::ceil(config_.axis_keepalive_ms * config_.axis_rate_hz / 1000.0)) : 0);
+
+    PeriodicTimer timer(config_.axis_rate_hz);
+    const PeriodicTimer::Clock::time_point first_deadline = timer.deadline();
+    uint64_t tick = 0;
+    uint64_t deadline_index = 0;
+    // 定时器轮的 tick 单调递增，重新 start() 时从上次的位置继续计时；第一个周期即发送心跳
+    const uint64_t base_tick = wheel_.currentTick();
+    wheel_.schedule(base_tick + 1, TIMER_HEARTBEAT);
+
+    while (running_) {
+        drainRequests();
+
+        // 按截止时间序号推进（含定时器跳过的周期），心跳间隔、分段时长与轨迹时间不随漏掉的周期拉长
+        wheel_.advance(base_tick + deadline_index + 1, [this](TimerId, uint64_t user_data) { onTimer(user_data); });
+
+        axis_stream_.tick(axis_mailbox_);
+        publishAxisStats();
+
+        // 本周期入队的指令、心跳、轴值一次发出
+        transport_.flush();
+
+        tick++;
+        ticks_.store(tick, std::memory_order_relaxed);
+        // 等待区间之外即本周期的处理时间，漏掉的周期记为瞬时事件
+        Q25_TRACE_SCOPE(trace, "control.wait");
+        if (!timer.waitNext()) {
+            missed_deadlines_.store(timer.stats().missed, std::memory_order_relaxed);
+            Q25_TRACE_INSTANT("control.missed", timer.stats().missed);
+        }
+        deadline_index = static_cast<uint64_t>((timer.deadline() - first_deadline) / timer.period());
+    }
+
+    // 退出前处理剩余请求，并保证机器人收到零轴值
+    drainRequests();
+    axis_stream_.halt();
+    publishAxisStats();
+    transport_.flush();
+    wheel_.clear();
+}
+
+void ControlLoop::onTimer(uint64_t user_data) {
+    if (user_data == TIMER_HEARTBEAT) {
+        transport_.queue<cmd::Heartbeat>();
+        heartbeats_.fetch_add(1, std::memory_order_relaxed);
+        Q25_TRACE_INSTANT("control.heartbeat", wheel_.currentTick());
+        wheel_.schedule(wheel_.currentTick() + heartbeat_ticks_, TIMER_HEARTBEAT);
+    } else {
+        axis_stream_.onSegmentEnd();
+    }
+}
+
+void ControlLoop::drainRequests() {
+    LoopRequest request;
+    while (requests_.tryPop(request)) {
+        if (request.trajectory != nullptr) {
+            // 下一次 advance() 之后的周期即路线的 0 时刻
+            axis_stream_.startTrajectory(request.trajectory, request.trajectory_count,
+                                         wheel_.currentTick() + 1);
+            continue;
+        }
+        if (config_.merge_axis_values && request.image == nullptr && isLegacyAxis(request.code)) {
+            axis_stream_.mergeValue(request.code, request.param);
+            continue;
+        }
+        if (request.image != nullptr) {
+            transport_.queueRaw(request.image, sizeof(UDPCommand));
+        } else {
+            transport_.queueCommand(request.code, request.param);
+        }
+        commands_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ControlLoop::sendAxis(const AxisSetpoint& setpoint, bool stop) {
+    if (setpoint.mode == AxisSetpoint::MODE_AXIS) {
+        AxisCommand axis = setpoint.axis;
+        if (stop) {
+            memset(&axis, 0, sizeof(axis));
+        }
+        transport_.queueAxisControl(axis);
+    } else {
+        transport_.queueCommand(setpoint.axis_code, stop ? 0 : setpoint.axis_value);
+    }
+    axis_packets_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ControlLoop::publishAxisStats() {
+    const AxisStreamStats& stats = axis_stream_.stats();
+    coalesced_.store(stats.coalesced, std::memory_order_relaxed);
+    merged_axis_.store(stats.merged_axis, std::memory_order_relaxed);
+    suppressed_axis_.store(stats.suppressed, std::memory_order_relaxed);
+    trajectories_.store(stats.trajectories, std::memory_order_relaxed);
+}
+
+} // namespace q25
@@ -0,0 +1,206 @@
+// ====================================================================
+//          Created:    2026/10/14/ 11:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file control_loop.h
+ * @brief 单线程控制循环：心跳、轴值流、一次性指令统一调度
+ *
+ * 整个进程只有一个发送线程，按轴值频率 (默认 100Hz) 的绝对截止时间运行。
+ * 每个周期依次:
+ *   1. 取出队列中的全部一次性指令，按入队顺序编码
+ *   2. 推进定时器轮 (TimerWheel，tick 即控制周期的截止时间序号，漏掉的周期同样计入)，
+ *      触发到期的心跳、运动段结束等定时器
+ *   3. 从轴值邮箱 (AxisMailbox) 采样最新设定值，处于激活状态时编码；
+ *      两次采样之间被覆盖的旧设定值直接丢弃，只计入统计
+ *   4. 本周期的全部数据包按上述顺序一次 flush()（Linux 下为一次 sendmmsg）
+ *
+ * 带持续时间的轴值设定由控制线程的定时器在到期周期停止，调用线程不需要 Sleep 计时。
+ * 多段路线可整体交给 playTrajectory()，由控制线程每周期插值（见 trajectory.h）。
+ *
+ * merge_axis_values 打开时，单轴指令（setAxisValue() 或 sendCommand() 提交的
+ * 0x21010130 / 0x21010131 / 0x21010135）合并为扩展轴值指令 0x21010140，同一周期内
+ * 多个轴的更新只发出一个数据报（见 axis_translator.h）；axis_keepalive_ms 大于 0 时，
+ * 不变的轴值只按该间隔重发。
+ *
+ * 其他线程只通过无锁队列 / 邮箱提交请求，不直接操作 socket，
+ * 因此可以将控制线程单独绑定到隔离的 CPU 核上。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "axis_mailbox.h"
+#include "axis_stream.h"
+#include "command_queue.h"
+#include "packet_cache.h"
+#include "q25_codec.h"
+#include "q25_protocol.h"
+#include "timer_wheel.h"
+#include "trajectory.h"
+#include "udp_transport.h"
+
+namespace q25 {
+
+// ============ 控制循环配置 ============
+struct ControlLoopConfig {
+    double axis_rate_hz;       // 轴值发送频率（即控制循环频率）
+    double heartbeat_rate_hz;  // 心跳频率
+    int    cpu_core;           // 绑定的 CPU 核，-1 表示不绑定
+    bool   realtime_priority;  // 是否提升为实时优先级
+    bool   merge_axis_values;  // 单轴指令合并为扩展轴值指令 0x21010140
+    int    axis_keepalive_ms;  // 轴值不变时的重发间隔，0 表示每周期发送；需小于机器人端的轴值超时
+
+    ControlLoopConfig()
+        : axis_rate_hz(100.0)
+        , heartbeat_rate_hz(HEARTBEAT_RATE_HZ)
+        , cpu_core(-1)
+        , realtime_priority(false)
+        , merge_axis_values(false)
+        , axis_keepalive_ms(0) {}
+};
+
+// ============ 控制循环统计 ============
+struct ControlLoopStats {
+    uint64_t ticks;             // 已运行周期数
+    uint64_t missed_deadlines;  // 错过的截止时间
+    uint64_t heartbeats;        // 已发送心跳
+    uint64_t axis_packets;      // 已发送轴值包
+    uint64_t commands;          // 已发送一次性指令
+    uint64_t coalesced;         // 未被发送即被覆盖的轴值设定
+    uint64_t merged_axis;       // 合并进扩展轴值指令的单轴更新
+    uint64_t suppressed_axis;   // 轴值未变化而跳过发送的周期
+    uint64_t trajectories;      // 播放完成的轨迹
+    uint64_t queue_full;        // 队列满导致提交失败的次数
+};
+
+class ControlLoop {
+public:
+    explicit ControlLoop(UdpTransport& transport,
+                         const ControlLoopConfig& config = ControlLoopConfig());
+    ~ControlLoop();
+
+    ControlLoop(const ControlLoop&) = delete;
+    ControlLoop& operator=(const ControlLoop&) = delete;
+
+    bool start();
+    void stop();
+
+    // 一次性简单指令，在下一个周期发送；可在任意线程调用，只入队不阻塞
+    bool sendCommand(uint32_t cmd_code, int32_t param = 0);
+
+    // 按描述符入队，参数个数在编译期检查: send<cmd::StandUp>()
+    // 固定指令只入队预编码包的指针，控制线程发送时无需编码
+    template <typename Cmd>
+    bool send() {
+        return pushRequest(Cmd::CODE, 0, packetImage<Cmd>().data);
+    }
+
+    // 固定参数: send<cmd::ChangeHeight, HEIGHT_LOW>()
+    template <typename Cmd, int32_t Param>
+    bool send() {
+        return pushRequest(Cmd::CODE, Param, packetImage<Cmd, Param>().data);
+    }
+
+    // 运行期参数: send<cmd::ChangeHeight>(height)
+    template <typename Cmd>
+    bool send(int32_t param) {
+        static_assert(Cmd::TYPE == SIMPLE_CMD && Cmd::HAS_PARAM, "command takes no parameter");
+        return sendCommand(Cmd::CODE, param);
+    }
+
+    // ============ 轴值设定（写入邮箱，单写者，无等待） ============
+    // 高频生产者也可以直接通过 axisMailbox() 写入
+
+    // 开始/更新扩展轴值流（0x21010140）
+    // duration_ms 大于 0 时为运动段：持续 duration_ms 后自动发送零轴值并停止
+    void setAxis(const AxisCommand& axis_cmd, uint32_t duration_ms = 0);
+
+    // 开始/更新单轴轴值流（0x21010130/0x21010131/0x21010135 等单轴指令）
+    // merge_axis_values 打开时转换为只有该轴的扩展轴值流
+    void setAxisValue(uint32_t axis_code, int32_t axis_value, uint32_t duration_ms = 0);
+
+    // 停止轴值流：控制循环发送一次零轴值后不再发送
+    void stopAxis();
+
+    // ============ 轴值轨迹（任意线程，只入队） ============
+
+    /**
+     * @brief 在下一个周期开始播放路线，替换当前轴值流
+     *
+     * 控制线程每周期按路线插值得到扩展轴值设定，播放完毕后发送零轴值并停止。
+     * 期间写入新的轴值设定（setAxis / setAxisValue / stopAxis）时轨迹立即中止。
+     * segments 由调用方持有，需在播放结束前保持有效（一般为常量数组）。
+     */
+    bool playTrajectory(const TrajectorySegment* segments, size_t count);
+
+    template <size_t N>
+    bool playTrajectory(const TrajectorySegment (&segments)[N]) {
+        return playTrajectory(segments, N);
+    }
+
+    AxisMailbox& axisMailbox() { return axis_mailbox_; }
+
+    ControlLoopStats stats() const;
+
+private:
+    // 队列中的一次性指令；image 非空时为预编码包，直接发送；
+    // trajectory 非空时为播放轨迹请求
+    struct LoopRequest {
+        uint32_t       code;
+        int32_t        param;
+        const uint8_t* image;
+        const TrajectorySegment* trajectory;
+        size_t         trajectory_count;
+    };
+
+    // 定时器 user_data
+    enum TimerKind : uint64_t {
+        TIMER_HEARTBEAT   = 0,
+        TIMER_SEGMENT_END = 1
+    };
+
+    bool pushRequest(uint32_t code, int32_t param, const uint8_t* image);
+    bool pushRequest(const LoopRequest& request);
+    void run();
+    void onTimer(uint64_t user_data);
+    void drainRequests();
+    // AxisStream 的发送回调：入队轴值或零轴值
+    void sendAxis(const AxisSetpoint& setpoint, bool stop);
+    // 轴值流统计写入原子计数，供 stats() 读取
+    void publishAxisStats();
+
+    UdpTransport& transport_;
+    ControlLoopConfig config_;
+
+    MpscQueue<LoopRequest, 256> requests_;
+    AxisMailbox axis_mailbox_;
+
+    // 心跳与运动段定时器（仅控制线程访问）
+    TimerWheel wheel_;
+    uint64_t   heartbeat_ticks_;
+
+    // 轴值设定、运动段与轨迹（仅控制线程访问）
+    AxisStream axis_stream_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    std::atomic<uint64_t> ticks_;
+    std::atomic<uint64_t> missed_deadlines_;
+    std::atomic<uint64_t> heartbeats_;
+    std::atomic<uint64_t> axis_packets_;
+    std::atomic<uint64_t> commands_;
+    std::atomic<uint64_t> coalesced_;
+    std::atomic<uint64_t> merged_axis_;
+    std::atomic<uint64_t> suppressed_axis_;
+    std::atomic<uint64_t> trajectories_;
+    std::atomic<uint64_t> queue_full_;
+};
+
+} // namespace q25
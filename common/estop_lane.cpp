@@ -0,0 +1,127 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file estop_lane.cpp
+ * @brief EmergencyStopLane 实现
+ */
+
+#include "estop_lane.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace q25 {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+uint64_t elapsedNs(Clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+} // namespace
+
+EmergencyStopLane::EmergencyStopLane(const EstopLaneConfig& config)
+    : config_(config)
+    , triggers_(0)
+    , packets_(0)
+    , send_errors_(0) {
+    if (config_.copies < 1) {
+        config_.copies = 1;
+    }
+    if (config_.burst_window_us < 0) {
+        config_.burst_window_us = 0;
+    }
+}
+
+bool EmergencyStopLane::open(const char* ip, int port) {
+    if (!transport_.open(ip, port)) {
+        return false;
+    }
+    SocketTuning tuning;
+    tuning.dscp = config_.dscp;
+    tuning.priority = config_.priority;
+    if (!transport_.applyTuning(tuning)) {
+        std::cerr << "[WARNING] Emergency stop lane is open without full QoS marking" << std::endl;
+    }
+    return true;
+}
+
+void EmergencyStopLane::close() {
+    transport_.close();
+}
+
+bool EmergencyStopLane::trigger() {
+    Clock::time_point start = Clock::now();
+
+    // 首包：进入函数后的第一件事
+    bool any_sent = transport_.sendEmergencyStop();
+    uint64_t first_ns = elapsedNs(start);
+    int sent = any_sent ? 1 : 0;
+
+    // 其余副本在时间窗内等间隔发送，首包已占据时间窗起点
+    if (config_.copies > 1) {
+        std::chrono::microseconds interval(config_.burst_window_us / config_.copies);
+        for (int i = 1; i < config_.copies; i++) {
+            Clock::time_point due = start + interval * i;
+            while (Clock::now() < due) {
+                std::this_thread::yield();
+            }
+            if (transport_.sendEmergencyStop()) {
+                any_sent = true;
+                sent++;
+            }
+        }
+    }
+    uint64_t burst_ns = elapsedNs(start);
+
+    triggers_.fetch_add(1, std::memory_order_relaxed);
+    packets_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+    send_errors_.fetch_add(static_cast<uint64_t>(config_.copies - sent), std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        first_latency_.record(first_ns);
+        burst_latency_.record(burst_ns);
+    }
+
+    if (!any_sent) {
+        std::cerr << "[ERROR] Emergency stop lane failed to send any copy" << std::endl;
+    }
+    return any_sent;
+}
+
+EstopLaneStats EmergencyStopLane::stats() const {
+    EstopLaneStats s;
+    s.triggers = triggers_.load(std::memory_order_relaxed);
+    s.packets = packets_.load(std::memory_order_relaxed);
+    s.send_errors = send_errors_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    s.first_max_ns = first_latency_.max();
+    s.first_p99_ns = first_latency_.percentile(99.0);
+    s.burst_max_ns = burst_latency_.max();
+    return s;
+}
+
+void EmergencyStopLane::report(std::ostream& out) const {
+    EstopLaneStats s = stats();
+    out << std::fixed << std::setprecision(1)
+        << "[Estop] triggers=" << s.triggers
+        << " packets=" << s.packets
+        << " errors=" << s.send_errors
+        << " first_max=" << s.first_max_ns / 1000.0 << "us"
+        << " first_p99=" << s.first_p99_ns / 1000.0 << "us"
+        << " burst_max=" << s.burst_max_ns / 1000.0 << "us"
+        << std::endl;
+}
+
+} // namespace q25
@@ -0,0 +1,102 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file estop_lane.h
+ * @brief 急停专用高优先级发送通道
+ *
+ * 普通指令经过 ControlLoop 的队列，最坏要等一个控制周期、并排在轴值包之后。
+ * 急停通道与之完全独立:
+ *   - 单独的 socket，标记 DSCP CS6 与最高发送优先级
+ *   - trigger() 在调用线程上直接发送预编码的急停包，不经过任何队列或线程切换
+ *   - 冗余突发: 在 burst_window_us 内连续发送 copies 份，单个包丢失不影响急停
+ *   - 统计从 trigger() 调用到 send() 返回（数据报已交给网卡队列）的耗时，
+ *     记录首包与整组突发的最坏值与分布
+ *
+ * trigger() 可在任意线程调用，多个线程同时触发时各自完成自己的突发。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+
+#include "latency_histogram.h"
+#include "socket_options.h"
+#include "udp_transport.h"
+
+namespace q25 {
+
+struct EstopLaneConfig {
+    int copies;           // 每次触发发送的急停包份数
+    int burst_window_us;  // 所有副本在该时间窗内发完
+    int dscp;             // 急停 socket 的 DSCP
+    int priority;         // SO_PRIORITY（仅 Linux）
+
+    EstopLaneConfig()
+        : copies(3)
+        , burst_window_us(2000)
+        , dscp(DSCP_CS6)
+        , priority(6) {}
+};
+
+struct EstopLaneStats {
+    uint64_t triggers;          // 触发次数
+    uint64_t packets;           // 已发送的急停包
+    uint64_t send_errors;       // 发送失败的副本
+    uint64_t first_max_ns;      // 调用 → 首包发出 的最坏耗时
+    uint64_t first_p99_ns;
+    uint64_t burst_max_ns;      // 调用 → 最后一个副本发出 的最坏耗时
+};
+
+class EmergencyStopLane {
+public:
+    explicit EmergencyStopLane(const EstopLaneConfig& config = EstopLaneConfig());
+
+    EmergencyStopLane(const EmergencyStopLane&) = delete;
+    EmergencyStopLane& operator=(const EmergencyStopLane&) = delete;
+
+    /**
+     * @brief 打开独立的急停 socket 并设置 DSCP / 优先级
+     *
+     * 选项设置失败（如 Windows 未配置 QoS 策略）只输出警告，不影响发送。
+     */
+    bool open(const char* ip, int port);
+    void close();
+    bool isOpen() const { return transport_.isOpen(); }
+
+    /**
+     * @brief 立即发送一组急停包，返回前全部副本已发出
+     *
+     * 首包在进入函数后立刻发送；其余副本在时间窗内等间隔发送，
+     * 间隔期间调用线程自旋等待（总计不超过 burst_window_us）。
+     *
+     * @return 至少一份副本发送成功时返回 true
+     */
+    bool trigger();
+
+    EstopLaneStats stats() const;
+
+    /** @brief 输出延迟统计（微秒） */
+    void report(std::ostream& out) const;
+
+private:
+    EstopLaneConfig config_;
+    UdpTransport transport_;
+
+    std::atomic<uint64_t> triggers_;
+    std::atomic<uint64_t> packets_;
+    std::atomic<uint64_t> send_errors_;
+
+    // 延迟统计只在突发发送完成后更新，不占用发送路径
+    mutable std::mutex stats_mutex_;
+    LatencyHistogram first_latency_;
+    LatencyHistogram burst_latency_;
+};
+
+} // namespace q25
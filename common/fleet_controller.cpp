@@ -0,0 +1,681 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:45
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file fleet_controller.cpp
+ * @brief FleetController 实现
+ */
+
+#include "fleet_controller.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include "cache_line.h"
+#include "net_platform.h"
+#include "thread_utils.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace q25 {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// 周期换算为 tick 数，至少 1 个 tick
+uint64_t periodTicks(double rate_hz, int tick_us) {
+    double ticks = 1e6 / rate_hz / tick_us;
+    return ticks < 1.0 ? 1 : static_cast<uint64_t>(std::llround(ticks));
+}
+
+} // namespace
+
+// ============ 任务宿主 ============
+class FleetController::RobotMissionHost : public MissionHost {
+public:
+    RobotMissionHost(FleetController& fleet, int index)
+        : fleet_(fleet)
+        , index_(index) {}
+
+    void sendCommand(uint32_t code, int32_t param) override {
+        fleet_.submitCommand(index_, code, param);
+    }
+
+    void playTrajectory(const TrajectorySegment* segments, size_t count) override {
+        fleet_.robots_[index_].axis_stream.startTrajectory(segments, count, fleet_.wheel_.currentTick());
+    }
+
+    bool trajectoryActive() const override {
+        return fleet_.robots_[index_].axis_stream.trajectoryActive();
+    }
+
+    void stopAxis() override {
+        fleet_.robots_[index_].axis_stream.halt();
+    }
+
+    bool latestMotion(MotionData& out) const override {
+        const RobotStatus& status = fleet_.robots_[index_].status;
+        out = status.motion;
+        return (status.valid & RobotStatus::HAS_MOTION) != 0;
+    }
+
+private:
+    FleetController& fleet_;
+    int index_;
+};
+
+FleetController::FleetController(const FleetConfig& config)
+    : config_(config)
+    , robots_(nullptr)
+    , robot_count_(0)
+    , sock_(INVALID_SOCKET)
+    , receiver_(config.recv_batch, RECV_BUFFER_SIZE)
+    , sender_(config.send_batch, MAX_COMMAND_SIZE)
+    , wheel_(config.max_robots * TIMER_KINDS)
+    , current_robot_(-1)
+    , heartbeat_ticks_(1)
+    , axis_ticks_(1)
+    , status_timeout_ticks_(0)
+    , running_(false)
+    , loop_iterations_(0)
+    , timers_fired_(0)
+    , heartbeats_(0)
+    , axis_packets_(0)
+    , suppressed_axis_(0)
+    , commands_(0)
+    , send_errors_(0)
+    , send_syscalls_(0)
+    , status_packets_(0)
+    , unknown_source_(0)
+    , stale_status_(0)
+    , queue_full_(0)
+    , missions_completed_(0)
+    , missions_failed_(0)
+    , missions_aborted_(0) {
+    if (config_.tick_us <= 0) {
+        config_.tick_us = 1000;
+    }
+    robots_ = static_cast<Robot*>(alignedAlloc(sizeof(Robot) * config_.max_robots));
+    if (robots_ == nullptr) {
+        std::cerr << "[ERROR] Failed to allocate fleet robot table" << std::endl;
+        config_.max_robots = 0;
+    }
+    robot_by_ip_.reserve(config_.max_robots);
+
+    // 状态解析结果写入当前机器人的工作副本
+    dispatcher_.onBattery([this](const PacketHeader&, const BatteryData& battery) {
+        robots_[current_robot_].status.battery = battery;
+        robots_[current_robot_].status.valid |= RobotStatus::HAS_BATTERY;
+    });
+    dispatcher_.onIMU([this](const PacketHeader&, const IMUData& imu) {
+        robots_[current_robot_].status.imu = imu;
+        robots_[current_robot_].status.valid |= RobotStatus::HAS_IMU;
+    });
+    dispatcher_.onMotion([this](const PacketHeader&, const MotionData& motion) {
+        robots_[current_robot_].status.motion = motion;
+        robots_[current_robot_].status.valid |= RobotStatus::HAS_MOTION;
+    });
+}
+
+FleetController::~FleetController() {
+    stop();
+    for (size_t i = 0; i < robot_count_; i++) {
+        robots_[i].~Robot();
+    }
+    alignedFree(robots_);
+}
+
+int FleetController::addRobot(const char* ip, int port) {
+    if (running_) {
+        std::cerr << "[ERROR] Robots must be added before the fleet controller starts" << std::endl;
+        return -1;
+    }
+    if (robot_count_ >= config_.max_robots) {
+        std::cerr << "[ERROR] Fleet is full (" << config_.max_robots << " robots)" << std::endl;
+        return -1;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, ip, &addr.sin_addr) != 1) {
+        std::cerr << "[ERROR] Invalid robot address: " << ip << std::endl;
+        return -1;
+    }
+    uint32_t key = addr.sin_addr.s_addr;
+    if (robot_by_ip_.count(key) != 0) {
+        std::cerr << "[ERROR] Robot " << ip << " is already registered" << std::endl;
+        return -1;
+    }
+
+    int id = static_cast<int>(robot_count_);
+    Robot* robot = new (&robots_[id]) Robot();
+    robot->addr = addr;
+    memset(&robot->status, 0, sizeof(robot->status));
+    robot->axis_stream.init(&wheel_, config_.tick_us, id * TIMER_KINDS + TIMER_SEGMENT_END,
+                            [this, robot](const AxisSetpoint& setpoint, bool stop) {
+                                sendAxis(*robot, setpoint, stop);
+                            });
+    robot->axis_stream.setMergeLegacy(config_.merge_axis_values);
+    robot->watchdog_timer = INVALID_TIMER_ID;
+    robot->mission_timer = INVALID_TIMER_ID;
+    robot->status_snapshot.store(robot->status);
+
+    robot_by_ip_[key] = id;
+    robot_count_++;
+    return id;
+}
+
+bool FleetController::openSocket() {
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET) {
+        std::cerr << "[ERROR] Failed to create fleet socket: " << lastSocketError() << std::endl;
+        return false;
+    }
+
+    int opt = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
+    applySocketTuning(sock, config_.tuning);
+
+    sockaddr_in local_addr;
+    memset(&local_addr, 0, sizeof(local_addr));
+    local_addr.sin_family = AF_INET;
+    local_addr.sin_port = htons(static_cast<uint16_t>(config_.local_port));
+    if (inet_pton(AF_INET, config_.bind_ip.c_str(), &local_addr.sin_addr) != 1) {
+        std::cerr << "[ERROR] Invalid bind address: " << config_.bind_ip << std::endl;
+        closeSocketHandle(sock);
+        return false;
+    }
+    if (bind(sock, reinterpret_cast<sockaddr*>(&local_addr), sizeof(local_addr)) != 0) {
+        std::cerr << "[ERROR] Failed to bind fleet socket to " << config_.bind_ip << ":"
+                  << config_.local_port << ", error: " << lastSocketError() << std::endl;
+        closeSocketHandle(sock);
+        return false;
+    }
+
+    if (!receiver_.open(sock)) {
+        closeSocketHandle(sock);
+        return false;
+    }
+    sender_.open(sock);
+    sock_ = sock;
+    return true;
+}
+
+void FleetController::closeSocket() {
+    receiver_.close();
+    sender_.close();
+    if (sock_ != INVALID_SOCKET) {
+        closeSocketHandle(sock_);
+        sock_ = INVALID_SOCKET;
+    }
+}
+
+bool FleetController::start() {
+    if (running_) {
+        return true;
+    }
+    if (robot_count_ == 0) {
+        std::cerr << "[ERROR] Fleet controller has no robots" << std::endl;
+        return false;
+    }
+    if (!openSocket()) {
+        return false;
+    }
+    heartbeat_ticks_ = periodTicks(config_.heartbeat_rate_hz, config_.tick_us);
+    axis_ticks_ = periodTicks(config_.axis_rate_hz, config_.tick_us);
+    status_timeout_ticks_ = config_.status_timeout_ms > 0
+        ? periodTicks(1000.0 / config_.status_timeout_ms, config_.tick_us) : 0;
+    // 保活间隔以轴值发送周期计
+    uint32_t keepalive_periods = config_.axis_keepalive_ms > 0
+        ? static_cast<uint32_t>(std::ceil(config_.axis_keepalive_ms * config_.axis_rate_hz / 1000.0)) : 0;
+    for (size_t i = 0; i < robot_count_; i++) {
+        robots_[i].axis_stream.setKeepalive(keepalive_periods);
+    }
+
+    running_ = true;
+    thread_ = std::thread(&FleetController::run, this);
+    return true;
+}
+
+void FleetController::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeSocket();
+}
+
+bool FleetController::sendCommand(int robot, uint32_t cmd_code, int32_t param) {
+    return pushRequest(robot, cmd_code, param, nullptr);
+}
+
+bool FleetController::runMission(int robot, const Mission& mission) {
+    FleetRequest request;
+    memset(&request, 0, sizeof(request));
+    request.kind = REQUEST_MISSION;
+    request.robot = robot;
+    request.mission = &mission;
+    return pushRequest(request);
+}
+
+bool FleetController::abortMission(int robot) {
+    FleetRequest request;
+    memset(&request, 0, sizeof(request));
+    request.kind = REQUEST_ABORT_MISSION;
+    request.robot = robot;
+    return pushRequest(request);
+}
+
+bool FleetController::playTrajectory(int robot, const TrajectorySegment* segments, size_t count) {
+    FleetRequest request;
+    memset(&request, 0, sizeof(request));
+    request.kind = REQUEST_TRAJECTORY;
+    request.robot = robot;
+    request.trajectory = segments;
+    request.trajectory_count = count;
+    return pushRequest(request);
+}
+
+bool FleetController::pushRequest(int robot, uint32_t code, int32_t param, const uint8_t* image) {
+    FleetRequest request;
+    memset(&request, 0, sizeof(request));
+    request.kind = REQUEST_COMMAND;
+    request.robot = robot;
+    request.code = code;
+    request.param = param;
+    request.image = image;
+    return pushRequest(request);
+}
+
+bool FleetController::pushRequest(const FleetRequest& request) {
+    if (!validRobot(request.robot)) {
+        return false;
+    }
+    if (!requests_.tryPush(request)) {
+        queue_full_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void FleetController::setAxis(int robot, const AxisCommand& axis_cmd, uint32_t duration_ms) {
+    if (validRobot(robot)) {
+        robots_[robot].axis_mailbox.publish(axis_cmd, duration_ms);
+    }
+}
+
+void FleetController::setAxisValue(int robot, uint32_t axis_code, int32_t axis_value, uint32_t duration_ms) {
+    if (validRobot(robot)) {
+        robots_[robot].axis_mailbox.publishValue(axis_code, axis_value, duration_ms);
+    }
+}
+
+void FleetController::stopAxis(int robot) {
+    if (validRobot(robot)) {
+        robots_[robot].axis_mailbox.clear();
+    }
+}
+
+bool FleetController::status(int robot, RobotStatus& out) const {
+    if (!validRobot(robot)) {
+        return false;
+    }
+    return robots_[robot].status_snapshot.tryLoad(out);
+}
+
+FleetStats FleetController::stats() const {
+    FleetStats s;
+    s.loop_iterations = loop_iterations_.load(std::memory_order_relaxed);
+    s.timers_fired = timers_fired_.load(std::memory_order_relaxed);
+    s.heartbeats = heartbeats_.load(std::memory_order_relaxed);
+    s.axis_packets = axis_packets_.load(std::memory_order_relaxed);
+    s.suppressed_axis = suppressed_axis_.load(std::memory_order_relaxed);
+    s.commands = commands_.load(std::memory_order_relaxed);
+    s.send_errors = send_errors_.load(std::memory_order_relaxed);
+    s.send_syscalls = send_syscalls_.load(std::memory_order_relaxed);
+    s.status_packets = status_packets_.load(std::memory_order_relaxed);
+    s.unknown_source = unknown_source_.load(std::memory_order_relaxed);
+    s.stale_status = stale_status_.load(std::memory_order_relaxed);
+    s.queue_full = queue_full_.load(std::memory_order_relaxed);
+    s.missions_completed = missions_completed_.load(std::memory_order_relaxed);
+    s.missions_failed = missions_failed_.load(std::memory_order_relaxed);
+    s.missions_aborted = missions_aborted_.load(std::memory_order_relaxed);
+    return s;
+}
+
+// ============ 事件循环 ============
+
+void FleetController::run() {
+    Q25_TRACE_THREAD("Fleet");
+    pinCurrentThread(config_.cpu_core);
+    if (config_.realtime_priority) {
+        setCurrentThreadRealtime();
+    }
+#ifdef _WIN32
+    // 接收等待以毫秒为单位，提高系统时钟精度使 1ms tick 不被放大到 15.6ms
+    bool time_period_raised = (timeBeginPeriod(1) == 0);
+#endif
+
+    const int64_t tick_ns = static_cast<int64_t>(config_.tick_us) * 1000;
+    Clock::time_point start = Clock::now();
+    // 定时器轮的 tick 单调递增，重新 start() 时从上次的位置继续计时
+    const uint64_t base_tick = wheel_.currentTick();
+    scheduleInitialTimers();
+
+    while (running_) {
+        int timeout_ms = 0;
+        if (!config_.busy_poll) {
+            // 等待到下一个 tick，期间到达的状态包会提前唤醒
+            int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start).count();
+            int64_t wait_ns = static_cast<int64_t>(wheel_.currentTick() + 1 - base_tick) * tick_ns - now_ns;
+            timeout_ms = wait_ns <= 0 ? 0 : static_cast<int>((wait_ns + 999999) / 1000000);
+        }
+
+        size_t count = receiver_.receive(timeout_ms);
+        if (count > 0) {
+            Q25_TRACE_SCOPE(trace_status, "fleet.status");
+            Q25_TRACE_ARG(trace_status, count);
+            int64_t recv_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now().time_since_epoch()).count();
+            for (size_t i = 0; i < count; i++) {
+                handleDatagram(receiver_.datagram(i), recv_ns);
+            }
+        }
+
+        drainRequests();
+
+        // 到期定时器与本次迭代的批量发送
+        Q25_TRACE_SCOPE(trace_tick, "fleet.tick");
+        int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start).count();
+        size_t fired = wheel_.advance(base_tick + static_cast<uint64_t>(elapsed_ns / tick_ns),
+                                      [this](TimerId, uint64_t user_data) { onTimer(user_data); });
+        if (fired > 0) {
+            timers_fired_.fetch_add(fired, std::memory_order_relaxed);
+        }
+        Q25_TRACE_ARG(trace_tick, fired);
+        flushSends();
+        loop_iterations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 退出前处理剩余请求，中止未结束的任务，并保证所有机器人收到零轴值
+    drainRequests();
+    for (size_t i = 0; i < robot_count_; i++) {
+        robots_[i].mission.abort();
+        updateMissionStatus(static_cast<int>(i));
+        robots_[i].axis_stream.halt();
+    }
+    flushSends();
+    // 清空全部定时器，以便再次 start()
+    wheel_.clear();
+    for (size_t i = 0; i < robot_count_; i++) {
+        robots_[i].watchdog_timer = INVALID_TIMER_ID;
+        robots_[i].mission_timer = INVALID_TIMER_ID;
+    }
+
+#ifdef _WIN32
+    if (time_period_raised) {
+        timeEndPeriod(1);
+    }
+#endif
+}
+
+void FleetController::scheduleInitialTimers() {
+    // 各机器人的相位在一个周期内均匀错开
+    uint64_t now = wheel_.currentTick();
+    for (size_t i = 0; i < robot_count_; i++) {
+        uint64_t heartbeat_phase = heartbeat_ticks_ * i / robot_count_;
+        uint64_t axis_phase = axis_ticks_ * i / robot_count_;
+        wheel_.schedule(now + 1 + heartbeat_phase, i * TIMER_KINDS + TIMER_HEARTBEAT);
+        wheel_.schedule(now + 1 + axis_phase, i * TIMER_KINDS + TIMER_AXIS);
+    }
+}
+
+void FleetController::armWatchdog(int index) {
+    if (status_timeout_ticks_ == 0) {
+        return;
+    }
+    Robot& robot = robots_[index];
+    uint64_t expires = wheel_.currentTick() + status_timeout_ticks_;
+    if (!wheel_.reschedule(robot.watchdog_timer, expires)) {
+        robot.watchdog_timer = wheel_.schedule(expires, index * TIMER_KINDS + TIMER_WATCHDOG);
+    }
+}
+
+void FleetController::onTimer(uint64_t user_data) {
+    int index = static_cast<int>(user_data / TIMER_KINDS);
+    Robot& robot = robots_[index];
+
+    switch (user_data % TIMER_KINDS) {
+    case TIMER_HEARTBEAT: {
+        PacketImage heartbeat = packetImage<cmd::Heartbeat>();
+        if (sendTo(robot, heartbeat.data, heartbeat.size)) {
+            heartbeats_.fetch_add(1, std::memory_order_relaxed);
+        }
+        Q25_TRACE_INSTANT("fleet.heartbeat", index);
+        wheel_.schedule(wheel_.currentTick() + heartbeat_ticks_, user_data);
+        break;
+    }
+    case TIMER_AXIS:
+        if (!robot.axis_stream.tick(robot.axis_mailbox)) {
+            suppressed_axis_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // 路线播放完毕或被新的轴值设定打断
+        if (robot.mission.waiting() == MISSION_WAIT_TRAJECTORY && !robot.axis_stream.trajectoryActive()) {
+            resumeMission(index);
+        }
+        wheel_.schedule(wheel_.currentTick() + axis_ticks_, user_data);
+        break;
+    case TIMER_SEGMENT_END:
+        robot.axis_stream.onSegmentEnd();
+        break;
+    case TIMER_WATCHDOG:
+        // 状态中断的机器人不再接收轴值流，直到生产者写入新的设定值
+        robot.watchdog_timer = INVALID_TIMER_ID;
+        robot.status.online = false;
+        robot.status_snapshot.store(robot.status);
+        stale_status_.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "[WARNING] Robot " << index << " status timed out after "
+                  << config_.status_timeout_ms << " ms, axis stream stopped" << std::endl;
+        // 离线机器人上的任务无法判断是否到达目标状态，直接中止
+        robot.mission.abort();
+        updateMissionStatus(index);
+        robot.axis_stream.halt();
+        break;
+    case TIMER_MISSION:
+        robot.mission_timer = INVALID_TIMER_ID;
+        resumeMission(index);
+        break;
+    default:
+        break;
+    }
+}
+
+void FleetController::handleDatagram(const ReceivedDatagram& datagram, int64_t recv_ns) {
+    std::unordered_map<uint32_t, int>::const_iterator it =
+        robot_by_ip_.find(datagram.from.sin_addr.s_addr);
+    if (it == robot_by_ip_.end()) {
+        unknown_source_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Robot& robot = robots_[it->second];
+    current_robot_ = it->second;
+    dispatcher_.parsePacket(datagram.data, datagram.len);
+    robot.status.packets++;
+    robot.status.last_status_ns = recv_ns;
+    robot.status.online = true;
+    armWatchdog(it->second);
+    robot.status_snapshot.store(robot.status);
+    status_packets_.fetch_add(1, std::memory_order_relaxed);
+
+    if (status_handler_) {
+        status_handler_(it->second, datagram.data, datagram.len);
+    }
+    if (robot.mission.waiting() == MISSION_WAIT_MOTION) {
+        resumeMission(it->second);
+    }
+}
+
+void FleetController::drainRequests() {
+    FleetRequest request;
+    while (requests_.tryPop(request)) {
+        Robot& robot = robots_[request.robot];
+        switch (request.kind) {
+        case REQUEST_MISSION:
+            // 替换未结束的任务：先停止它留下的路线与轴值流
+            if (robot.mission.state() == MISSION_RUNNING) {
+                robot.mission.abort();
+                updateMissionStatus(request.robot);
+                robot.axis_stream.halt();
+            }
+            robot.mission.start(request.mission, request.robot);
+            updateMissionStatus(request.robot);
+            resumeMission(request.robot);
+            break;
+        case REQUEST_ABORT_MISSION:
+            if (robot.mission.state() == MISSION_RUNNING) {
+                robot.mission.abort();
+                updateMissionStatus(request.robot);
+                robot.axis_stream.halt();
+            }
+            break;
+        case REQUEST_TRAJECTORY:
+            robot.axis_stream.startTrajectory(request.trajectory, request.trajectory_count,
+                                              wheel_.currentTick());
+            break;
+        default:
+            if (request.image != nullptr) {
+                if (sendTo(robot, request.image, sizeof(UDPCommand))) {
+                    commands_.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else {
+                submitCommand(request.robot, request.code, request.param);
+            }
+            break;
+        }
+    }
+}
+
+void FleetController::submitCommand(int index, uint32_t code, int32_t param) {
+    Robot& robot = robots_[index];
+    if (robot.axis_stream.mergeLegacy() && isLegacyAxis(code)) {
+        robot.axis_stream.mergeValue(code, param);
+        return;
+    }
+    sendSimple(robot, code, param);
+}
+
+bool FleetController::sendSimple(Robot& robot, uint32_t code, int32_t param) {
+    uint8_t buf[sizeof(UDPCommand)];
+    if (!sendTo(robot, buf, encodeSimple(buf, code, param))) {
+        return false;
+    }
+    commands_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// ============ 任务 ============
+
+void FleetController::resumeMission(int index) {
+    Robot& robot = robots_[index];
+    RobotMissionHost host(*this, index);
+    uint64_t now_ms = wheel_.currentTick() * static_cast<uint64_t>(config_.tick_us) / 1000;
+    MissionWait wait = robot.mission.resume(host, now_ms);
+
+    // 按时间等待的步骤用定时器唤醒；状态与路线由 handleDatagram() / TIMER_AXIS 唤醒
+    if (wait == MISSION_WAIT_TIME || wait == MISSION_WAIT_MOTION || wait == MISSION_WAIT_YIELD) {
+        uint64_t expires = wait == MISSION_WAIT_YIELD
+            ? wheel_.currentTick() + 1
+            : (robot.mission.deadlineMs() * 1000 + config_.tick_us - 1) / static_cast<uint64_t>(config_.tick_us);
+        if (!wheel_.reschedule(robot.mission_timer, expires)) {
+            robot.mission_timer = wheel_.schedule(expires, index * TIMER_KINDS + TIMER_MISSION);
+        }
+    } else if (robot.mission_timer != INVALID_TIMER_ID) {
+        wheel_.cancel(robot.mission_timer);
+        robot.mission_timer = INVALID_TIMER_ID;
+    }
+    updateMissionStatus(index);
+}
+
+void FleetController::updateMissionStatus(int index) {
+    Robot& robot = robots_[index];
+    uint32_t state = robot.mission.state();
+    uint32_t step = static_cast<uint32_t>(robot.mission.step());
+    if (state == robot.status.mission_state && step == robot.status.mission_step) {
+        return;
+    }
+
+    if (state != robot.status.mission_state && state != MISSION_RUNNING) {
+        const char* result = "aborted";
+        if (state == MISSION_DONE) {
+            result = "completed";
+            missions_completed_.fetch_add(1, std::memory_order_relaxed);
+        } else if (state == MISSION_FAILED) {
+            result = "failed";
+            missions_failed_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            missions_aborted_.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::cout << "[INFO] Robot " << index << " mission " << robot.mission.mission()->name
+                  << " " << result << std::endl;
+        if (robot.mission_timer != INVALID_TIMER_ID) {
+            wheel_.cancel(robot.mission_timer);
+            robot.mission_timer = INVALID_TIMER_ID;
+        }
+    }
+    robot.status.mission_state = state;
+    robot.status.mission_step = step;
+    robot.status_snapshot.store(robot.status);
+}
+
+void FleetController::sendAxis(const Robot& robot, const AxisSetpoint& setpoint, bool stop) {
+    uint8_t buf[MAX_COMMAND_SIZE];
+    size_t len = 0;
+    if (setpoint.mode == AxisSetpoint::MODE_AXIS) {
+        AxisCommand axis = setpoint.axis;
+        if (stop) {
+            memset(&axis, 0, sizeof(axis));
+        }
+        len = encode<cmd::AxisControl>(buf, axis);
+    } else {
+        len = encodeSimple(buf, setpoint.axis_code, stop ? 0 : setpoint.axis_value);
+    }
+    if (sendTo(robot, buf, len)) {
+        axis_packets_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool FleetController::sendTo(const Robot& robot, const void* data, size_t len) {
+    return sender_.enqueue(data, len, &robot.addr);
+}
+
+void FleetController::flushSends() {
+    if (sender_.pending() > 0) {
+        sender_.flush();
+    }
+    // 入队被拒绝、槽位满时的提前发送与本次发送的失败都计入 BatchSender 统计
+    const BatchSenderStats& stats = sender_.stats();
+    send_errors_.store(stats.errors, std::memory_order_relaxed);
+    send_syscalls_.store(stats.syscalls, std::memory_order_relaxed);
+}
+
+} // namespace q25
@@ -0,0 +1,323 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:45
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file fleet_controller.h
+ * @brief 多机器人集群控制：单线程事件循环管理 N 台机器人
+ *
+ * 每台机器人一个进程、一个心跳线程的方式无法扩展到整个站点。
+ * FleetController 在一个线程里完成全部工作:
+ *   - 一个绑定到本地端口的 UDP socket，向各机器人发送指令，
+ *     并接收所有机器人上报的状态（Windows 为 IOCP，Linux 为 recvmmsg，见 BatchReceiver）
+ *   - 每次循环迭代产生的全部数据包（各机器人的心跳、轴值、指令）先入队，
+ *     迭代末按产生顺序一次发出（Linux 为 sendmmsg，见 BatchSender）
+ *   - 每台机器人的心跳、轴值流都是定时器轮 (TimerWheel) 中的周期定时器，
+ *     各机器人的相位错开，避免同一 tick 集中发送；运动段结束、状态看门狗也是定时器
+ *   - axis_keepalive_ms 大于 0 时，轴值不变的机器人只按该间隔重发（见 AxisDeltaFilter）；
+ *     merge_axis_values 打开时单轴指令合并为扩展轴值指令 0x21010140（与 ControlLoop 共用 AxisStream）
+ *   - 超过 status_timeout_ms 未收到状态的机器人标记为离线，并停止其轴值流
+ *   - 收到的状态按源 IP 分发到对应机器人，解析后的最新状态通过 seqlock 供其他线程读取
+ *   - 每台机器人可播放一条轴值路线 (TrajectoryEngine)，并执行一个任务脚本 (MissionRunner)：
+ *     任务在定时器到期、状态包到达或路线结束时推进，不阻塞事件循环，
+ *     因此成百上千台机器人的任务可以在这一个线程里同时执行
+ *
+ * 其他线程通过无锁队列提交一次性指令、任务与路线，通过每台机器人的轴值邮箱更新轴值设定，
+ * 均不直接操作 socket。
+ *
+ * 机器人需在 start() 之前通过 addRobot() 注册。使用前需先构造 NetworkRuntime。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "axis_mailbox.h"
+#include "axis_stream.h"
+#include "batch_receiver.h"
+#include "batch_sender.h"
+#include "command_queue.h"
+#include "mission.h"
+#include "net_types.h"
+#include "packet_cache.h"
+#include "q25_protocol.h"
+#include "seqlock.h"
+#include "socket_options.h"
+#include "status_dispatcher.h"
+#include "status_protocol.h"
+#include "timer_wheel.h"
+#include "trajectory.h"
+
+namespace q25 {
+
+// ============ 集群配置 ============
+struct FleetConfig {
+    std::string bind_ip;       // 本地监听地址
+    int    local_port;         // 本地端口，各机器人的状态上报目标
+    size_t max_robots;         // 机器人数量上限
+    double heartbeat_rate_hz;  // 每台机器人的心跳频率
+    double axis_rate_hz;       // 每台机器人的轴值发送频率
+    int    axis_keepalive_ms;  // 轴值不变时的重发间隔，0 表示按 axis_rate_hz 持续发送
+    bool   merge_axis_values;  // 单轴指令合并为扩展轴值指令 0x21010140
+    int    tick_us;            // 定时器轮 tick 长度（微秒）
+    int    status_timeout_ms;  // 状态看门狗超时，0 表示不检测
+    size_t recv_batch;         // 单次最多取回的数据报数
+    size_t send_batch;         // 单次最多发出的数据报数，超出时分多次发送
+    bool   busy_poll;          // 为 true 时事件循环不阻塞等待，独占一个核
+    int    cpu_core;           // 事件循环绑定的 CPU 核，-1 表示不绑定
+    bool   realtime_priority;  // 是否提升为实时优先级
+    SocketTuning tuning;       // socket 调优（接收缓冲区、DSCP 等）
+
+    FleetConfig()
+        : bind_ip("0.0.0.0")
+        , local_port(DEFAULT_LOCAL_PORT)
+        , max_robots(64)
+        , heartbeat_rate_hz(HEARTBEAT_RATE_HZ)
+        , axis_rate_hz(100.0)
+        , axis_keepalive_ms(0)
+        , merge_axis_values(false)
+        , tick_us(1000)
+        , status_timeout_ms(1000)
+        , recv_batch(64)
+        , send_batch(256)
+        , busy_poll(false)
+        , cpu_core(-1)
+        , realtime_priority(false) {
+        tuning.recv_buffer_bytes = 4 * 1024 * 1024;
+        tuning.dscp = DSCP_EF;
+    }
+};
+
+// ============ 单台机器人的最新状态 ============
+struct RobotStatus {
+    enum : uint32_t {
+        HAS_BATTERY = 1u << 0,
+        HAS_IMU     = 1u << 1,
+        HAS_MOTION  = 1u << 2
+    };
+
+    uint32_t    valid;           // HAS_* 位，表示对应字段已收到过
+    bool        online;          // 看门狗超时前收到过状态
+    uint64_t    packets;         // 收到的状态包
+    int64_t     last_status_ns;  // 最近一次收到状态的本机时间（steady_clock），0 表示从未收到
+    BatteryData battery;
+    IMUData     imu;
+    MotionData  motion;
+    uint32_t    mission_state;   // MissionState
+    uint32_t    mission_step;    // 任务当前步骤下标
+};
+
+// ============ 集群统计 ============
+struct FleetStats {
+    uint64_t loop_iterations;     // 事件循环迭代次数
+    uint64_t timers_fired;        // 触发的定时器
+    uint64_t heartbeats;          // 已发送心跳（含发送失败的，见 send_errors）
+    uint64_t axis_packets;        // 已发送轴值包
+    uint64_t suppressed_axis;     // 轴值未变化而跳过的发送
+    uint64_t commands;            // 已发送一次性指令
+    uint64_t send_errors;         // 发送失败
+    uint64_t send_syscalls;       // 发送的系统调用次数
+    uint64_t status_packets;      // 收到并分发的状态包
+    uint64_t unknown_source;      // 来自未注册地址的数据报
+    uint64_t stale_status;        // 状态看门狗超时（机器人转为离线）的次数
+    uint64_t queue_full;          // 队列满导致提交失败的次数
+    uint64_t missions_completed;  // 执行完毕的任务
+    uint64_t missions_failed;     // required 等待超时而失败的任务
+    uint64_t missions_aborted;    // 被替换、abortMission()、机器人离线或 stop() 中止的任务
+};
+
+class FleetController {
+public:
+    // 在事件循环线程中回调，收到某台机器人的原始状态包
+    typedef std::function<void(int robot, const uint8_t* data, size_t len)> StatusHandler;
+
+    explicit FleetController(const FleetConfig& config = FleetConfig());
+    ~FleetController();
+
+    FleetController(const FleetController&) = delete;
+    FleetController& operator=(const FleetController&) = delete;
+
+    /**
+     * @brief 注册一台机器人，需在 start() 之前调用
+     *
+     * 状态按源 IP 归属（机器人上报状态的源端口不一定等于指令端口），
+     * 因此每个 IP 只能注册一次。
+     *
+     * @return 机器人编号（0 起），失败返回 -1
+     */
+    int addRobot(const char* ip, int port = DEFAULT_ROBOT_PORT);
+
+    size_t robotCount() const { return robot_count_; }
+
+    /** @brief 订阅原始状态包，需在 start() 之前调用 */
+    void onStatus(const StatusHandler& handler) { status_handler_ = handler; }
+
+    bool start();
+    void stop();
+
+    // ============ 一次性指令（任意线程，只入队不阻塞） ============
+
+    bool sendCommand(int robot, uint32_t cmd_code, int32_t param = 0);
+
+    template <typename Cmd>
+    bool send(int robot) {
+        return pushRequest(robot, Cmd::CODE, 0, packetImage<Cmd>().data);
+    }
+
+    template <typename Cmd, int32_t Param>
+    bool send(int robot) {
+        return pushRequest(robot, Cmd::CODE, Param, packetImage<Cmd, Param>().data);
+    }
+
+    // ============ 任务与路线（任意线程，只入队不阻塞） ============
+
+    /**
+     * @brief 在 robot 上执行任务，替换其未结束的任务
+     *
+     * mission 由调用方持有，需在任务结束前保持有效；多台机器人可共用同一个 Mission。
+     * 进度见 RobotStatus::mission_state / mission_step。
+     */
+    bool runMission(int robot, const Mission& mission);
+    // 中止任务并停止其轴值流
+    bool abortMission(int robot);
+
+    // 播放轴值路线，segments 需在播放结束前保持有效；轴值邮箱的新设定值会打断路线
+    bool playTrajectory(int robot, const TrajectorySegment* segments, size_t count);
+
+    template <size_t N>
+    bool playTrajectory(int robot, const TrajectorySegment (&segments)[N]) {
+        return playTrajectory(robot, segments, N);
+    }
+
+    // ============ 轴值设定（每台机器人单写者，无等待） ============
+
+    // duration_ms 大于 0 时为运动段，持续 duration_ms 后自动停止
+    void setAxis(int robot, const AxisCommand& axis_cmd, uint32_t duration_ms = 0);
+    void setAxisValue(int robot, uint32_t axis_code, int32_t axis_value, uint32_t duration_ms = 0);
+    void stopAxis(int robot);
+
+    // ============ 状态读取（任意线程） ============
+
+    /** @brief 读取最新状态快照；与事件循环写入冲突时返回 false，可稍后重试 */
+    bool status(int robot, RobotStatus& out) const;
+
+    FleetStats stats() const;
+
+private:
+    struct Robot {
+        sockaddr_in addr;
+        AxisMailbox axis_mailbox;
+        Seqlock<RobotStatus> status_snapshot;
+
+        // 以下仅事件循环线程访问
+        RobotStatus status;
+        AxisStream axis_stream;   // 轴值设定、运动段与路线
+        TimerId  watchdog_timer;  // 状态看门狗，每收到一个状态包续期
+        MissionRunner mission;
+        TimerId  mission_timer;   // 任务等待的截止时间
+    };
+
+    enum RequestKind : uint32_t {
+        REQUEST_COMMAND       = 0,
+        REQUEST_MISSION       = 1,
+        REQUEST_ABORT_MISSION = 2,
+        REQUEST_TRAJECTORY    = 3
+    };
+
+    struct FleetRequest {
+        uint32_t       kind;   // RequestKind
+        int32_t        robot;
+        uint32_t       code;
+        int32_t        param;
+        const uint8_t* image;  // 非空时为预编码包
+        const Mission* mission;
+        const TrajectorySegment* trajectory;
+        size_t         trajectory_count;
+    };
+
+    // 任务通过它在事件循环线程中操作对应的机器人
+    class RobotMissionHost;
+
+    // 定时器 user_data: 机器人编号 * TIMER_KINDS + 定时器类型
+    enum TimerKind : uint64_t {
+        TIMER_HEARTBEAT   = 0,
+        TIMER_AXIS        = 1,
+        TIMER_SEGMENT_END = 2,
+        TIMER_WATCHDOG    = 3,
+        TIMER_MISSION     = 4,
+        TIMER_KINDS       = 5
+    };
+
+    bool validRobot(int robot) const { return robot >= 0 && static_cast<size_t>(robot) < robot_count_; }
+    bool pushRequest(int robot, uint32_t code, int32_t param, const uint8_t* image);
+    bool pushRequest(const FleetRequest& request);
+    bool openSocket();
+    void closeSocket();
+
+    void run();
+    void scheduleInitialTimers();
+    void onTimer(uint64_t user_data);
+    void handleDatagram(const ReceivedDatagram& datagram, int64_t recv_ns);
+    void drainRequests();
+    // 一次性指令；merge_axis_values 打开时单轴指令合并进轴值流
+    void submitCommand(int index, uint32_t code, int32_t param);
+    void resumeMission(int index);
+    // 任务状态或步骤变化时更新状态快照；任务结束时取消其定时器并计数
+    void updateMissionStatus(int index);
+    bool sendSimple(Robot& robot, uint32_t code, int32_t param);
+    void armWatchdog(int index);
+    // AxisStream 的发送回调
+    void sendAxis(const Robot& robot, const AxisSetpoint& setpoint, bool stop);
+    // 入队发往 robot 的数据包，本次循环迭代末由 flushSends() 发出
+    bool sendTo(const Robot& robot, const void* data, size_t len);
+    void flushSends();
+
+    FleetConfig config_;
+
+    Robot* robots_;  // 按缓存行对齐的定长数组，容量 max_robots
+    size_t robot_count_;
+    std::unordered_map<uint32_t, int> robot_by_ip_;  // 网络字节序 IPv4 -> 编号
+
+    SOCKET sock_;
+    BatchReceiver receiver_;
+    BatchSender sender_;
+    TimerWheel wheel_;
+    StatusDispatcher dispatcher_;
+    StatusHandler status_handler_;
+    int current_robot_;  // 正在分发状态的机器人（供 dispatcher_ 回调使用）
+
+    uint64_t heartbeat_ticks_;
+    uint64_t axis_ticks_;
+    uint64_t status_timeout_ticks_;
+
+    MpscQueue<FleetRequest, 1024> requests_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    std::atomic<uint64_t> loop_iterations_;
+    std::atomic<uint64_t> timers_fired_;
+    std::atomic<uint64_t> heartbeats_;
+    std::atomic<uint64_t> axis_packets_;
+    std::atomic<uint64_t> suppressed_axis_;
+    std::atomic<uint64_t> commands_;
+    std::atomic<uint64_t> send_errors_;
+    std::atomic<uint64_t> send_syscalls_;
+    std::atomic<uint64_t> status_packets_;
+    std::atomic<uint64_t> unknown_source_;
+    std::atomic<uint64_t> stale_status_;
+    std::atomic<uint64_t> queue_full_;
+    std::atomic<uint64_t> missions_completed_;
+    std::atomic<uint64_t> missions_failed_;
+    std::atomic<uint64_t> missions_aborted_;
+};
+
+} // namespace q25
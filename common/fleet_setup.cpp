@@ -0,0 +1,68 @@
+// ====================================================================
+//          Created:    2026/10/14/ 21:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file fleet_setup.cpp
+ * @brief 集群配置读取实现
+ */
+
+#include "fleet_setup.h"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace q25 {
+
+FleetConfig loadFleetConfig(const Config& config) {
+    FleetConfig fleet;
+    fleet.bind_ip = config.getString("fleet.bind_ip", fleet.bind_ip);
+    fleet.local_port = config.getInt("fleet.local_port", fleet.local_port);
+    fleet.max_robots = static_cast<size_t>(config.getInt("fleet.max_robots", static_cast<int>(fleet.max_robots)));
+    fleet.axis_rate_hz = config.getDouble("fleet.axis_rate_hz", fleet.axis_rate_hz);
+    fleet.tick_us = config.getInt("fleet.tick_us", fleet.tick_us);
+    fleet.axis_keepalive_ms = config.getInt("fleet.axis_keepalive_ms", fleet.axis_keepalive_ms);
+    fleet.merge_axis_values = config.getBool("fleet.merge_axis_values", fleet.merge_axis_values);
+    fleet.status_timeout_ms = config.getInt("fleet.status_timeout_ms", fleet.status_timeout_ms);
+    fleet.send_batch = static_cast<size_t>(config.getInt("fleet.send_batch", static_cast<int>(fleet.send_batch)));
+    fleet.busy_poll = config.getBool("fleet.busy_poll", fleet.busy_poll);
+    fleet.cpu_core = config.getInt("fleet.cpu_core", fleet.cpu_core);
+    fleet.realtime_priority = config.getBool("fleet.realtime", fleet.realtime_priority);
+    fleet.tuning.dscp = config.getInt("fleet.dscp", fleet.tuning.dscp);
+    fleet.tuning.recv_buffer_bytes = config.getInt("fleet.rcvbuf_bytes", fleet.tuning.recv_buffer_bytes);
+    return fleet;
+}
+
+std::vector<std::string> fleetRobotList(const Config& config) {
+    std::vector<std::string> robots;
+    std::stringstream list(config.getString("fleet.robots", DEFAULT_ROBOT_IP));
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        size_t begin = item.find_first_not_of(" \t");
+        size_t end = item.find_last_not_of(" \t");
+        if (begin != std::string::npos) {
+            robots.push_back(item.substr(begin, end - begin + 1));
+        }
+    }
+    return robots;
+}
+
+bool addRobots(FleetController& fleet, const std::vector<std::string>& robots) {
+    for (size_t i = 0; i < robots.size(); i++) {
+        std::string ip = robots[i];
+        int port = DEFAULT_ROBOT_PORT;
+        size_t colon = ip.find(':');
+        if (colon != std::string::npos) {
+            port = std::atoi(ip.c_str() + colon + 1);
+            ip = ip.substr(0, colon);
+        }
+        if (fleet.addRobot(ip.c_str(), port) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace q25
@@ -0,0 +1,39 @@
+// ====================================================================
+//          Created:    2026/10/14/ 21:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file fleet_setup.h
+ * @brief 从配置文件创建集群：FleetConfig 与机器人列表的读取、批量注册
+ *
+ * 配置项（均为可选，未配置时使用 FleetConfig 的默认值）:
+ *   fleet.bind_ip / fleet.local_port / fleet.max_robots / fleet.axis_rate_hz / fleet.tick_us
+ *   fleet.axis_keepalive_ms / fleet.status_timeout_ms / fleet.send_batch / fleet.busy_poll
+ *   fleet.merge_axis_values / fleet.cpu_core / fleet.realtime / fleet.dscp / fleet.rcvbuf_bytes
+ *   fleet.robots = 192.168.3.20, 192.168.3.21:43893, ...   （端口缺省为 DEFAULT_ROBOT_PORT）
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "fleet_controller.h"
+
+namespace q25 {
+
+FleetConfig loadFleetConfig(const Config& config);
+
+// fleet.robots 中的机器人地址（"ip" 或 "ip:port"），未配置时只有 DEFAULT_ROBOT_IP
+std::vector<std::string> fleetRobotList(const Config& config);
+
+/**
+ * @brief 按顺序注册全部机器人，第 i 个地址对应机器人编号 i
+ * @return 任一机器人注册失败时返回 false（错误信息由 addRobot() 输出）
+ */
+bool addRobots(FleetController& fleet, const std::vector<std::string>& robots);
+
+} // namespace q25
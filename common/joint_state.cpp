@@ -0,0 +1,320 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file joint_state.cpp
+ * @brief JointState 实现与 SIMD 内核
+ */
+
+#include "joint_state.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "cache_line.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define Q25_JOINT_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define Q25_JOINT_SSE2 1
+#endif
+
+namespace q25 {
+
+namespace {
+
+static_assert(MAX_JOINTS % JOINT_SIMD_WIDTH == 0, "MAX_JOINTS must be a multiple of the SIMD width");
+static_assert(MAX_JOINTS <= 64, "joint masks are 64-bit");
+
+size_t padTo(size_t n) {
+    return (n + JOINT_SIMD_WIDTH - 1) / JOINT_SIMD_WIDTH * JOINT_SIMD_WIDTH;
+}
+
+uint64_t validMask(size_t n) {
+    return n >= 64 ? ~0ULL : ((1ULL << n) - 1);
+}
+
+struct Reduction {
+    float min;
+    float max;
+    float sum;
+    float sum_sq;
+};
+
+// ============ 内核 ============
+// data 按缓存行对齐，padded 为 JOINT_SIMD_WIDTH 的整数倍且 > 0
+
+#if defined(Q25_JOINT_AVX2)
+
+float hmin(__m256 v) {
+    __m128 m = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+float hmax(__m256 v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+float hsum(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+__m256 abs8(__m256 v) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+}
+
+Reduction reduce(const float* data, size_t padded) {
+    __m256 vmin = _mm256_load_ps(data);
+    __m256 vmax = vmin;
+    __m256 vsum = _mm256_setzero_ps();
+    __m256 vsq = _mm256_setzero_ps();
+    for (size_t i = 0; i < padded; i += 8) {
+        __m256 v = _mm256_load_ps(data + i);
+        vmin = _mm256_min_ps(vmin, v);
+        vmax = _mm256_max_ps(vmax, v);
+        vsum = _mm256_add_ps(vsum, v);
+        vsq = _mm256_add_ps(vsq, _mm256_mul_ps(v, v));
+    }
+    Reduction r = { hmin(vmin), hmax(vmax), hsum(vsum), hsum(vsq) };
+    return r;
+}
+
+float reduceMaxAbs(const float* data, size_t padded) {
+    __m256 vmax = _mm256_setzero_ps();
+    for (size_t i = 0; i < padded; i += 8) {
+        vmax = _mm256_max_ps(vmax, abs8(_mm256_load_ps(data + i)));
+    }
+    return hmax(vmax);
+}
+
+uint64_t compareAbs(const float* data, size_t padded, float limit) {
+    __m256 vlimit = _mm256_set1_ps(limit);
+    uint64_t mask = 0;
+    for (size_t i = 0; i < padded; i += 8) {
+        __m256 gt = _mm256_cmp_ps(abs8(_mm256_load_ps(data + i)), vlimit, _CMP_GT_OQ);
+        mask |= static_cast<uint64_t>(_mm256_movemask_ps(gt)) << i;
+    }
+    return mask;
+}
+
+#elif defined(Q25_JOINT_SSE2)
+
+float hmin(__m128 m) {
+    m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+float hmax(__m128 m) {
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+float hsum(__m128 s) {
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+__m128 abs4(__m128 v) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+Reduction reduce(const float* data, size_t padded) {
+    __m128 vmin = _mm_load_ps(data);
+    __m128 vmax = vmin;
+    __m128 vsum = _mm_setzero_ps();
+    __m128 vsq = _mm_setzero_ps();
+    for (size_t i = 0; i < padded; i += 4) {
+        __m128 v = _mm_load_ps(data + i);
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+        vsum = _mm_add_ps(vsum, v);
+        vsq = _mm_add_ps(vsq, _mm_mul_ps(v, v));
+    }
+    Reduction r = { hmin(vmin), hmax(vmax), hsum(vsum), hsum(vsq) };
+    return r;
+}
+
+float reduceMaxAbs(const float* data, size_t padded) {
+    __m128 vmax = _mm_setzero_ps();
+    for (size_t i = 0; i < padded; i += 4) {
+        vmax = _mm_max_ps(vmax, abs4(_mm_load_ps(data + i)));
+    }
+    return hmax(vmax);
+}
+
+uint64_t compareAbs(const float* data, size_t padded, float limit) {
+    __m128 vlimit = _mm_set1_ps(limit);
+    uint64_t mask = 0;
+    for (size_t i = 0; i < padded; i += 4) {
+        __m128 gt = _mm_cmpgt_ps(abs4(_mm_load_ps(data + i)), vlimit);
+        mask |= static_cast<uint64_t>(_mm_movemask_ps(gt)) << i;
+    }
+    return mask;
+}
+
+#else
+
+Reduction reduce(const float* data, size_t padded) {
+    Reduction r = { data[0], data[0], 0.0f, 0.0f };
+    for (size_t i = 0; i < padded; i++) {
+        float v = data[i];
+        if (v < r.min) r.min = v;
+        if (v > r.max) r.max = v;
+        r.sum += v;
+        r.sum_sq += v * v;
+    }
+    return r;
+}
+
+float reduceMaxAbs(const float* data, size_t padded) {
+    float result = 0.0f;
+    for (size_t i = 0; i < padded; i++) {
+        float v = std::fabs(data[i]);
+        if (v > result) result = v;
+    }
+    return result;
+}
+
+uint64_t compareAbs(const float* data, size_t padded, float limit) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < padded; i++) {
+        if (std::fabs(data[i]) > limit) {
+            mask |= 1ULL << i;
+        }
+    }
+    return mask;
+}
+
+#endif
+
+} // namespace
+
+JointState::JointState()
+    : size_(0)
+    , padded_(0)
+    , timestamp_(0) {
+    storage_ = static_cast<float*>(alignedAlloc(sizeof(float) * MAX_JOINTS * JOINT_FIELD_COUNT, CACHE_LINE_SIZE));
+    if (storage_ != nullptr) {
+        memset(storage_, 0, sizeof(float) * MAX_JOINTS * JOINT_FIELD_COUNT);
+    }
+    for (int f = 0; f < JOINT_FIELD_COUNT; f++) {
+        fields_[f] = storage_ != nullptr ? storage_ + f * MAX_JOINTS : nullptr;
+    }
+}
+
+JointState::~JointState() {
+    alignedFree(storage_);
+}
+
+void JointState::update(JointSpan joints, uint64_t timestamp) {
+    if (storage_ == nullptr) {
+        return;
+    }
+    size_t n = joints.size < MAX_JOINTS ? joints.size : MAX_JOINTS;
+    const float* src = reinterpret_cast<const float*>(joints.data);
+    float* pos = fields_[JOINT_POSITION];
+    float* vel = fields_[JOINT_VELOCITY];
+    float* tor = fields_[JOINT_TORQUE];
+    float* tmp = fields_[JOINT_TEMPERATURE];
+
+    size_t i = 0;
+#if defined(Q25_JOINT_SSE2) || defined(Q25_JOINT_AVX2)
+    // 每次 4 个关节做 4x4 转置；源数据来自压缩结构体的接收缓冲区，使用非对齐读取
+    for (; i + 4 <= n; i += 4) {
+        __m128 r0 = _mm_loadu_ps(src + i * 4);
+        __m128 r1 = _mm_loadu_ps(src + i * 4 + 4);
+        __m128 r2 = _mm_loadu_ps(src + i * 4 + 8);
+        __m128 r3 = _mm_loadu_ps(src + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_store_ps(pos + i, r0);
+        _mm_store_ps(vel + i, r1);
+        _mm_store_ps(tor + i, r2);
+        _mm_store_ps(tmp + i, r3);
+    }
+#endif
+    for (; i < n; i++) {
+        pos[i] = src[i * 4];
+        vel[i] = src[i * 4 + 1];
+        tor[i] = src[i * 4 + 2];
+        tmp[i] = src[i * 4 + 3];
+    }
+
+    // 填充位置复制关节 0，使整向量的 min/max 不受影响
+    size_t padded = padTo(n);
+    for (int f = 0; f < JOINT_FIELD_COUNT; f++) {
+        float* data = fields_[f];
+        float fill = n > 0 ? data[0] : 0.0f;
+        for (size_t j = n; j < padded; j++) {
+            data[j] = fill;
+        }
+    }
+
+    size_ = n;
+    padded_ = padded;
+    timestamp_ = timestamp;
+}
+
+JointFieldStats JointState::stats(JointField f) const {
+    JointFieldStats result = { 0.0f, 0.0f, 0.0f, 0.0f };
+    if (size_ == 0) {
+        return result;
+    }
+    const float* data = fields_[f];
+    Reduction r = reduce(data, padded_);
+
+    // 扣除填充部分（关节 0 的副本）对求和的贡献
+    float pad = static_cast<float>(padded_ - size_);
+    float sum = r.sum - pad * data[0];
+    float sum_sq = r.sum_sq - pad * data[0] * data[0];
+    float n = static_cast<float>(size_);
+
+    result.min = r.min;
+    result.max = r.max;
+    result.mean = sum / n;
+    result.rms = std::sqrt(sum_sq > 0.0f ? sum_sq / n : 0.0f);
+    return result;
+}
+
+float JointState::maxAbs(JointField f) const {
+    if (size_ == 0) {
+        return 0.0f;
+    }
+    return reduceMaxAbs(fields_[f], padded_);
+}
+
+uint64_t JointState::exceedsAbs(JointField f, float limit) const {
+    if (size_ == 0) {
+        return 0;
+    }
+    return compareAbs(fields_[f], padded_, limit) & validMask(size_);
+}
+
+JointHealth JointState::check(const JointLimits& limits) const {
+    JointHealth health;
+    health.max_temperature = stats(JOINT_TEMPERATURE).max;
+    health.torque_rms = stats(JOINT_TORQUE).rms;
+    health.max_abs_velocity = maxAbs(JOINT_VELOCITY);
+    health.over_velocity = limits.max_abs_velocity > 0.0f ? exceedsAbs(JOINT_VELOCITY, limits.max_abs_velocity) : 0;
+    health.over_torque = limits.max_abs_torque > 0.0f ? exceedsAbs(JOINT_TORQUE, limits.max_abs_torque) : 0;
+    health.over_temperature = limits.max_temperature > 0.0f ? exceedsAbs(JOINT_TEMPERATURE, limits.max_temperature) : 0;
+    return health;
+}
+
+} // namespace q25
@@ -0,0 +1,123 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file joint_state.h
+ * @brief 结构体数组 (SoA) 关节状态与 SIMD 归约
+ *
+ * 数据包中的关节数据是 JointData{position, velocity, torque, temperature}
+ * 数组 (AoS)。健康监测每包都要对全部关节求最大温度、力矩 RMS、速度超限等，
+ * 按字段连续存放后可以整向量处理:
+ *
+ *   positions[]    | p0 p1 p2 ... pN-1 | 填充 |
+ *   velocities[]   | v0 v1 v2 ... vN-1 | 填充 |
+ *   torques[]      | ...
+ *   temperatures[] | ...
+ *
+ * 每个字段数组按缓存行对齐，长度填充到 SIMD 宽度 (8 个 float) 的整数倍。
+ * 填充位置复制第 0 个关节的值，对 min/max 不产生影响；求和类归约
+ * 单独扣除填充部分，阈值检查的结果掩码只保留有效关节，因此内核无需处理尾部。
+ *
+ * 指令集在编译期选择: 定义了 __AVX2__ (CMake 选项 Q25_ENABLE_AVX2) 时使用 AVX2，
+ * 否则 x86/x64 上使用 SSE2，其他平台回退为标量实现。
+ *
+ * update() 在处理线程中原地更新，非线程安全。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "status_protocol.h"
+
+namespace q25 {
+
+// 关节数上限（超限掩码使用 64 位）
+constexpr size_t MAX_JOINTS = 64;
+// SIMD 宽度（float 个数），字段数组长度按此填充
+constexpr size_t JOINT_SIMD_WIDTH = 8;
+
+enum JointField {
+    JOINT_POSITION,
+    JOINT_VELOCITY,
+    JOINT_TORQUE,
+    JOINT_TEMPERATURE,
+    JOINT_FIELD_COUNT
+};
+
+struct JointFieldStats {
+    float min;
+    float max;
+    float mean;
+    float rms;
+};
+
+// 健康检查阈值，均按绝对值比较；<= 0 表示不检查
+struct JointLimits {
+    float max_abs_velocity;  // rad/s
+    float max_abs_torque;    // Nm
+    float max_temperature;   // ℃
+
+    JointLimits()
+        : max_abs_velocity(0.0f)
+        , max_abs_torque(0.0f)
+        , max_temperature(0.0f) {}
+};
+
+struct JointHealth {
+    float max_temperature;
+    float torque_rms;
+    float max_abs_velocity;
+    uint64_t over_velocity;     // 第 i 位表示关节 i 超限
+    uint64_t over_torque;
+    uint64_t over_temperature;
+
+    bool ok() const { return (over_velocity | over_torque | over_temperature) == 0; }
+};
+
+class JointState {
+public:
+    JointState();
+    ~JointState();
+
+    JointState(const JointState&) = delete;
+    JointState& operator=(const JointState&) = delete;
+
+    /** @brief 从数据包更新（AoS 转置为 SoA），超过 MAX_JOINTS 的关节被忽略 */
+    void update(JointSpan joints, uint64_t timestamp);
+
+    size_t size() const { return size_; }
+    uint64_t timestamp() const { return timestamp_; }
+
+    // 字段数组，长度为 size()（其后有填充）
+    const float* field(JointField f) const { return fields_[f]; }
+    const float* positions() const { return fields_[JOINT_POSITION]; }
+    const float* velocities() const { return fields_[JOINT_VELOCITY]; }
+    const float* torques() const { return fields_[JOINT_TORQUE]; }
+    const float* temperatures() const { return fields_[JOINT_TEMPERATURE]; }
+
+    /** @brief 一次遍历求 min / max / mean / RMS，无关节时全为 0 */
+    JointFieldStats stats(JointField f) const;
+
+    /** @brief 最大绝对值 */
+    float maxAbs(JointField f) const;
+
+    /** @brief |x| > limit 的关节掩码 */
+    uint64_t exceedsAbs(JointField f, float limit) const;
+
+    /** @brief 健康监测常用的一组检查 */
+    JointHealth check(const JointLimits& limits) const;
+
+private:
+    size_t size_;
+    size_t padded_;          // 填充后的长度（SIMD 宽度的整数倍）
+    uint64_t timestamp_;
+    float* storage_;
+    float* fields_[JOINT_FIELD_COUNT];
+};
+
+} // namespace q25
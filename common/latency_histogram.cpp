@@ -0,0 +1,115 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file latency_histogram.cpp
+ * @brief LatencyHistogram 实现
+ */
+
+#include "latency_histogram.h"
+
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace q25 {
+
+namespace {
+
+// 最高有效位的位置，value 必须非 0
+int highestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+} // namespace
+
+constexpr int LatencyHistogram::SUB_BUCKET_BITS;
+constexpr size_t LatencyHistogram::SUB_BUCKET_COUNT;
+constexpr size_t LatencyHistogram::BUCKET_COUNT;
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(BUCKET_COUNT, 0)
+    , count_(0)
+    , sum_(0)
+    , min_(std::numeric_limits<uint64_t>::max())
+    , max_(0) {}
+
+// 小于 32 的值每个值一个桶；之后的每个 2 的幂区间 [2^k, 2^(k+1)) 均分为 32 个桶
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    int shift = highestBit(value) - SUB_BUCKET_BITS;
+    size_t sub = static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT;
+    return (static_cast<size_t>(shift) + 1) * SUB_BUCKET_COUNT + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = static_cast<int>(index / SUB_BUCKET_COUNT) - 1;
+    uint64_t sub = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    counts_[bucketIndex(value)]++;
+    count_++;
+    sum_ += value;
+    if (value < min_) min_ = value;
+    if (value > max_) max_ = value;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    if (other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+}
+
+void LatencyHistogram::reset() {
+    counts_.assign(BUCKET_COUNT, 0);
+    count_ = 0;
+    sum_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    if (percent < 0.0) percent = 0.0;
+    if (percent > 100.0) percent = 100.0;
+
+    // 第 rank 个样本（从 1 开始）所在的桶
+    uint64_t rank = static_cast<uint64_t>(percent / 100.0 * static_cast<double>(count_) + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            uint64_t upper = bucketUpperBound(i);
+            return upper < max_ ? upper : max_;
+        }
+    }
+    return max_;
+}
+
+} // namespace q25
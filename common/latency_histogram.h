@@ -0,0 +1,61 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file latency_histogram.h
+ * @brief 对数-线性分桶的延迟直方图 (HDR Histogram 风格)
+ *
+ * 每个 2 的幂区间再线性细分为 32 个子桶，任意取值的相对误差不超过 1/32 (~3%)，
+ * 覆盖 0 ~ 2^64 全部范围。桶数组在构造时一次性分配，record() 只做位运算与计数，
+ * 可在接收/处理热路径中调用。
+ *
+ * 单位由调用方决定（通常为纳秒或微秒）。非线程安全，跨线程汇总请用 merge()。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace q25 {
+
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ > 0 ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ > 0 ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    /**
+     * @brief 百分位数
+     * @param percent 0 ~ 100，例如 99.9
+     * @return 该百分位所在桶的上界（不超过记录到的最大值），无数据时返回 0
+     */
+    uint64_t percentile(double percent) const;
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKET_COUNT = static_cast<size_t>(1) << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+} // namespace q25
@@ -0,0 +1,269 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file mapped_file.cpp
+ * @brief MappedFile 实现
+ */
+
+#include "mapped_file.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace q25 {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : data_(nullptr)
+    , size_(0)
+    , writable_(false)
+    , file_handle_(INVALID_HANDLE_VALUE)
+    , mapping_handle_(nullptr) {}
+
+bool MappedFile::create(const std::string& path, size_t size) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[ERROR] Failed to create " << path << ", error: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    // 创建映射时按 size 扩展文件，即预分配
+    LARGE_INTEGER map_size;
+    map_size.QuadPart = static_cast<LONGLONG>(size);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, map_size.HighPart,
+                                        map_size.LowPart, nullptr);
+    if (mapping == nullptr) {
+        std::cerr << "[ERROR] Failed to map " << path << ", error: " << GetLastError() << std::endl;
+        CloseHandle(file);
+        DeleteFileA(path.c_str());
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (view == nullptr) {
+        std::cerr << "[ERROR] Failed to map view of " << path << ", error: " << GetLastError() << std::endl;
+        CloseHandle(mapping);
+        CloseHandle(file);
+        DeleteFileA(path.c_str());
+        return false;
+    }
+
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<uint8_t*>(view);
+    size_ = size;
+    writable_ = true;
+    path_ = path;
+    return true;
+}
+
+bool MappedFile::openReadOnly(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[ERROR] Failed to open " << path << ", error: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        std::cerr << "[ERROR] Empty or unreadable file: " << path << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        std::cerr << "[ERROR] Failed to map " << path << ", error: " << GetLastError() << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        std::cerr << "[ERROR] Failed to map view of " << path << ", error: " << GetLastError() << std::endl;
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<uint8_t*>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    writable_ = false;
+    path_ = path;
+    return true;
+}
+
+bool MappedFile::flush(size_t offset, size_t len) {
+    if (data_ == nullptr || !writable_) {
+        return false;
+    }
+    if (!FlushViewOfFile(data_ + offset, len)) {
+        std::cerr << "[WARNING] Failed to flush " << path_ << ", error: " << GetLastError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close(size_t final_size) {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+    if (mapping_handle_ != nullptr) {
+        CloseHandle(mapping_handle_);
+        mapping_handle_ = nullptr;
+    }
+    if (file_handle_ != INVALID_HANDLE_VALUE) {
+        // 映射关闭后才能截断
+        if (writable_ && final_size > 0 && final_size < size_) {
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(final_size);
+            if (!SetFilePointerEx(file_handle_, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file_handle_)) {
+                std::cerr << "[WARNING] Failed to truncate " << path_ << ", error: " << GetLastError() << std::endl;
+            }
+        }
+        CloseHandle(file_handle_);
+        file_handle_ = INVALID_HANDLE_VALUE;
+    }
+    size_ = 0;
+    writable_ = false;
+}
+
+#else
+
+MappedFile::MappedFile()
+    : data_(nullptr)
+    , size_(0)
+    , writable_(false)
+    , fd_(-1) {}
+
+bool MappedFile::create(const std::string& path, size_t size) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "[ERROR] Failed to create " << path << ", errno: " << errno << std::endl;
+        return false;
+    }
+    // 必须真正分配磁盘块：ftruncate 只产生稀疏文件，空间不足时经映射写入会触发 SIGBUS。
+    // 文件系统不支持 fallocate 时才退回 ftruncate
+    int rc = posix_fallocate(fd, 0, static_cast<off_t>(size));
+    if (rc == EOPNOTSUPP) {
+        rc = ftruncate(fd, static_cast<off_t>(size)) == 0 ? 0 : errno;
+    }
+    if (rc != 0) {
+        std::cerr << "[ERROR] Failed to preallocate " << size << " bytes for " << path << ", errno: " << rc
+                  << std::endl;
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        std::cerr << "[ERROR] Failed to map " << path << ", errno: " << errno << std::endl;
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    fd_ = fd;
+    data_ = static_cast<uint8_t*>(view);
+    size_ = size;
+    writable_ = true;
+    path_ = path;
+    return true;
+}
+
+bool MappedFile::openReadOnly(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[ERROR] Failed to open " << path << ", errno: " << errno << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        std::cerr << "[ERROR] Empty or unreadable file: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        std::cerr << "[ERROR] Failed to map " << path << ", errno: " << errno << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    data_ = static_cast<uint8_t*>(view);
+    size_ = size;
+    writable_ = false;
+    path_ = path;
+    return true;
+}
+
+bool MappedFile::flush(size_t offset, size_t len) {
+    if (data_ == nullptr || !writable_) {
+        return false;
+    }
+    // msync 要求起始地址按页对齐
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = offset & ~(page - 1);
+    if (msync(data_ + begin, len + (offset - begin), MS_SYNC) != 0) {
+        std::cerr << "[WARNING] Failed to flush " << path_ << ", errno: " << errno << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close(size_t final_size) {
+    if (data_ != nullptr) {
+        munmap(data_, size_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        if (writable_ && final_size > 0 && final_size < size_) {
+            if (ftruncate(fd_, static_cast<off_t>(final_size)) != 0) {
+                std::cerr << "[WARNING] Failed to truncate " << path_ << ", errno: " << errno << std::endl;
+            }
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+    writable_ = false;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+} // namespace q25
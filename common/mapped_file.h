@@ -0,0 +1,69 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file mapped_file.h
+ * @brief 内存映射文件 (Windows: CreateFileMapping / 其他平台: mmap)
+ *
+ * 写模式按指定大小预分配文件并整体映射，写入即内存拷贝，由系统异步回写磁盘；
+ * 读模式只读映射整个文件。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace q25 {
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief 创建（或覆盖）文件，预分配 size 字节并以读写方式映射
+     * @return 失败（含磁盘空间不足）时输出错误信息并返回 false
+     */
+    bool create(const std::string& path, size_t size);
+
+    /** @brief 以只读方式映射已有文件 */
+    bool openReadOnly(const std::string& path);
+
+    /** @brief 将 [offset, offset + len) 范围写回磁盘（同步） */
+    bool flush(size_t offset, size_t len);
+
+    /**
+     * @brief 解除映射并关闭文件
+     * @param final_size 写模式下将文件截断到该长度；为 0 时保持原大小
+     */
+    void close(size_t final_size = 0);
+
+    bool isOpen() const { return data_ != nullptr; }
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+private:
+    uint8_t* data_;
+    size_t size_;
+    bool writable_;
+    std::string path_;
+
+#ifdef _WIN32
+    void* file_handle_;
+    void* mapping_handle_;
+#else
+    int fd_;
+#endif
+};
+
+} // namespace q25
@@ -0,0 +1,558 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file mission.cpp
+ * @brief 任务脚本编译与 MissionRunner 实现
+ */
+
+#include "mission.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "motion_monitor.h"
+#include "q25_protocol.h"
+
+namespace q25 {
+
+namespace {
+
+struct NamedValue {
+    const char* name;
+    uint32_t value;
+};
+
+const NamedValue COMMAND_NAMES[] = {
+    { "stand_up",           CMD_STAND_UP },
+    { "lie_down",           CMD_LIE_DOWN },
+    { "emergency_stop",     CMD_EMERGENCY_STOP },
+    { "walk",               CMD_WALK_STATE },
+    { "run",                CMD_RUN_STATE },
+    { "manual_mode",        CMD_MANUAL_MODE },
+    { "navi_mode",          CMD_NAVI_MODE },
+    { "assistant_mode",     CMD_ASSISTANT_MODE },
+    { "change_height",      CMD_CHANGE_HEIGHT },
+    { "auto_charge",        CMD_AUTO_CHARGE_START },
+    { "power_driver_motor", CMD_POWER_DRIVER_MOTOR },
+    { "power_status",       CMD_POWER_STATUS },
+    { "power_upload",       CMD_POWER_UPLOAD },
+    { "power_lidar_fu",     CMD_POWER_LIDAR_FU },
+    { "power_lidar_fl",     CMD_POWER_LIDAR_FL },
+    { "power_lidar_bu",     CMD_POWER_LIDAR_BU },
+    { "power_lidar_bl",     CMD_POWER_LIDAR_BL },
+};
+
+const NamedValue PARAM_NAMES[] = {
+    { "low",    HEIGHT_LOW },
+    { "middle", HEIGHT_MIDDLE },
+    { "high",   HEIGHT_HIGH },
+    { "start",  CHARGE_START },
+    { "stop",   CHARGE_STOP },
+    { "off",    POWER_OFF },
+    { "on",     POWER_ON },
+};
+
+// 条件名；arg 表示条件后是否带参数（0 无，1 整数，2 米）
+struct ConditionName {
+    const char* name;
+    MissionCondition condition;
+    int arg;
+};
+
+const ConditionName CONDITION_NAMES[] = {
+    { "stand",          COND_STAND,          0 },
+    { "lie",            COND_LIE,            0 },
+    { "gait",           COND_GAIT,           1 },
+    { "gait_changed",   COND_GAIT_CHANGED,   0 },
+    { "mode",           COND_MODE,           1 },
+    { "mode_changed",   COND_MODE_CHANGED,   0 },
+    { "height_above",   COND_HEIGHT_ABOVE,   2 },
+    { "height_below",   COND_HEIGHT_BELOW,   2 },
+    { "height_changed", COND_HEIGHT_CHANGED, 2 },
+};
+
+const NamedValue PROFILE_NAMES[] = {
+    { "step",   RAMP_STEP },
+    { "linear", RAMP_LINEAR },
+    { "smooth", RAMP_SMOOTH },
+};
+
+template <size_t N>
+bool lookup(const NamedValue (&table)[N], const std::string& name, uint32_t& out) {
+    for (size_t i = 0; i < N; i++) {
+        if (name == table[i].name) {
+            out = table[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+const ConditionName* findCondition(const std::string& name) {
+    for (size_t i = 0; i < sizeof(CONDITION_NAMES) / sizeof(CONDITION_NAMES[0]); i++) {
+        if (name == CONDITION_NAMES[i].name) {
+            return &CONDITION_NAMES[i];
+        }
+    }
+    return nullptr;
+}
+
+const char* conditionName(uint32_t condition) {
+    for (size_t i = 0; i < sizeof(CONDITION_NAMES) / sizeof(CONDITION_NAMES[0]); i++) {
+        if (CONDITION_NAMES[i].condition == condition) {
+            return CONDITION_NAMES[i].name;
+        }
+    }
+    return "?";
+}
+
+bool parseInt(const std::string& text, long& out) {
+    char* end = nullptr;
+    out = strtol(text.c_str(), &end, 0);
+    return !text.empty() && *end == '\0';
+}
+
+bool parseFloat(const std::string& text, float& out) {
+    char* end = nullptr;
+    out = strtof(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+bool parseMs(const std::string& text, uint32_t& out) {
+    long value = 0;
+    if (!parseInt(text, value) || value < 0) {
+        return false;
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+bool parseAxis(const std::string& text, int32_t& out) {
+    long value = 0;
+    if (!parseInt(text, value) || value < -1000 || value > 1000) {
+        return false;
+    }
+    out = static_cast<int32_t>(value);
+    return true;
+}
+
+MissionStep makeStep(MissionOp op, uint32_t line) {
+    MissionStep step;
+    memset(&step, 0, sizeof(step));
+    step.op = op;
+    step.line = line;
+    return step;
+}
+
+// 编译一行；出错时返回 false 并给出原因
+bool compileLine(const std::vector<std::string>& tokens, const std::string& line_text, uint32_t line,
+                 Mission& out, std::vector<size_t>& repeats, bool& in_route, std::string& error) {
+    const std::string& op = tokens[0];
+    size_t argc = tokens.size() - 1;
+
+    if (op == "move") {
+        TrajectorySegment segment;
+        memset(&segment, 0, sizeof(segment));
+        segment.profile = RAMP_SMOOTH;
+        if (argc < 5 || argc > 7 ||
+            !parseMs(tokens[1], segment.duration_ms) ||
+            !parseAxis(tokens[2], segment.left_x) || !parseAxis(tokens[3], segment.left_y) ||
+            !parseAxis(tokens[4], segment.right_x) || !parseAxis(tokens[5], segment.right_y) ||
+            (argc >= 6 && !parseMs(tokens[6], segment.ramp_ms)) ||
+            (argc == 7 && !lookup(PROFILE_NAMES, tokens[7], segment.profile))) {
+            error = "usage: move <ms> <lx> <ly> <rx> <ry> [ramp_ms [step|linear|smooth]], axis in [-1000, 1000]";
+            return false;
+        }
+        if (!in_route) {
+            MissionStep step = makeStep(OP_TRAJECTORY, line);
+            step.arg = static_cast<uint32_t>(out.segments.size());
+            out.steps.push_back(step);
+            in_route = true;
+        }
+        out.segments.push_back(segment);
+        out.steps.back().param++;
+        return true;
+    }
+    in_route = false;
+
+    if (op == "send") {
+        MissionStep step = makeStep(OP_SEND, line);
+        long value = 0;
+        if (argc < 1 || argc > 2) {
+            error = "usage: send <command> [param]";
+            return false;
+        }
+        if (!lookup(COMMAND_NAMES, tokens[1], step.arg)) {
+            if (!parseInt(tokens[1], value)) {
+                error = "unknown command '" + tokens[1] + "'";
+                return false;
+            }
+            step.arg = static_cast<uint32_t>(value);
+        }
+        if (argc == 2) {
+            uint32_t named = 0;
+            if (lookup(PARAM_NAMES, tokens[2], named)) {
+                step.param = static_cast<int32_t>(named);
+            } else if (parseInt(tokens[2], value)) {
+                step.param = static_cast<int32_t>(value);
+            } else {
+                error = "invalid param '" + tokens[2] + "'";
+                return false;
+            }
+        }
+        out.steps.push_back(step);
+        return true;
+    }
+
+    if (op == "wait") {
+        MissionStep step = makeStep(OP_WAIT, line);
+        if (argc != 1 || !parseMs(tokens[1], step.time_ms)) {
+            error = "usage: wait <ms>";
+            return false;
+        }
+        out.steps.push_back(step);
+        return true;
+    }
+
+    if (op == "await") {
+        MissionStep step = makeStep(OP_AWAIT, line);
+        const ConditionName* condition = argc >= 1 ? findCondition(tokens[1]) : nullptr;
+        if (condition == nullptr) {
+            error = argc >= 1 ? "unknown condition '" + tokens[1] + "'" : "usage: await <condition> [arg] <timeout_ms> [required]";
+            return false;
+        }
+        step.arg = condition->condition;
+        size_t next = 2;
+        if (condition->arg == 1) {
+            long value = 0;
+            if (argc < next || !parseInt(tokens[next], value)) {
+                error = std::string("usage: await ") + condition->name + " <n> <timeout_ms> [required]";
+                return false;
+            }
+            step.param = static_cast<int32_t>(value);
+            next++;
+        } else if (condition->arg == 2) {
+            if (argc < next || !parseFloat(tokens[next], step.value)) {
+                error = std::string("usage: await ") + condition->name + " <meters> <timeout_ms> [required]";
+                return false;
+            }
+            next++;
+        }
+        if (argc < next || !parseMs(tokens[next], step.time_ms)) {
+            error = "missing timeout_ms";
+            return false;
+        }
+        next++;
+        if (argc == next && tokens[next] == "required") {
+            step.required = 1;
+            next++;
+        }
+        if (argc >= next) {
+            error = "unexpected '" + tokens[next] + "'";
+            return false;
+        }
+        out.steps.push_back(step);
+        return true;
+    }
+
+    if (op == "stop") {
+        if (argc != 0) {
+            error = "usage: stop";
+            return false;
+        }
+        out.steps.push_back(makeStep(OP_STOP_AXIS, line));
+        return true;
+    }
+
+    if (op == "repeat") {
+        MissionStep step = makeStep(OP_REPEAT, line);
+        long count = 0;
+        if (argc != 1 || !parseInt(tokens[1], count) || count < 0) {
+            error = "usage: repeat <n>";
+            return false;
+        }
+        if (repeats.size() >= MissionRunner::MAX_REPEAT_DEPTH) {
+            error = "repeat nested too deeply";
+            return false;
+        }
+        step.arg = static_cast<uint32_t>(count);
+        repeats.push_back(out.steps.size());
+        out.steps.push_back(step);
+        return true;
+    }
+
+    if (op == "end") {
+        if (argc != 0 || repeats.empty()) {
+            error = repeats.empty() ? "end without repeat" : "usage: end";
+            return false;
+        }
+        size_t repeat = repeats.back();
+        repeats.pop_back();
+        MissionStep step = makeStep(OP_END_REPEAT, line);
+        step.arg = static_cast<uint32_t>(repeat + 1);
+        // repeat 0 直接跳过循环体
+        out.steps[repeat].param = static_cast<int32_t>(out.steps.size());
+        out.steps.push_back(step);
+        return true;
+    }
+
+    if (op == "log") {
+        MissionStep step = makeStep(OP_LOG, line);
+        size_t begin = line_text.find("log") + 3;
+        begin = line_text.find_first_not_of(" \t", begin);
+        step.arg = static_cast<uint32_t>(out.texts.size());
+        out.texts.push_back(begin != std::string::npos ? line_text.substr(begin) : std::string());
+        out.steps.push_back(step);
+        return true;
+    }
+
+    error = "unknown instruction '" + op + "'";
+    return false;
+}
+
+} // namespace
+
+// ============ 编译 ============
+
+bool compileMission(const std::string& source, const std::string& name, Mission& out) {
+    out.name = name;
+    out.steps.clear();
+    out.segments.clear();
+    out.texts.clear();
+
+    std::vector<size_t> repeats;  // 尚未闭合的 repeat 步骤下标
+    bool in_route = false;
+    bool ok = true;
+
+    std::istringstream input(source);
+    std::string line;
+    uint32_t line_no = 0;
+    while (std::getline(input, line)) {
+        line_no++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        size_t last = line.find_last_not_of(" \t\r\n");
+        line.erase(last == std::string::npos ? 0 : last + 1);
+
+        std::istringstream words(line);
+        std::vector<std::string> tokens;
+        std::string token;
+        while (words >> token) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+
+        std::string error;
+        if (!compileLine(tokens, line, line_no, out, repeats, in_route, error)) {
+            std::cerr << "[ERROR] " << name << ":" << line_no << ": " << error << std::endl;
+            ok = false;
+        }
+    }
+
+    if (!repeats.empty()) {
+        std::cerr << "[ERROR] " << name << ":" << out.steps[repeats.back()].line
+                  << ": repeat without end" << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+bool loadMission(const std::string& path, Mission& out) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        std::cerr << "[ERROR] Cannot open mission file: " << path << std::endl;
+        return false;
+    }
+    std::stringstream source;
+    source << file.rdbuf();
+
+    std::string name = path;
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) {
+        name.erase(0, slash + 1);
+    }
+    size_t dot = name.rfind('.');
+    if (dot != std::string::npos && dot > 0) {
+        name.erase(dot);
+    }
+    return compileMission(source.str(), name, out);
+}
+
+bool missionConditionMet(const MissionStep& step, const MotionData& motion, const MotionData& before) {
+    switch (step.arg) {
+    case COND_STAND:          return motion.body_height > STAND_BODY_HEIGHT_M;
+    case COND_LIE:            return motion.body_height < LIE_BODY_HEIGHT_M;
+    case COND_GAIT:           return motion.gait == static_cast<uint32_t>(step.param);
+    case COND_GAIT_CHANGED:   return motion.gait != before.gait;
+    case COND_MODE:           return motion.motion_mode == static_cast<uint32_t>(step.param);
+    case COND_MODE_CHANGED:   return motion.motion_mode != before.motion_mode;
+    case COND_HEIGHT_ABOVE:   return motion.body_height > step.value;
+    case COND_HEIGHT_BELOW:   return motion.body_height < step.value;
+    case COND_HEIGHT_CHANGED: return std::fabs(motion.body_height - before.body_height) > step.value;
+    default:                  return false;
+    }
+}
+
+// ============ MissionRunner ============
+
+MissionRunner::MissionRunner()
+    : mission_(nullptr)
+    , robot_(-1)
+    , state_(MISSION_IDLE)
+    , wait_(MISSION_WAIT_NONE)
+    , pc_(0)
+    , step_started_(false)
+    , started_ms_(0)
+    , deadline_ms_(0)
+    , has_before_(false)
+    , repeat_depth_(0) {
+    memset(&before_, 0, sizeof(before_));
+    memset(repeat_left_, 0, sizeof(repeat_left_));
+}
+
+void MissionRunner::start(const Mission* mission, int robot) {
+    mission_ = mission;
+    robot_ = robot;
+    state_ = mission != nullptr ? MISSION_RUNNING : MISSION_IDLE;
+    wait_ = MISSION_WAIT_NONE;
+    pc_ = 0;
+    step_started_ = false;
+    deadline_ms_ = 0;
+    has_before_ = false;
+    repeat_depth_ = 0;
+}
+
+void MissionRunner::abort() {
+    if (state_ == MISSION_RUNNING) {
+        finish(MISSION_ABORTED);
+    }
+}
+
+void MissionRunner::finish(MissionState state) {
+    state_ = state;
+    wait_ = MISSION_WAIT_NONE;
+    step_started_ = false;
+}
+
+MissionWait MissionRunner::resume(MissionHost& host, uint64_t now_ms) {
+    if (state_ != MISSION_RUNNING) {
+        return MISSION_WAIT_NONE;
+    }
+
+    const std::vector<MissionStep>& steps = mission_->steps;
+    for (size_t executed = 0; executed < MAX_STEPS_PER_RESUME; executed++) {
+        if (pc_ >= steps.size()) {
+            finish(MISSION_DONE);
+            return MISSION_WAIT_NONE;
+        }
+
+        const MissionStep& step = steps[pc_];
+        switch (step.op) {
+        case OP_SEND:
+            has_before_ = host.latestMotion(before_);
+            host.sendCommand(step.arg, step.param);
+            break;
+
+        case OP_WAIT:
+            if (!step_started_) {
+                step_started_ = true;
+                started_ms_ = now_ms;
+                deadline_ms_ = now_ms + step.time_ms;
+            }
+            if (now_ms < deadline_ms_) {
+                return wait_ = MISSION_WAIT_TIME;
+            }
+            break;
+
+        case OP_AWAIT: {
+            if (!step_started_) {
+                step_started_ = true;
+                started_ms_ = now_ms;
+                deadline_ms_ = now_ms + step.time_ms;
+            }
+            MotionData motion;
+            if (host.latestMotion(motion)) {
+                // 之前没有发过指令（或当时还没有状态）时，以等待期间收到的第一份状态为比较基准
+                if (!has_before_) {
+                    before_ = motion;
+                    has_before_ = true;
+                }
+                if (missionConditionMet(step, motion, before_)) {
+                    std::cout << "[INFO] Robot " << robot_ << " " << mission_->name << ":" << step.line
+                              << ": " << conditionName(step.arg) << " reached after "
+                              << (now_ms - started_ms_) << " ms" << std::endl;
+                    break;
+                }
+            }
+            if (now_ms < deadline_ms_) {
+                return wait_ = MISSION_WAIT_MOTION;
+            }
+            std::cout << "[WARNING] Robot " << robot_ << " " << mission_->name << ":" << step.line
+                      << ": " << conditionName(step.arg) << " not reported within "
+                      << step.time_ms << " ms" << std::endl;
+            if (step.required) {
+                finish(MISSION_FAILED);
+                return MISSION_WAIT_NONE;
+            }
+            break;
+        }
+
+        case OP_TRAJECTORY:
+            if (!step_started_) {
+                step_started_ = true;
+                host.playTrajectory(&mission_->segments[step.arg], static_cast<size_t>(step.param));
+            }
+            if (host.trajectoryActive()) {
+                return wait_ = MISSION_WAIT_TRAJECTORY;
+            }
+            break;
+
+        case OP_STOP_AXIS:
+            host.stopAxis();
+            break;
+
+        case OP_REPEAT:
+            if (step.arg == 0) {
+                pc_ = static_cast<size_t>(step.param);  // 跳到 end，下面的 pc_++ 跳过它
+            } else {
+                repeat_left_[repeat_depth_++] = step.arg;
+            }
+            break;
+
+        case OP_END_REPEAT:
+            if (--repeat_left_[repeat_depth_ - 1] > 0) {
+                pc_ = step.arg;
+                continue;
+            }
+            repeat_depth_--;
+            break;
+
+        case OP_LOG:
+            std::cout << "[INFO] Robot " << robot_ << " " << mission_->name << ": "
+                      << mission_->texts[step.arg] << std::endl;
+            break;
+
+        default:
+            break;
+        }
+
+        pc_++;
+        step_started_ = false;
+    }
+
+    return wait_ = MISSION_WAIT_YIELD;
+}
+
+} // namespace q25
@@ -0,0 +1,185 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file mission.h
+ * @brief 任务脚本：启动时编译为扁平的步骤数组，由事件循环非阻塞解释执行
+ *
+ * 站立、步态切换、高度调节、充电等固定流程写成任务文件，而不是每个流程一个 main():
+ *
+ *     # stand_lie.mission
+ *     send stand_up
+ *     await stand 15000
+ *     wait 2000
+ *     send lie_down
+ *     await lie 10000
+ *
+ * 指令（每行一条，# 之后为注释）:
+ *   send <指令名|0x指令码> [参数]        发送一次性指令，参数可写 low/middle/high、start/stop、on/off
+ *   wait <ms>                          等待固定时间
+ *   await <条件> [参数] <超时ms> [required]
+ *                                      等待运动状态满足条件；超时只给出警告，
+ *                                      带 required 时任务失败。条件:
+ *                                        stand / lie                 机身高度到达站立 / 趴下阈值
+ *                                        gait <n> / mode <n>         步态 / 运动模式等于 n
+ *                                        gait_changed / mode_changed 与上一条 send 时的值不同
+ *                                        height_above <m> / height_below <m>
+ *                                        height_changed <容差m>       与上一条 send 时相差超过容差
+ *   move <ms> <lx> <ly> <rx> <ry> [斜坡ms [step|linear|smooth]]
+ *                                      轨迹段；连续的 move 合并为一条路线，播放完毕后继续
+ *   stop                               停止轴值流
+ *   repeat <n> ... end                 循环 n 次，可嵌套
+ *   log <文本>                         输出日志
+ *
+ * 编译只在启动时进行一次；执行期间 MissionRunner 只推进程序计数器与少量状态，
+ * 不分配内存，也不阻塞：遇到等待即返回，由宿主（FleetController）在定时器到期、
+ * 状态包到达或轨迹结束时再次调用 resume()。一个线程可同时执行多台机器人的任务。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "status_protocol.h"
+#include "trajectory.h"
+
+namespace q25 {
+
+// ============ 步骤 ============
+enum MissionOp : uint32_t {
+    OP_SEND       = 0,
+    OP_WAIT       = 1,
+    OP_AWAIT      = 2,
+    OP_TRAJECTORY = 3,
+    OP_STOP_AXIS  = 4,
+    OP_REPEAT     = 5,
+    OP_END_REPEAT = 6,
+    OP_LOG        = 7
+};
+
+enum MissionCondition : uint32_t {
+    COND_STAND          = 0,
+    COND_LIE            = 1,
+    COND_GAIT           = 2,
+    COND_GAIT_CHANGED   = 3,
+    COND_MODE           = 4,
+    COND_MODE_CHANGED   = 5,
+    COND_HEIGHT_ABOVE   = 6,
+    COND_HEIGHT_BELOW   = 7,
+    COND_HEIGHT_CHANGED = 8
+};
+
+struct MissionStep {
+    uint32_t op;        // MissionOp
+    uint32_t arg;       // SEND: 指令码；AWAIT: 条件；TRAJECTORY: 首段下标；
+                        // REPEAT: 次数；END_REPEAT: 循环体第一步；LOG: 文本下标
+    int32_t  param;     // SEND: 参数；AWAIT: 步态 / 模式；TRAJECTORY: 段数
+    float    value;     // AWAIT: 高度 / 容差（米）
+    uint32_t time_ms;   // WAIT: 时长；AWAIT: 超时
+    uint32_t required;  // AWAIT: 超时即任务失败
+    uint32_t line;      // 源文件行号
+};
+
+// ============ 编译后的任务 ============
+struct Mission {
+    std::string name;
+    std::vector<MissionStep> steps;
+    std::vector<TrajectorySegment> segments;  // 全部 move 段，路线为其中连续的一段
+    std::vector<std::string> texts;           // log 文本
+};
+
+/**
+ * @brief 编译任务脚本
+ * @param name 任务名（日志用）
+ * @return 有语法错误时输出 "[ERROR] 名称:行号: ..." 并返回 false
+ */
+bool compileMission(const std::string& source, const std::string& name, Mission& out);
+
+/** @brief 读取并编译任务文件，任务名取文件名（不含目录与扩展名） */
+bool loadMission(const std::string& path, Mission& out);
+
+// 运动状态是否满足 AWAIT 条件；before 为上一条 send 时的运动状态
+bool missionConditionMet(const MissionStep& step, const MotionData& motion, const MotionData& before);
+
+// ============ 宿主接口 ============
+// MissionRunner 通过宿主发出指令、播放轨迹、读取最新状态，均在事件循环线程中调用
+class MissionHost {
+public:
+    virtual ~MissionHost() {}
+
+    virtual void sendCommand(uint32_t code, int32_t param) = 0;
+    virtual void playTrajectory(const TrajectorySegment* segments, size_t count) = 0;
+    virtual bool trajectoryActive() const = 0;
+    virtual void stopAxis() = 0;
+    // 最近一次收到的运动状态，从未收到时返回 false
+    virtual bool latestMotion(MotionData& out) const = 0;
+};
+
+// ============ 执行状态 ============
+enum MissionState : uint32_t {
+    MISSION_IDLE    = 0,
+    MISSION_RUNNING = 1,
+    MISSION_DONE    = 2,
+    MISSION_FAILED  = 3,  // required 等待超时
+    MISSION_ABORTED = 4
+};
+
+// 任务当前阻塞在什么上，宿主据此决定何时再次 resume()
+enum MissionWait : uint32_t {
+    MISSION_WAIT_NONE       = 0,  // 已结束
+    MISSION_WAIT_TIME       = 1,  // 到 deadlineMs() 为止
+    MISSION_WAIT_MOTION     = 2,  // 状态包到达，或到 deadlineMs() 超时
+    MISSION_WAIT_TRAJECTORY = 3,  // 轨迹结束
+    MISSION_WAIT_YIELD      = 4   // 单次执行步数已达上限，下一个 tick 继续
+};
+
+class MissionRunner {
+public:
+    // 单次 resume() 最多执行的步数，避免无等待的长循环占住事件循环
+    static constexpr size_t MAX_STEPS_PER_RESUME = 256;
+    static constexpr size_t MAX_REPEAT_DEPTH = 8;
+
+    MissionRunner();
+
+    /** @param robot 机器人编号（日志用） */
+    void start(const Mission* mission, int robot);
+    void abort();
+
+    /**
+     * @brief 执行到下一个阻塞点
+     * @param now_ms 宿主的单调时间（毫秒）
+     * @return 阻塞原因；任务结束时返回 MISSION_WAIT_NONE，结果见 state()
+     */
+    MissionWait resume(MissionHost& host, uint64_t now_ms);
+
+    MissionState state() const { return state_; }
+    MissionWait waiting() const { return wait_; }
+    uint64_t deadlineMs() const { return deadline_ms_; }
+    // 当前步骤下标
+    size_t step() const { return pc_; }
+    const Mission* mission() const { return mission_; }
+
+private:
+    void finish(MissionState state);
+
+    const Mission* mission_;
+    int robot_;
+    MissionState state_;
+    MissionWait wait_;
+    size_t pc_;
+    bool step_started_;    // 当前等待类步骤已开始（截止时间已确定）
+    uint64_t started_ms_;  // 当前等待类步骤的开始时刻
+    uint64_t deadline_ms_;
+    MotionData before_;    // 上一条 send 时的运动状态
+    bool has_before_;
+    uint32_t repeat_left_[MAX_REPEAT_DEPTH];
+    size_t repeat_depth_;
+};
+
+} // namespace q25
@@ -0,0 +1,249 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file motion_monitor.cpp
+ * @brief MotionMonitor 实现
+ */
+
+#include "motion_monitor.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#include "net_platform.h"
+
+namespace q25 {
+
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// ============ 常用条件 ============
+
+MotionPredicate gaitIs(uint32_t gait) {
+    return [gait](const MotionData& motion) { return motion.gait == gait; };
+}
+
+MotionPredicate gaitChangedFrom(uint32_t gait) {
+    return [gait](const MotionData& motion) { return motion.gait != gait; };
+}
+
+MotionPredicate modeIs(uint32_t motion_mode) {
+    return [motion_mode](const MotionData& motion) { return motion.motion_mode == motion_mode; };
+}
+
+MotionPredicate modeChangedFrom(uint32_t motion_mode) {
+    return [motion_mode](const MotionData& motion) { return motion.motion_mode != motion_mode; };
+}
+
+MotionPredicate bodyHeightAbove(float height_m) {
+    return [height_m](const MotionData& motion) { return motion.body_height > height_m; };
+}
+
+MotionPredicate bodyHeightBelow(float height_m) {
+    return [height_m](const MotionData& motion) { return motion.body_height < height_m; };
+}
+
+MotionPredicate bodyHeightChangedFrom(float height_m, float tolerance_m) {
+    return [height_m, tolerance_m](const MotionData& motion) {
+        return std::fabs(motion.body_height - height_m) > tolerance_m;
+    };
+}
+
+// ============ MotionMonitor ============
+
+MotionMonitor::MotionMonitor(const MotionMonitorConfig& config)
+    : config_(config)
+    , sock_(INVALID_SOCKET)
+    , receiver_(8, RECV_BUFFER_SIZE)
+    , has_motion_(false)
+    , running_(false)
+    , motion_packets_(0) {
+    memset(&latest_, 0, sizeof(latest_));
+    if (config_.poll_ms <= 0) {
+        config_.poll_ms = 10;
+    }
+    dispatcher_.onMotion([this](const PacketHeader&, const MotionData& motion) { onMotion(motion); });
+}
+
+MotionMonitor::~MotionMonitor() {
+    stop();
+}
+
+bool MotionMonitor::openSocket() {
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET) {
+        std::cerr << "[ERROR] Failed to create status socket: " << lastSocketError() << std::endl;
+        return false;
+    }
+
+    int opt = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
+
+    sockaddr_in local_addr;
+    memset(&local_addr, 0, sizeof(local_addr));
+    local_addr.sin_family = AF_INET;
+    local_addr.sin_port = htons(static_cast<uint16_t>(config_.local_port));
+    if (inet_pton(AF_INET, config_.bind_ip.c_str(), &local_addr.sin_addr) != 1) {
+        std::cerr << "[ERROR] Invalid bind address: " << config_.bind_ip << std::endl;
+        closeSocketHandle(sock);
+        return false;
+    }
+    if (bind(sock, reinterpret_cast<sockaddr*>(&local_addr), sizeof(local_addr)) != 0) {
+        std::cerr << "[ERROR] Failed to bind status socket to " << config_.bind_ip << ":"
+                  << config_.local_port << ", error: " << lastSocketError() << std::endl;
+        closeSocketHandle(sock);
+        return false;
+    }
+
+    if (!receiver_.open(sock)) {
+        closeSocketHandle(sock);
+        return false;
+    }
+    sock_ = sock;
+    return true;
+}
+
+void MotionMonitor::closeSocket() {
+    receiver_.close();
+    if (sock_ != INVALID_SOCKET) {
+        closeSocketHandle(sock_);
+        sock_ = INVALID_SOCKET;
+    }
+}
+
+bool MotionMonitor::start() {
+    if (running_) {
+        return true;
+    }
+    if (!openSocket()) {
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&MotionMonitor::run, this);
+    return true;
+}
+
+void MotionMonitor::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeSocket();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t now_ns = steadyNowNs();
+    while (!waiters_.empty()) {
+        complete(waiters_.size() - 1, false, now_ns);
+    }
+}
+
+std::future<MotionWaitResult> MotionMonitor::waitFor(const MotionPredicate& predicate, int timeout_ms) {
+    Waiter waiter;
+    waiter.predicate = predicate;
+    waiter.start_ns = steadyNowNs();
+    waiter.deadline_ns = timeout_ms > 0
+        ? waiter.start_ns + static_cast<int64_t>(timeout_ms) * 1000000 : 0;
+    std::future<MotionWaitResult> future = waiter.promise.get_future();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    waiters_.push_back(std::move(waiter));
+    if (has_motion_ && waiters_.back().predicate(latest_)) {
+        complete(waiters_.size() - 1, true, waiters_.back().start_ns);
+    } else if (!running_) {
+        complete(waiters_.size() - 1, false, waiters_.back().start_ns);
+    }
+    return future;
+}
+
+bool MotionMonitor::await(const char* what, const MotionPredicate& predicate, int timeout_ms) {
+    if (!running_) {
+        std::cout << "[WARNING] Status monitor not running, waiting " << timeout_ms
+                  << " ms for " << what << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+        return false;
+    }
+    MotionWaitResult result = waitFor(predicate, timeout_ms).get();
+    if (result.reached) {
+        std::cout << "[INFO] " << what << " reached after " << result.waited_ms << " ms" << std::endl;
+    } else {
+        std::cout << "[WARNING] " << what << " not reported within " << timeout_ms << " ms" << std::endl;
+    }
+    return result.reached;
+}
+
+bool MotionMonitor::latest(MotionData& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out = latest_;
+    return has_motion_;
+}
+
+void MotionMonitor::run() {
+    while (running_) {
+        size_t count = receiver_.receive(config_.poll_ms);
+        for (size_t i = 0; i < count; i++) {
+            const ReceivedDatagram& datagram = receiver_.datagram(i);
+            dispatcher_.parsePacket(datagram.data, datagram.len);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        expireWaiters(steadyNowNs());
+    }
+}
+
+void MotionMonitor::onMotion(const MotionData& motion) {
+    motion_packets_.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_ = motion;
+    has_motion_ = true;
+
+    int64_t now_ns = steadyNowNs();
+    for (size_t i = waiters_.size(); i > 0; i--) {
+        if (waiters_[i - 1].predicate(motion)) {
+            complete(i - 1, true, now_ns);
+        }
+    }
+}
+
+void MotionMonitor::complete(size_t index, bool reached, int64_t now_ns) {
+    Waiter& waiter = waiters_[index];
+    MotionWaitResult result;
+    result.reached = reached;
+    result.has_motion = has_motion_;
+    result.motion = latest_;
+    result.waited_ms = (now_ns - waiter.start_ns) / 1000000;
+    waiter.promise.set_value(result);
+
+    // 与末尾交换后移除，等待之间没有顺序要求
+    if (index + 1 != waiters_.size()) {
+        waiters_[index] = std::move(waiters_.back());
+    }
+    waiters_.pop_back();
+}
+
+void MotionMonitor::expireWaiters(int64_t now_ns) {
+    for (size_t i = waiters_.size(); i > 0; i--) {
+        int64_t deadline = waiters_[i - 1].deadline_ns;
+        if (deadline != 0 && now_ns >= deadline) {
+            complete(i - 1, false, now_ns);
+        }
+    }
+}
+
+} // namespace q25
@@ -0,0 +1,152 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file motion_monitor.h
+ * @brief 运动状态监视：等待 DATA_TYPE_MOTION 上报到达目标姿态/步态/模式
+ *
+ * 站立、步态切换、高度调节等指令发出后，不再固定 Sleep 若干秒，而是:
+ *
+ *     MotionData before = monitor.latestOr(MotionData());
+ *     loop.send<cmd::RunGait>();
+ *     MotionWaitResult r = monitor.waitFor(gaitChangedFrom(before.gait), 10000).get();
+ *
+ * waitFor() 立即返回 std::future，机器人上报的运动状态满足条件（或超时）时完成，
+ * 多个等待可以同时挂起。接收线程独占一个绑定到状态上报端口的 socket，
+ * 与控制循环的发送 socket 互不影响。调用 waitFor() 时最新状态已满足条件的，
+ * future 立即完成。
+ *
+ * 使用前需先构造 NetworkRuntime。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch_receiver.h"
+#include "net_types.h"
+#include "status_dispatcher.h"
+#include "status_protocol.h"
+
+namespace q25 {
+
+// ============ 监视配置 ============
+struct MotionMonitorConfig {
+    std::string bind_ip;  // 本地监听地址
+    int local_port;       // 状态上报端口（需与机器人端配置的目标地址一致）
+    int poll_ms;          // 接收等待上限，即超时检查的粒度
+
+    MotionMonitorConfig()
+        : bind_ip("0.0.0.0")
+        , local_port(DEFAULT_LOCAL_PORT)
+        , poll_ms(10) {}
+};
+
+// ============ 等待结果 ============
+struct MotionWaitResult {
+    bool       reached;     // 条件满足；false 表示超时或监视已停止
+    bool       has_motion;  // motion 是否有效（等待期间收到过运动状态）
+    MotionData motion;      // 满足条件时的运动状态，超时时为最近一次收到的状态
+    int64_t    waited_ms;   // 实际等待时间
+};
+
+// 运动状态条件
+typedef std::function<bool(const MotionData&)> MotionPredicate;
+
+// 站立 / 趴下完成的机身高度判定阈值（米），不同机型需按实际上报值标定。
+// 机身高度字段属于暂定的 MotionData 布局（见 status_protocol.h），布局不符时等待会提前满足或超时
+constexpr float STAND_BODY_HEIGHT_M = 0.25f;
+constexpr float LIE_BODY_HEIGHT_M   = 0.12f;
+
+// ============ 常用条件 ============
+MotionPredicate gaitIs(uint32_t gait);
+MotionPredicate gaitChangedFrom(uint32_t gait);
+MotionPredicate modeIs(uint32_t motion_mode);
+MotionPredicate modeChangedFrom(uint32_t motion_mode);
+MotionPredicate bodyHeightAbove(float height_m);
+MotionPredicate bodyHeightBelow(float height_m);
+// 机身高度偏离 height_m 超过 tolerance_m
+MotionPredicate bodyHeightChangedFrom(float height_m, float tolerance_m);
+
+class MotionMonitor {
+public:
+    explicit MotionMonitor(const MotionMonitorConfig& config = MotionMonitorConfig());
+    ~MotionMonitor();
+
+    MotionMonitor(const MotionMonitor&) = delete;
+    MotionMonitor& operator=(const MotionMonitor&) = delete;
+
+    bool start();
+    // 停止接收，尚未完成的等待以 reached = false 完成
+    void stop();
+
+    bool isRunning() const { return running_; }
+
+    /**
+     * @brief 等待运动状态满足条件（任意线程）
+     * @param timeout_ms 超时时间，<= 0 表示不超时（stop() 时完成）
+     */
+    std::future<MotionWaitResult> waitFor(const MotionPredicate& predicate, int timeout_ms);
+
+    /**
+     * @brief 阻塞等待并输出结果（Demo 用），超时只给出警告
+     *
+     * 监视未运行（例如状态端口被占用）时退化为固定等待 timeout_ms。
+     * @return 条件是否满足
+     */
+    bool await(const char* what, const MotionPredicate& predicate, int timeout_ms);
+
+    /** @brief 最近一次收到的运动状态，从未收到时返回 false */
+    bool latest(MotionData& out) const;
+
+    MotionData latestOr(const MotionData& fallback) const {
+        MotionData motion;
+        return latest(motion) ? motion : fallback;
+    }
+
+    uint64_t motionPackets() const { return motion_packets_.load(std::memory_order_relaxed); }
+
+private:
+    struct Waiter {
+        MotionPredicate predicate;
+        std::promise<MotionWaitResult> promise;
+        int64_t start_ns;
+        int64_t deadline_ns;  // 0 表示不超时
+    };
+
+    bool openSocket();
+    void closeSocket();
+    void run();
+    void onMotion(const MotionData& motion);
+    // 以 reached 完成等待并移出列表；调用者持有 mutex_
+    void complete(size_t index, bool reached, int64_t now_ns);
+    void expireWaiters(int64_t now_ns);
+
+    MotionMonitorConfig config_;
+
+    SOCKET sock_;
+    BatchReceiver receiver_;
+    StatusDispatcher dispatcher_;
+
+    mutable std::mutex mutex_;
+    std::vector<Waiter> waiters_;
+    MotionData latest_;
+    bool has_motion_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> motion_packets_;
+};
+
+} // namespace q25
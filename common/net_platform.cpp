@@ -0,0 +1,74 @@
+// ====================================================================
+//          Created:    2026/10/14/ 16:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file net_platform.cpp
+ * @brief 网络与系统调用平台适配实现
+ */
+
+#include "net_platform.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace q25 {
+
+#ifdef _WIN32
+
+NetworkRuntime::NetworkRuntime() : ok_(false) {
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+        return;
+    }
+    ok_ = true;
+}
+
+NetworkRuntime::~NetworkRuntime() {
+    if (ok_) {
+        WSACleanup();
+    }
+}
+
+int lastSocketError() {
+    return WSAGetLastError();
+}
+
+void closeSocketHandle(SOCKET sock) {
+    closesocket(sock);
+}
+
+#else
+
+NetworkRuntime::NetworkRuntime() : ok_(true) {}
+
+NetworkRuntime::~NetworkRuntime() {}
+
+int lastSocketError() {
+    return errno;
+}
+
+void closeSocketHandle(SOCKET sock) {
+    ::close(sock);
+}
+
+#endif
+
+void sleepMs(int ms) {
+    if (ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+} // namespace q25
@@ -0,0 +1,50 @@
+// ====================================================================
+//          Created:    2026/10/14/ 16:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file net_platform.h
+ * @brief 网络与系统调用的平台适配 (Windows / Linux)
+ *
+ * 公共库与各 Demo 不直接调用 WSAStartup / closesocket / Sleep 等平台接口，
+ * 统一经由这里，同一份控制与状态代码可在 Windows 与 Linux 上编译运行:
+ *   - Windows: Winsock2，批量接收为 IOCP（见 batch_receiver.h）
+ *   - Linux:   BSD socket，批量接收为 epoll + recvmmsg，可使用 SO_BUSY_POLL、
+ *              SCHED_FIFO 与隔离核
+ */
+
+#pragma once
+
+#include "net_types.h"
+
+namespace q25 {
+
+// ============ 网络运行环境 ============
+// Windows 下构造时 WSAStartup、析构时 WSACleanup；其他平台无需初始化。
+// 需在任何 socket 创建之前构造，并在所有 socket 关闭之后析构。
+class NetworkRuntime {
+public:
+    NetworkRuntime();
+    ~NetworkRuntime();
+
+    NetworkRuntime(const NetworkRuntime&) = delete;
+    NetworkRuntime& operator=(const NetworkRuntime&) = delete;
+
+    bool ok() const { return ok_; }
+
+private:
+    bool ok_;
+};
+
+// 最近一次 socket 调用的错误码（WSAGetLastError / errno）
+int lastSocketError();
+
+// 关闭 socket（closesocket / close）
+void closeSocketHandle(SOCKET sock);
+
+// 休眠指定毫秒数
+void sleepMs(int ms);
+
+} // namespace q25
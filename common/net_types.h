@@ -0,0 +1,29 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file net_types.h
+ * @brief socket 相关基础类型 (SOCKET / sockaddr_in)
+ *
+ * Windows 下即 Winsock2；其他平台映射到 BSD socket，并补齐
+ * INVALID_SOCKET / SOCKET_ERROR，使收发代码在两个平台上写法一致。
+ * 关闭 socket、取错误码等操作见 net_platform.h。
+ */
+
+#pragma once
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+typedef int SOCKET;
+constexpr SOCKET INVALID_SOCKET = -1;
+constexpr int SOCKET_ERROR = -1;
+#endif
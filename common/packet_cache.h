@@ -0,0 +1,89 @@
+// ====================================================================
+//          Created:    2026/10/14/ 12:55
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file packet_cache.h
+ * @brief 固定指令的预编码包 (仅头文件)
+ *
+ * 心跳、起立/趴下、急停、步态/模式切换没有可变参数，
+ * 高度 0/1/2、充电启动/停止等也只有少数几种取值。
+ * 这些包在编译期直接生成字节数组，放在只读数据段中，进程内只有一份，
+ * 发送时只需把 指针 + 长度 交给 socket，不再每次构造 UDPCommand。
+ *
+ *   transport.sendImage(packetImage<cmd::StandUp>());
+ *   transport.sendImage(packetImage<cmd::ChangeHeight, HEIGHT_LOW>());
+ *
+ * 字节数组按小端序生成，与主机字节序的 UDPCommand 一致（仅支持小端主机）。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "q25_codec.h"
+#include "q25_protocol.h"
+
+namespace q25 {
+
+// ============ 包映像 ============
+// 指向不可变的已编码数据，可按值传递
+struct PacketImage {
+    const uint8_t* data;
+    size_t size;
+};
+
+namespace packet_detail {
+
+constexpr uint8_t byteOf(uint32_t value, int index) {
+    return static_cast<uint8_t>(value >> (8 * index));
+}
+
+} // namespace packet_detail
+
+/**
+ * @brief 简单指令 Cmd 携带固定参数 Param 的预编码包
+ *
+ * 无参数指令只能使用 Param = 0。每种 <Cmd, Param> 组合只实例化一份 BYTES。
+ */
+template <typename Cmd, int32_t Param = 0>
+struct PreEncoded {
+    static_assert(Cmd::TYPE == SIMPLE_CMD, "only simple commands can be pre-encoded");
+    static_assert(Cmd::HAS_PARAM || Param == 0, "command takes no parameter");
+
+    static constexpr size_t SIZE = Cmd::SIZE;
+
+    // 布局与 UDPCommand 相同: code / parameters_size / type
+    static constexpr uint8_t BYTES[SIZE] = {
+        packet_detail::byteOf(Cmd::CODE, 0), packet_detail::byteOf(Cmd::CODE, 1),
+        packet_detail::byteOf(Cmd::CODE, 2), packet_detail::byteOf(Cmd::CODE, 3),
+        packet_detail::byteOf(static_cast<uint32_t>(Param), 0), packet_detail::byteOf(static_cast<uint32_t>(Param), 1),
+        packet_detail::byteOf(static_cast<uint32_t>(Param), 2), packet_detail::byteOf(static_cast<uint32_t>(Param), 3),
+        packet_detail::byteOf(SIMPLE_CMD, 0), packet_detail::byteOf(SIMPLE_CMD, 1),
+        packet_detail::byteOf(SIMPLE_CMD, 2), packet_detail::byteOf(SIMPLE_CMD, 3)
+    };
+};
+
+template <typename Cmd, int32_t Param> constexpr size_t PreEncoded<Cmd, Param>::SIZE;
+template <typename Cmd, int32_t Param> constexpr uint8_t PreEncoded<Cmd, Param>::BYTES[];
+
+/** @brief 无参数指令的包映像，如 packetImage<cmd::Heartbeat>() */
+template <typename Cmd>
+inline PacketImage packetImage() {
+    static_assert(!Cmd::HAS_PARAM, "command requires a parameter, use packetImage<Cmd, Param>()");
+    PacketImage image = { PreEncoded<Cmd>::BYTES, PreEncoded<Cmd>::SIZE };
+    return image;
+}
+
+/** @brief 固定参数指令的包映像，如 packetImage<cmd::AutoCharge, CHARGE_STOP>() */
+template <typename Cmd, int32_t Param>
+inline PacketImage packetImage() {
+    static_assert(Cmd::HAS_PARAM, "command takes no parameter, use packetImage<Cmd>()");
+    PacketImage image = { PreEncoded<Cmd, Param>::BYTES, PreEncoded<Cmd, Param>::SIZE };
+    return image;
+}
+
+} // namespace q25
@@ -0,0 +1,140 @@
+// ====================================================================
+//          Created:    2026/10/14/ 14:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file packet_ring.cpp
+ * @brief PacketRing 实现
+ */
+
+#include "packet_ring.h"
+
+#include <cstring>
+#include <new>
+
+namespace q25 {
+
+namespace {
+
+size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+PacketRing::PacketRing(size_t capacity, size_t slot_size)
+    : capacity_(nextPowerOfTwo(capacity))
+    , mask_(capacity_ - 1)
+    , slot_size_(roundUp(slot_size, CACHE_LINE_SIZE))
+    , slots_(nullptr)
+    , pool_(nullptr)
+    , head_(0)
+    , cached_tail_(0)
+    , pushed_(0)
+    , overflows_(0)
+    , oversized_(0)
+    , tail_(0)
+    , cached_head_(0)
+    , high_water_(0) {
+    slots_ = static_cast<PacketSlot*>(alignedAlloc(sizeof(PacketSlot) * capacity_));
+    pool_ = static_cast<uint8_t*>(alignedAlloc(slot_size_ * capacity_));
+    if (slots_ == nullptr || pool_ == nullptr) {
+        alignedFree(slots_);
+        alignedFree(pool_);
+        throw std::bad_alloc();
+    }
+
+    // 预先触碰全部内存，避免运行期缺页
+    memset(pool_, 0, slot_size_ * capacity_);
+    for (size_t i = 0; i < capacity_; i++) {
+        memset(&slots_[i], 0, sizeof(PacketSlot));
+        slots_[i].data = pool_ + i * slot_size_;
+    }
+}
+
+PacketRing::~PacketRing() {
+    alignedFree(slots_);
+    alignedFree(pool_);
+}
+
+PacketSlot* PacketRing::claim() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head - cached_tail_ >= capacity_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head - cached_tail_ >= capacity_) {
+            overflows_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+    return &slots_[head & mask_];
+}
+
+void PacketRing::commit() {
+    size_t head = head_.load(std::memory_order_relaxed) + 1;
+    head_.store(head, std::memory_order_release);
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool PacketRing::push(const uint8_t* data, size_t len, uint32_t from_addr, uint16_t from_port,
+                      int64_t recv_time_ns) {
+    if (len > slot_size_) {
+        oversized_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    PacketSlot* slot = claim();
+    if (slot == nullptr) {
+        return false;
+    }
+    memcpy(slot->data, data, len);
+    slot->len = static_cast<uint32_t>(len);
+    slot->from_addr = from_addr;
+    slot->from_port = from_port;
+    slot->recv_time_ns = recv_time_ns;
+    commit();
+    return true;
+}
+
+PacketSlot* PacketRing::peek() {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == cached_head_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail == cached_head_) {
+            return nullptr;
+        }
+        // 高水位在消费者刷新生产者索引时采样，两个索引都已在手，生产者热路径不读取消费者缓存行
+        uint64_t used = cached_head_ - tail;
+        if (used > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(used, std::memory_order_relaxed);
+        }
+    }
+    return &slots_[tail & mask_];
+}
+
+void PacketRing::release() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+size_t PacketRing::size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+PacketRingStats PacketRing::stats() const {
+    PacketRingStats s;
+    s.pushed = pushed_.load(std::memory_order_relaxed);
+    s.overflows = overflows_.load(std::memory_order_relaxed);
+    s.oversized = oversized_.load(std::memory_order_relaxed);
+    s.high_water = high_water_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace q25
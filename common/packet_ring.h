@@ -0,0 +1,103 @@
+// ====================================================================
+//          Created:    2026/10/14/ 14:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file packet_ring.h
+ * @brief 定长无锁单生产者/单消费者数据包环形缓冲区
+ *
+ * 位于接收线程（生产者）与处理线程（消费者）之间:
+ *   - 槽位与数据缓冲区在构造时一次性分配，运行期不再分配内存
+ *   - 生产者与消费者索引分别独占缓存行，并各自缓存对方索引，减少缓存行争用
+ *   - 环满时 claim()/push() 立即失败并计入 overflows，接收线程永远不会被慢消费者阻塞
+ *
+ * 生产者: claim() -> 填写槽位 -> commit()，或直接 push()
+ * 消费者: peek() -> 处理 -> release()
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "cache_line.h"
+
+namespace q25 {
+
+// ============ 数据包槽位 ============
+struct PacketSlot {
+    uint8_t* data;          // 指向槽位自己的数据缓冲区（容量为 PacketRing::slotSize()）
+    uint32_t len;           // 数据包长度
+    uint32_t from_addr;     // 发送方 IPv4 地址（网络字节序）
+    uint16_t from_port;     // 发送方端口（网络字节序）
+    int64_t  recv_time_ns;  // 本机接收时间（steady_clock，纳秒）
+};
+
+// ============ 缓冲区统计 ============
+struct PacketRingStats {
+    uint64_t pushed;      // 成功写入的数据包
+    uint64_t overflows;   // 环满被丢弃的数据包
+    uint64_t oversized;   // 超过槽位大小被丢弃的数据包
+    uint64_t high_water;  // 最大占用槽位数（消费者读取生产者索引时采样）
+};
+
+class PacketRing {
+public:
+    /**
+     * @param capacity  槽位数，向上取整为 2 的幂
+     * @param slot_size 每个槽位的数据缓冲区字节数
+     */
+    PacketRing(size_t capacity, size_t slot_size);
+    ~PacketRing();
+
+    PacketRing(const PacketRing&) = delete;
+    PacketRing& operator=(const PacketRing&) = delete;
+
+    // ============ 生产者接口 ============
+
+    // 取得下一个空槽位，环满时返回 nullptr 并计入 overflows
+    PacketSlot* claim();
+    // 发布 claim() 得到的槽位
+    void commit();
+    // 拷贝一个数据包到环中
+    bool push(const uint8_t* data, size_t len, uint32_t from_addr, uint16_t from_port,
+              int64_t recv_time_ns);
+
+    // ============ 消费者接口 ============
+
+    // 取得最早的数据包，环空时返回 nullptr
+    PacketSlot* peek();
+    // 归还 peek() 得到的槽位
+    void release();
+
+    size_t capacity() const { return capacity_; }
+    size_t slotSize() const { return slot_size_; }
+    size_t size() const;
+
+    // 统计由生产者（high_water 由消费者）更新，其他线程读取时为近似值
+    PacketRingStats stats() const;
+
+private:
+    size_t capacity_;
+    size_t mask_;
+    size_t slot_size_;
+    PacketSlot* slots_;
+    uint8_t* pool_;
+
+    // 生产者独占
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+    size_t cached_tail_;
+    std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> overflows_;
+    std::atomic<uint64_t> oversized_;
+
+    // 消费者独占
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+    size_t cached_head_;
+    std::atomic<uint64_t> high_water_;
+};
+
+} // namespace q25
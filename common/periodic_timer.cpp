@@ -0,0 +1,168 @@
+// ====================================================================
+//          Created:    2026/10/14/ 10:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file periodic_timer.cpp
+ * @brief PeriodicTimer 实现
+ */
+
+#include "periodic_timer.h"
+
+#include "thread_utils.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace q25 {
+
+namespace {
+
+// 高精度定时器约 0.5ms 精度；普通定时器在 timeBeginPeriod(1) 后约 1~2ms；
+// Linux 高精度定时器 (hrtimer) 唤醒延迟一般在 100us 以内
+constexpr std::chrono::nanoseconds SPIN_HIGH_RESOLUTION = std::chrono::microseconds(1000);
+constexpr std::chrono::nanoseconds SPIN_LEGACY          = std::chrono::microseconds(2000);
+constexpr std::chrono::nanoseconds SPIN_LINUX           = std::chrono::microseconds(200);
+
+} // namespace
+
+PeriodicTimer::PeriodicTimer(double rate_hz)
+    : period_(std::chrono::nanoseconds(static_cast<int64_t>(1e9 / rate_hz))) {
+    init();
+}
+
+PeriodicTimer::PeriodicTimer(std::chrono::nanoseconds period)
+    : period_(period) {
+    init();
+}
+
+#ifdef _WIN32
+
+PeriodicTimer::~PeriodicTimer() {
+    if (timer_handle_ != NULL) {
+        CloseHandle(static_cast<HANDLE>(timer_handle_));
+    }
+    if (time_period_raised_) {
+        timeEndPeriod(1);
+    }
+}
+
+void PeriodicTimer::init() {
+    high_resolution_ = true;
+    time_period_raised_ = false;
+    timer_handle_ = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                           TIMER_ALL_ACCESS);
+    if (timer_handle_ == NULL) {
+        // 旧系统不支持高精度定时器，回退并提高系统时钟精度
+        high_resolution_ = false;
+        timer_handle_ = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+        time_period_raised_ = (timeBeginPeriod(1) == 0);  // TIMERR_NOERROR
+    }
+    spin_threshold_ = high_resolution_ ? SPIN_HIGH_RESOLUTION : SPIN_LEGACY;
+    reset();
+}
+
+#else
+
+PeriodicTimer::~PeriodicTimer() {}
+
+void PeriodicTimer::init() {
+    timer_handle_ = nullptr;
+    high_resolution_ = true;
+    time_period_raised_ = false;
+    spin_threshold_ = SPIN_LINUX;
+    reset();
+}
+
+#endif
+
+void PeriodicTimer::reset() {
+    deadline_ = Clock::now();
+    stats_.ticks = 0;
+    stats_.missed = 0;
+    stats_.max_lateness_ns = 0;
+    stats_.total_lateness_ns = 0;
+}
+
+bool PeriodicTimer::waitNext() {
+    deadline_ += period_;
+
+    Clock::time_point now = Clock::now();
+    bool on_time = true;
+
+    if (now >= deadline_ + period_) {
+        // 已错过至少一个完整周期：跳过积压周期，对齐到下一个未来截止时间
+        int64_t behind = (now - deadline_) / period_;
+        stats_.missed += static_cast<uint64_t>(behind);
+        deadline_ += period_ * (behind + 1);
+        on_time = false;
+    }
+
+    if (deadline_ - now > spin_threshold_) {
+        sleepUntil(deadline_ - spin_threshold_);
+    }
+
+    // 自旋到截止时间
+    while ((now = Clock::now()) < deadline_) {
+        cpuRelax();
+    }
+
+    int64_t lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline_).count();
+    stats_.ticks++;
+    stats_.total_lateness_ns += lateness;
+    if (lateness > stats_.max_lateness_ns) {
+        stats_.max_lateness_ns = lateness;
+    }
+    return on_time;
+}
+
+#ifdef _WIN32
+
+void PeriodicTimer::sleepUntil(Clock::time_point wake_time) {
+    Clock::duration remaining = wake_time - Clock::now();
+    if (remaining <= Clock::duration::zero()) {
+        return;
+    }
+
+    if (timer_handle_ == NULL) {
+        Sleep(static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(remaining).count()));
+        return;
+    }
+
+    // 负值表示相对时间，单位 100ns
+    LARGE_INTEGER due;
+    due.QuadPart = -static_cast<LONGLONG>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100);
+    HANDLE timer = static_cast<HANDLE>(timer_handle_);
+    if (SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE)) {
+        WaitForSingleObject(timer, INFINITE);
+    }
+}
+
+#else
+
+void PeriodicTimer::sleepUntil(Clock::time_point wake_time) {
+    // steady_clock 即 CLOCK_MONOTONIC，按绝对时间休眠，被信号打断时继续等待同一时刻
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wake_time.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+
+#endif
+
+} // namespace q25
@@ -0,0 +1,81 @@
+// ====================================================================
+//          Created:    2026/10/14/ 10:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file periodic_timer.h
+ * @brief 基于绝对截止时间的高精度周期定时器
+ *
+ * 与 "发送 + Sleep(10)" 的写法不同，PeriodicTimer 的第 N 次触发时间固定为
+ * start + N * period，发送耗时和系统调度抖动不会累积成周期漂移。
+ *
+ * 等待策略（先睡后旋）:
+ *   1. 距截止时间较远时，使用高精度可等待定时器休眠到 (deadline - spin_threshold)
+ *      - 优先 CREATE_WAITABLE_TIMER_HIGH_RESOLUTION (Win10 1803+)
+ *      - 不支持时回退到普通可等待定时器，并用 timeBeginPeriod(1) 提高系统时钟精度
+ *      - Linux 使用 clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)，直接按绝对时间休眠
+ *   2. 最后一小段时间自旋等待，精确到达截止时间
+ *
+ * 若某次调用 waitNext() 时已超过截止时间一个周期以上，视为错过截止时间：
+ * 记入统计并将后续截止时间对齐到下一个未来时刻，不会补发积压的周期。
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace q25 {
+
+// ============ 定时器统计 ============
+struct TimerStats {
+    uint64_t ticks;            // 已触发次数
+    uint64_t missed;           // 错过的截止时间个数
+    int64_t  max_lateness_ns;  // 最大唤醒延迟
+    int64_t  total_lateness_ns;// 累计唤醒延迟（用于计算平均值）
+};
+
+class PeriodicTimer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    explicit PeriodicTimer(double rate_hz);
+    explicit PeriodicTimer(std::chrono::nanoseconds period);
+    ~PeriodicTimer();
+
+    PeriodicTimer(const PeriodicTimer&) = delete;
+    PeriodicTimer& operator=(const PeriodicTimer&) = delete;
+
+    /** @brief 以当前时刻为起点重新计时并清空统计 */
+    void reset();
+
+    /**
+     * @brief 阻塞到下一个截止时间
+     * @return 按时触发返回 true；错过一个或多个截止时间返回 false
+     */
+    bool waitNext();
+
+    /** @brief 自旋阶段长度，越大越准但越耗 CPU */
+    void setSpinThreshold(std::chrono::nanoseconds spin) { spin_threshold_ = spin; }
+
+    std::chrono::nanoseconds period() const { return period_; }
+    Clock::time_point deadline() const { return deadline_; }
+    const TimerStats& stats() const { return stats_; }
+
+private:
+    void init();
+    void sleepUntil(Clock::time_point wake_time);
+
+    std::chrono::nanoseconds period_;
+    std::chrono::nanoseconds spin_threshold_;
+    Clock::time_point deadline_;
+    TimerStats stats_;
+
+    void* timer_handle_;       // Windows 下为 HANDLE，避免在头文件中引入 windows.h；其他平台不使用
+    bool high_resolution_;
+    bool time_period_raised_;
+};
+
+} // namespace q25
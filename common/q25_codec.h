@@ -0,0 +1,232 @@
+// ====================================================================
+//          Created:    2026/10/14/ 12:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file q25_codec.h
+ * @brief 指令编解码 (仅头文件)：每条指令是一个编译期描述符
+ *
+ * 描述符在类型上记录指令码、简单/扩展类型及参数/数据体类型，
+ * encode<Cmd>() 按描述符直接把包写进调用方提供的缓冲区:
+ *   - 没有运行期 switch，包长为编译期常量 Cmd::SIZE
+ *   - 扩展指令只写 头 + sizeof(Payload)，不经过 AxisControlMessage::data[64]
+ *   - 不分配内存
+ * 参数个数/类型不匹配（如给起立指令传参数）在编译期报错。
+ *
+ * 字节序与原结构体一致，直接使用主机字节序（x86 小端）。
+ *
+ *   uint8_t buf[cmd::AxisControl::SIZE];
+ *   size_t len = encode<cmd::AxisControl>(buf, axis);
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "q25_protocol.h"
+
+namespace q25 {
+
+// ============ 指令描述符 ============
+
+/**
+ * @brief 简单指令：12 字节 UDPCommand
+ * @tparam HasParam 为 true 时参数写入 parameters_size 字段，否则该字段固定为 0
+ */
+template <uint32_t Code, bool HasParam = false>
+struct SimpleCommand {
+    static constexpr uint32_t CODE = Code;
+    static constexpr uint32_t TYPE = SIMPLE_CMD;
+    static constexpr bool HAS_PARAM = HasParam;
+    static constexpr size_t SIZE = sizeof(UDPCommand);
+    typedef void Payload;
+};
+
+/**
+ * @brief 扩展指令：CommandHead + 定长数据体
+ * @tparam PayloadT 打包的可平凡复制结构体，parameter_size = sizeof(PayloadT)
+ */
+template <uint32_t Code, typename PayloadT>
+struct ExtendedCommand {
+    static_assert(std::is_trivially_copyable<PayloadT>::value, "Payload must be trivially copyable");
+
+    static constexpr uint32_t CODE = Code;
+    static constexpr uint32_t TYPE = EXTENDED_CMD;
+    static constexpr bool HAS_PARAM = false;
+    static constexpr size_t SIZE = sizeof(CommandHead) + sizeof(PayloadT);
+    typedef PayloadT Payload;
+};
+
+// 类外定义，保证静态成员被 ODR 使用（如绑定到 const 引用）时也能链接
+template <uint32_t Code, bool HasParam> constexpr uint32_t SimpleCommand<Code, HasParam>::CODE;
+template <uint32_t Code, bool HasParam> constexpr uint32_t SimpleCommand<Code, HasParam>::TYPE;
+template <uint32_t Code, bool HasParam> constexpr bool SimpleCommand<Code, HasParam>::HAS_PARAM;
+template <uint32_t Code, bool HasParam> constexpr size_t SimpleCommand<Code, HasParam>::SIZE;
+template <uint32_t Code, typename PayloadT> constexpr uint32_t ExtendedCommand<Code, PayloadT>::CODE;
+template <uint32_t Code, typename PayloadT> constexpr uint32_t ExtendedCommand<Code, PayloadT>::TYPE;
+template <uint32_t Code, typename PayloadT> constexpr bool ExtendedCommand<Code, PayloadT>::HAS_PARAM;
+template <uint32_t Code, typename PayloadT> constexpr size_t ExtendedCommand<Code, PayloadT>::SIZE;
+
+// ============ 指令表 ============
+namespace cmd {
+
+typedef SimpleCommand<CMD_HEARTBEAT>      Heartbeat;
+typedef SimpleCommand<CMD_STAND_UP>       StandUp;
+typedef SimpleCommand<CMD_LIE_DOWN>       LieDown;
+typedef SimpleCommand<CMD_EMERGENCY_STOP> EmergencyStop;
+
+typedef SimpleCommand<CMD_LEFT_YAXIS, true>  LeftYAxis;
+typedef SimpleCommand<CMD_LEFT_XAXIS, true>  LeftXAxis;
+typedef SimpleCommand<CMD_RIGHT_XAXIS, true> RightXAxis;
+
+typedef SimpleCommand<CMD_WALK_STATE>     WalkGait;
+typedef SimpleCommand<CMD_RUN_STATE>      RunGait;
+typedef SimpleCommand<CMD_MANUAL_MODE>    ManualMode;
+typedef SimpleCommand<CMD_NAVI_MODE>      NaviMode;
+typedef SimpleCommand<CMD_ASSISTANT_MODE> AssistantMode;
+
+typedef SimpleCommand<CMD_CHANGE_HEIGHT, true>     ChangeHeight;
+typedef SimpleCommand<CMD_AUTO_CHARGE_START, true> AutoCharge;
+
+typedef SimpleCommand<CMD_POWER_DRIVER_MOTOR, true> PowerDriverMotor;
+typedef SimpleCommand<CMD_POWER_STATUS>             PowerStatus;
+typedef SimpleCommand<CMD_POWER_UPLOAD, true>       PowerUpload;
+typedef SimpleCommand<CMD_POWER_LIDAR_FU, true>     PowerLidarFU;
+typedef SimpleCommand<CMD_POWER_LIDAR_FL, true>     PowerLidarFL;
+typedef SimpleCommand<CMD_POWER_LIDAR_BU, true>     PowerLidarBU;
+typedef SimpleCommand<CMD_POWER_LIDAR_BL, true>     PowerLidarBL;
+
+typedef ExtendedCommand<CMD_AXIS_CONTROL, AxisCommand> AxisControl;
+
+} // namespace cmd
+
+// 所有已知指令中最长的编码长度，可用作通用发送缓冲区大小
+constexpr size_t MAX_COMMAND_SIZE = cmd::AxisControl::SIZE;
+
+static_assert(cmd::Heartbeat::SIZE == 12, "simple command must encode to 12 bytes");
+static_assert(cmd::AxisControl::SIZE == 28, "axis control must encode to head + 16 bytes");
+
+// ============ 编码 ============
+namespace codec_detail {
+
+inline void store32(uint8_t* dst, uint32_t value) {
+    memcpy(dst, &value, sizeof(value));  // 定长 4 字节，编译为单条存储指令
+}
+
+inline uint32_t load32(const uint8_t* src) {
+    uint32_t value;
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+} // namespace codec_detail
+
+/**
+ * @brief 编码无参数简单指令
+ * @param buf 至少 Cmd::SIZE 字节
+ * @return 写入的字节数 (Cmd::SIZE)
+ */
+template <typename Cmd>
+inline size_t encode(uint8_t* buf) {
+    static_assert(Cmd::TYPE == SIMPLE_CMD, "extended command requires a payload");
+    static_assert(!Cmd::HAS_PARAM, "command requires a parameter");
+    codec_detail::store32(buf, Cmd::CODE);
+    codec_detail::store32(buf + 4, 0);
+    codec_detail::store32(buf + 8, SIMPLE_CMD);
+    return Cmd::SIZE;
+}
+
+/** @brief 编码带参数简单指令，参数写入 parameters_size 字段 */
+template <typename Cmd>
+inline size_t encode(uint8_t* buf, int32_t param) {
+    static_assert(Cmd::TYPE == SIMPLE_CMD, "extended command requires a payload");
+    static_assert(Cmd::HAS_PARAM, "command takes no parameter");
+    codec_detail::store32(buf, Cmd::CODE);
+    codec_detail::store32(buf + 4, static_cast<uint32_t>(param));
+    codec_detail::store32(buf + 8, SIMPLE_CMD);
+    return Cmd::SIZE;
+}
+
+/** @brief 编码扩展指令：头 + 数据体，parameter_size 为编译期常量 */
+template <typename Cmd>
+inline size_t encode(uint8_t* buf, const typename Cmd::Payload& payload) {
+    static_assert(Cmd::TYPE == EXTENDED_CMD, "simple command takes an int32_t parameter");
+    codec_detail::store32(buf, Cmd::CODE);
+    codec_detail::store32(buf + 4, static_cast<uint32_t>(sizeof(typename Cmd::Payload)));
+    codec_detail::store32(buf + 8, EXTENDED_CMD);
+    memcpy(buf + sizeof(CommandHead), &payload, sizeof(typename Cmd::Payload));
+    return Cmd::SIZE;
+}
+
+/**
+ * @brief 运行期指令码的简单指令编码
+ *
+ * 供指令码只在运行期才知道的场景（指令队列、配置文件）使用；
+ * 编译期已知的指令应使用 encode<Cmd>()。
+ */
+inline size_t encodeSimple(uint8_t* buf, uint32_t code, int32_t param = 0) {
+    codec_detail::store32(buf, code);
+    codec_detail::store32(buf + 4, static_cast<uint32_t>(param));
+    codec_detail::store32(buf + 8, SIMPLE_CMD);
+    return sizeof(UDPCommand);
+}
+
+// ============ 解码 ============
+
+/** @brief 读取包中的指令码，不足 4 字节返回 0 */
+inline uint32_t peekCommandCode(const uint8_t* data, size_t len) {
+    return len >= sizeof(uint32_t) ? codec_detail::load32(data) : 0;
+}
+
+/** @brief 读取指令头（简单指令与扩展指令头的布局相同），长度不足返回 false */
+inline bool decodeHead(const uint8_t* data, size_t len, CommandHead& head) {
+    if (len < sizeof(CommandHead)) {
+        return false;
+    }
+    head.command_id = codec_detail::load32(data);
+    head.parameter_size = codec_detail::load32(data + 4);
+    head.command_type = codec_detail::load32(data + 8);
+    return true;
+}
+
+/** @brief 包是否为指令 Cmd（指令码、类型与长度都匹配） */
+template <typename Cmd>
+inline bool matches(const uint8_t* data, size_t len) {
+    CommandHead head;
+    if (len != Cmd::SIZE || !decodeHead(data, len, head)) {
+        return false;
+    }
+    if (head.command_id != Cmd::CODE || head.command_type != Cmd::TYPE) {
+        return false;
+    }
+    return Cmd::TYPE == SIMPLE_CMD || head.parameter_size == Cmd::SIZE - sizeof(CommandHead);
+}
+
+/** @brief 解码简单指令的参数 */
+template <typename Cmd>
+inline bool decode(const uint8_t* data, size_t len, int32_t& param) {
+    static_assert(Cmd::TYPE == SIMPLE_CMD, "extended command decodes into its payload type");
+    if (!matches<Cmd>(data, len)) {
+        return false;
+    }
+    param = static_cast<int32_t>(codec_detail::load32(data + 4));
+    return true;
+}
+
+/** @brief 解码扩展指令的数据体 */
+template <typename Cmd>
+inline bool decode(const uint8_t* data, size_t len, typename Cmd::Payload& payload) {
+    static_assert(Cmd::TYPE == EXTENDED_CMD, "simple command decodes into an int32_t");
+    if (!matches<Cmd>(data, len)) {
+        return false;
+    }
+    memcpy(&payload, data + sizeof(CommandHead), sizeof(typename Cmd::Payload));
+    return true;
+}
+
+} // namespace q25
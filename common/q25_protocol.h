@@ -0,0 +1,124 @@
+// ====================================================================
+//          Created:    2026/10/14/ 09:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file q25_protocol.h
+ * @brief 四足机器人 UDP 控制协议公共定义 (命令码 / 指令结构体)
+ *
+ * 所有控制类 Demo 共用的协议结构，原先在每个 .cpp 中各复制一份。
+ *
+ * 指令分两类:
+ *   - 简单指令: UDPCommand，12 字节，参数直接放在 parameters_size 字段
+ *   - 扩展指令: CommandHead + 数据体，command_type = 1
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace q25 {
+
+// ============ 默认网络配置 ============
+constexpr const char* DEFAULT_ROBOT_IP = "192.168.3.20";
+constexpr int DEFAULT_ROBOT_PORT = 43893;
+
+// ============ 公共命令码 ============
+constexpr uint32_t CMD_HEARTBEAT    = 0x21040001;
+constexpr uint32_t CMD_AXIS_CONTROL = 0x21010140;  // 轴控制指令码（复杂指令）
+
+// ============ 基础动作 ============
+constexpr uint32_t CMD_STAND_UP       = 0x21010202;  // 起立
+constexpr uint32_t CMD_LIE_DOWN       = 0x21010222;  // 趴下
+constexpr uint32_t CMD_EMERGENCY_STOP = 0x21010C0E;  // 急停
+
+// ============ 单轴指令（参数为轴值） ============
+constexpr uint32_t CMD_LEFT_YAXIS  = 0x21010130;  // 左摇杆Y轴（前后）
+constexpr uint32_t CMD_LEFT_XAXIS  = 0x21010131;  // 左摇杆X轴（左右）
+constexpr uint32_t CMD_RIGHT_XAXIS = 0x21010135;  // 右摇杆X轴（旋转）
+
+// ============ 步态 / 运动模式 ============
+constexpr uint32_t CMD_WALK_STATE     = 0x21010300;  // 行走步态(Walk)
+constexpr uint32_t CMD_RUN_STATE      = 0x21010423;  // 小跑步态(Trot/Run)
+constexpr uint32_t CMD_MANUAL_MODE    = 0x21010C02;  // 手动模式
+constexpr uint32_t CMD_NAVI_MODE      = 0x21010C03;  // 导航模式
+constexpr uint32_t CMD_ASSISTANT_MODE = 0x21010C04;  // 辅助模式
+
+// ============ 高度调节（参数为高度档位） ============
+constexpr uint32_t CMD_CHANGE_HEIGHT = 0x21010406;
+constexpr int32_t  HEIGHT_LOW    = 0;  // 匍匐
+constexpr int32_t  HEIGHT_MIDDLE = 1;  // 中高度（默认）
+constexpr int32_t  HEIGHT_HIGH   = 2;  // 高高度
+
+// ============ 自主充电（参数为启动/停止） ============
+constexpr uint32_t CMD_AUTO_CHARGE_START = 0x91910250;
+constexpr int32_t  CHARGE_START = 0;  // 启动充电任务
+constexpr int32_t  CHARGE_STOP  = 1;  // 停止充电任务
+
+// ============ 电源控制（参数为开/关） ============
+constexpr uint32_t CMD_POWER_DRIVER_MOTOR = 0x80110201;  // 驱动电机电源
+constexpr uint32_t CMD_POWER_STATUS       = 0x80110202;  // 电源状态查询
+constexpr uint32_t CMD_POWER_UPLOAD       = 0x80110801;  // 上装供电电源
+constexpr uint32_t CMD_POWER_LIDAR_FU     = 0x80110501;  // 前上雷达电源
+constexpr uint32_t CMD_POWER_LIDAR_FL     = 0x80110502;  // 前下雷达电源
+constexpr uint32_t CMD_POWER_LIDAR_BU     = 0x80110503;  // 后上雷达电源
+constexpr uint32_t CMD_POWER_LIDAR_BL     = 0x80110504;  // 后下雷达电源
+constexpr int32_t  POWER_OFF = 0;  // 关闭
+constexpr int32_t  POWER_ON  = 1;  // 开启
+
+// ============ 心跳频率 ============
+// 机器人在一定时间内未收到心跳会进入保护状态
+constexpr double HEARTBEAT_RATE_HZ = 2.0;  // 500ms = 2Hz
+
+// ============ 指令类型 ============
+constexpr uint32_t SIMPLE_CMD   = 0;  // 简单指令
+constexpr uint32_t EXTENDED_CMD = 1;  // 扩展指令
+
+// ============ UDP命令结构（简单指令） ============
+#pragma pack(push, 1)
+struct UDPCommand {
+    uint32_t code;
+    uint32_t parameters_size;  // 对于带参数的简单指令，这个字段存储参数值
+    uint32_t type;
+
+    UDPCommand(uint32_t cmd, int32_t param = 0)
+        : code(cmd)
+        , parameters_size(static_cast<uint32_t>(param))  // 将int32_t转为uint32_t
+        , type(SIMPLE_CMD) {}
+};
+#pragma pack(pop)
+
+// ============ 指令头结构体（复杂指令） ============
+#pragma pack(push, 1)
+struct CommandHead {
+    uint32_t command_id;     // 指令码
+    uint32_t parameter_size; // 数据体字节数
+    uint32_t command_type;   // 1 = 扩展指令
+};
+#pragma pack(pop)
+
+// ============ 轴指令数据体结构 ============
+#pragma pack(push, 1)
+struct AxisCommand {
+    uint32_t left_x;   // 平移摇杆X轴值
+    uint32_t left_y;   // 平移摇杆Y轴值
+    uint32_t right_x;  // 转向摇杆X轴值
+    uint32_t right_y;  // 转向摇杆Y轴值
+};
+#pragma pack(pop)
+
+// ============ 完整轴控制消息结构 ============
+#pragma pack(push, 1)
+struct AxisControlMessage {
+    CommandHead head;
+    uint8_t      data[64];  // 存储 AxisCommand
+};
+#pragma pack(pop)
+
+static_assert(sizeof(UDPCommand) == 12, "UDPCommand must be 12 bytes");
+static_assert(sizeof(CommandHead) == 12, "CommandHead must be 12 bytes");
+static_assert(sizeof(AxisCommand) == 16, "AxisCommand must be 16 bytes");
+
+} // namespace q25
@@ -0,0 +1,109 @@
+// ====================================================================
+//          Created:    2026/10/14/ 12:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file seqlock.h
+ * @brief 单写者 / 多读者顺序锁 (seqlock)，保存一个“最新值”
+ *
+ * 写者: store() 无等待，从不阻塞，也不关心读者是否读取过旧值（最新值覆盖旧值）
+ * 读者: tryLoad() 读到写者正在写入的中间状态时返回 false，不会读到撕裂数据
+ *
+ * 数据按 32 位原子字存放，读写过程符合 C++ 内存模型，不依赖未定义行为。
+ * T 必须是可平凡复制的类型（如协议中的打包结构体）。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cache_line.h"
+
+namespace q25 {
+
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock requires a trivially copyable type");
+
+public:
+    Seqlock() : seq_(0) {
+        for (size_t i = 0; i < WORDS; i++) {
+            words_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    explicit Seqlock(const T& initial) : Seqlock() {
+        store(initial);
+    }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    // 仅允许一个写者线程调用
+    void store(const T& value) {
+        uint32_t buf[WORDS] = {};
+        memcpy(buf, &value, sizeof(T));
+
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);  // 奇数：写入中
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);  // 偶数：写入完成
+    }
+
+    /**
+     * @brief 读取当前值
+     * @param version 可选，输出已完成的写入次数（可用于判断是否有新值、丢弃了多少旧值）
+     * @return 与写者冲突时返回 false，out 不被修改
+     */
+    bool tryLoad(T& out, uint32_t* version = nullptr) const {
+        uint32_t seq_begin = seq_.load(std::memory_order_acquire);
+        if (seq_begin & 1) {
+            return false;
+        }
+
+        uint32_t buf[WORDS];
+        for (size_t i = 0; i < WORDS; i++) {
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (seq_.load(std::memory_order_relaxed) != seq_begin) {
+            return false;
+        }
+
+        memcpy(&out, buf, sizeof(T));
+        if (version != nullptr) {
+            *version = seq_begin / 2;
+        }
+        return true;
+    }
+
+    // 读取当前值，冲突时重试直到成功
+    T load(uint32_t* version = nullptr) const {
+        T value;
+        while (!tryLoad(value, version)) {
+        }
+        return value;
+    }
+
+    // 已完成的写入次数
+    uint32_t version() const {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> words_[WORDS];
+};
+
+} // namespace q25
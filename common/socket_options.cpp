@@ -0,0 +1,109 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file socket_options.cpp
+ * @brief socket 选项设置实现
+ */
+
+#include "socket_options.h"
+
+#include <iostream>
+
+#include "net_platform.h"
+
+namespace q25 {
+
+namespace {
+
+bool setIntOption(SOCKET sock, int level, int name, int value, const char* label) {
+    if (setsockopt(sock, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) != 0) {
+        std::cerr << "[WARNING] Failed to set " << label << " to " << value
+                  << ", error: " << lastSocketError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int getIntOption(SOCKET sock, int level, int name) {
+    int value = 0;
+#ifdef _WIN32
+    int len = sizeof(value);
+#else
+    socklen_t len = sizeof(value);
+#endif
+    if (getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &len) != 0) {
+        return -1;
+    }
+    return value;
+}
+
+bool setBufferSize(SOCKET sock, int name, int bytes, const char* label) {
+    if (!setIntOption(sock, SOL_SOCKET, name, bytes, label)) {
+        return false;
+    }
+    int actual = getIntOption(sock, SOL_SOCKET, name);
+#ifndef _WIN32
+    // Linux 读回的是内核记账值（请求值的两倍），换算回来再比较
+    actual /= 2;
+#endif
+    if (actual >= 0 && actual < bytes) {
+        std::cerr << "[WARNING] " << label << " limited to " << actual << " bytes (requested "
+                  << bytes << ")" << std::endl;
+    }
+    return true;
+}
+
+} // namespace
+
+bool applySocketTuning(SOCKET sock, const SocketTuning& tuning) {
+    bool ok = true;
+
+    if (tuning.recv_buffer_bytes > 0) {
+        ok = setBufferSize(sock, SO_RCVBUF, tuning.recv_buffer_bytes, "SO_RCVBUF") && ok;
+    }
+    if (tuning.send_buffer_bytes > 0) {
+        ok = setBufferSize(sock, SO_SNDBUF, tuning.send_buffer_bytes, "SO_SNDBUF") && ok;
+    }
+
+    if (tuning.dscp >= 0) {
+        if (tuning.dscp > 63) {
+            std::cerr << "[WARNING] Invalid DSCP value: " << tuning.dscp << std::endl;
+            ok = false;
+        } else {
+            // DSCP 占 TOS 字节的高 6 位
+            ok = setIntOption(sock, IPPROTO_IP, IP_TOS, tuning.dscp << 2, "IP_TOS") && ok;
+        }
+    }
+
+    if (tuning.busy_poll_us > 0) {
+#if defined(SO_BUSY_POLL)
+        ok = setIntOption(sock, SOL_SOCKET, SO_BUSY_POLL, tuning.busy_poll_us, "SO_BUSY_POLL") && ok;
+#else
+        std::cerr << "[WARNING] SO_BUSY_POLL is not supported on this platform, ignored" << std::endl;
+#endif
+    }
+
+    if (tuning.priority >= 0) {
+#if defined(SO_PRIORITY)
+        ok = setIntOption(sock, SOL_SOCKET, SO_PRIORITY, tuning.priority, "SO_PRIORITY") && ok;
+#else
+        std::cerr << "[WARNING] SO_PRIORITY is not supported on this platform, ignored" << std::endl;
+#endif
+    }
+
+    return ok;
+}
+
+int getRecvBufferSize(SOCKET sock) {
+    return getIntOption(sock, SOL_SOCKET, SO_RCVBUF);
+}
+
+int getSendBufferSize(SOCKET sock) {
+    return getIntOption(sock, SOL_SOCKET, SO_SNDBUF);
+}
+
+} // namespace q25
@@ -0,0 +1,61 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file socket_options.h
+ * @brief 低延迟 socket 选项 (收发缓冲区 / DSCP 标记 / 发送优先级 / busy-poll)
+ *
+ * 状态数据突发时系统默认的接收缓冲区很小，处理不及时就会在内核里丢包；
+ * 控制指令则希望在交换机/无线链路上优先转发。
+ *
+ * 注意:
+ *   - Windows 默认忽略应用层设置的 IP_TOS，需要通过组策略 (QoS 策略) 或
+ *     注册表 DisableUserTOSSetting=0 才会真正写入 DSCP；设置失败只输出警告
+ *   - SO_BUSY_POLL、SO_PRIORITY 仅 Linux 支持，其他平台忽略该项
+ */
+
+#pragma once
+
+#include "net_types.h"
+
+namespace q25 {
+
+// ============ DSCP 常用取值 ============
+constexpr int DSCP_DEFAULT = 0;   // 尽力而为
+constexpr int DSCP_AF41    = 34;  // 交互式数据
+constexpr int DSCP_EF      = 46;  // 加速转发，用于控制指令
+constexpr int DSCP_CS6     = 48;  // 网络控制，用于急停通道
+
+struct SocketTuning {
+    int recv_buffer_bytes;  // SO_RCVBUF，0 表示保持系统默认
+    int send_buffer_bytes;  // SO_SNDBUF，0 表示保持系统默认
+    int dscp;               // 0~63，小于 0 表示不修改
+    int busy_poll_us;       // SO_BUSY_POLL 微秒数，0 表示不启用
+    int priority;           // SO_PRIORITY 0~6（本机发送队列优先级），小于 0 表示不修改
+
+    SocketTuning()
+        : recv_buffer_bytes(0)
+        , send_buffer_bytes(0)
+        , dscp(-1)
+        , busy_poll_us(0)
+        , priority(-1) {}
+};
+
+/**
+ * @brief 按配置设置 socket 选项
+ *
+ * 每项独立设置，某项失败不影响其余项。设置缓冲区后会读回内核实际生效的值，
+ * 与请求值不一致时输出警告（系统上限、Windows 下 SO_RCVBUF 的取整等）。
+ *
+ * @return 所有请求的选项都设置成功时返回 true
+ */
+bool applySocketTuning(SOCKET sock, const SocketTuning& tuning);
+
+// 读取当前的缓冲区大小，失败返回 -1
+int getRecvBufferSize(SOCKET sock);
+int getSendBufferSize(SOCKET sock);
+
+} // namespace q25
@@ -0,0 +1,77 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_cache.cpp
+ * @brief StatusCache 实现
+ */
+
+#include "status_cache.h"
+
+#include <cstring>
+
+namespace q25 {
+
+namespace {
+
+// 单写者：更新序号即已完成的写入次数 + 1
+template <typename T>
+void storeSnapshot(Seqlock<StatusSnapshot<T> >& slot, StatusSnapshot<T>& snapshot,
+                   const PacketHeader& header, int64_t recv_time_ns) {
+    snapshot.sequence = static_cast<uint64_t>(slot.version()) + 1;
+    snapshot.recv_time_ns = recv_time_ns;
+    snapshot.timestamp = header.timestamp;
+    slot.store(snapshot);
+}
+
+} // namespace
+
+StatusCache::StatusCache()
+    : recv_time_ns_(0) {}
+
+void StatusCache::attach(StatusDispatcher& dispatcher) {
+    dispatcher.onBattery([this](const PacketHeader& header, const BatteryData& battery) {
+        BatterySnapshot snapshot;
+        snapshot.data = battery;
+        storeSnapshot(battery_, snapshot, header, recv_time_ns_);
+    });
+    dispatcher.onIMU([this](const PacketHeader& header, const IMUData& imu) {
+        IMUSnapshot snapshot;
+        snapshot.data = imu;
+        storeSnapshot(imu_, snapshot, header, recv_time_ns_);
+    });
+    dispatcher.onJoint([this](const PacketHeader& header, JointSpan joints) {
+        JointSnapshot snapshot;
+        size_t count = joints.size < MAX_JOINTS ? joints.size : MAX_JOINTS;
+        snapshot.data.count = static_cast<uint32_t>(count);
+        memcpy(snapshot.data.joints, joints.data, count * sizeof(JointData));
+        memset(snapshot.data.joints + count, 0, (MAX_JOINTS - count) * sizeof(JointData));
+        storeSnapshot(joints_, snapshot, header, recv_time_ns_);
+    });
+    dispatcher.onMotion([this](const PacketHeader& header, const MotionData& motion) {
+        MotionSnapshot snapshot;
+        snapshot.data = motion;
+        storeSnapshot(motion_, snapshot, header, recv_time_ns_);
+    });
+    dispatcher.onSystem([this](const PacketHeader& header, const SystemData& system) {
+        SystemSnapshot snapshot;
+        snapshot.data = system;
+        storeSnapshot(system_, snapshot, header, recv_time_ns_);
+    });
+}
+
+uint64_t StatusCache::sequence(uint32_t data_type) const {
+    switch (data_type) {
+    case DATA_TYPE_BATTERY: return battery_.version();
+    case DATA_TYPE_IMU:     return imu_.version();
+    case DATA_TYPE_JOINT:   return joints_.version();
+    case DATA_TYPE_MOTION:  return motion_.version();
+    case DATA_TYPE_SYSTEM:  return system_.version();
+    default:                return 0;
+    }
+}
+
+} // namespace q25
@@ -0,0 +1,109 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_cache.h
+ * @brief 状态快照缓存：每种数据类型保存最新一份，任意多个读者无锁读取
+ *
+ * UI、规划、安全监视等都只关心"最新的电池 / IMU / 关节 / 运动 / 系统状态"。
+ * StatusCache 订阅 StatusDispatcher，解析线程每收到一个数据包就覆盖对应类型的快照，
+ * 其他线程随时读取：
+ *
+ *     StatusCache cache;
+ *     cache.attach(dispatcher);
+ *     // 解析线程
+ *     cache.setReceiveTime(slot->recv_time_ns);
+ *     dispatcher.parsePacket(slot->data, slot->len);
+ *     // 任意线程
+ *     MotionSnapshot motion;
+ *     if (cache.motion(motion)) { ... motion.data.gait, motion.recv_time_ns ... }
+ *
+ * 每种类型一个 Seqlock（各占独立缓存行）：写者无等待，读者只读共享内存、从不写入，
+ * 不会与接收线程争用缓存行，也不会读到撕裂数据。快照附带该类型的更新序号、
+ * 本机接收时间与机器人时间戳，读者可据此判断数据是否更新、是否过期。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "joint_state.h"
+#include "seqlock.h"
+#include "status_dispatcher.h"
+#include "status_protocol.h"
+
+namespace q25 {
+
+// ============ 快照 ============
+template <typename T>
+struct StatusSnapshot {
+    uint64_t sequence;      // 该类型的第几次更新（1 起），0 表示从未收到
+    int64_t  recv_time_ns;  // 本机接收时间（steady_clock），见 setReceiveTime()
+    uint64_t timestamp;     // 包头时间戳（机器人时间）
+    T        data;
+};
+
+// 关节数据按值保存，超过 MAX_JOINTS 的关节被忽略
+struct JointArray {
+    uint32_t  count;
+    JointData joints[MAX_JOINTS];
+};
+
+typedef StatusSnapshot<BatteryData>   BatterySnapshot;
+typedef StatusSnapshot<IMUData>       IMUSnapshot;
+typedef StatusSnapshot<JointArray>    JointSnapshot;
+typedef StatusSnapshot<MotionData>    MotionSnapshot;
+typedef StatusSnapshot<SystemData>    SystemSnapshot;
+
+class StatusCache {
+public:
+    StatusCache();
+
+    StatusCache(const StatusCache&) = delete;
+    StatusCache& operator=(const StatusCache&) = delete;
+
+    // 订阅 dispatcher 中的全部数据类型，需在开始分发之前调用
+    void attach(StatusDispatcher& dispatcher);
+
+    // 解析线程在 parsePacket() 之前调用，设置随后写入的快照的接收时间
+    void setReceiveTime(int64_t recv_time_ns) { recv_time_ns_ = recv_time_ns; }
+
+    // ============ 读取（任意线程） ============
+    // 从未收到该类型时返回 false；与写者冲突时在内部重试，不会阻塞写者
+
+    bool battery(BatterySnapshot& out) const { return read(battery_, out); }
+    bool imu(IMUSnapshot& out) const { return read(imu_, out); }
+    bool joints(JointSnapshot& out) const { return read(joints_, out); }
+    bool motion(MotionSnapshot& out) const { return read(motion_, out); }
+    bool system(SystemSnapshot& out) const { return read(system_, out); }
+
+    /**
+     * @brief 某类型的更新次数，不拷贝快照
+     * @param data_type DATA_TYPE_*，未缓存的类型返回 0
+     */
+    uint64_t sequence(uint32_t data_type) const;
+
+private:
+    template <typename T>
+    static bool read(const Seqlock<StatusSnapshot<T> >& slot, StatusSnapshot<T>& out) {
+        if (slot.version() == 0) {
+            return false;
+        }
+        out = slot.load();
+        return true;
+    }
+
+    Seqlock<BatterySnapshot> battery_;
+    Seqlock<IMUSnapshot>     imu_;
+    Seqlock<JointSnapshot>   joints_;
+    Seqlock<MotionSnapshot>  motion_;
+    Seqlock<SystemSnapshot>  system_;
+
+    int64_t recv_time_ns_;  // 仅解析线程访问
+};
+
+} // namespace q25
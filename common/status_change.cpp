@@ -0,0 +1,153 @@
+// ====================================================================
+//          Created:    2026/10/14/ 19:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_change.cpp
+ * @brief StatusChangeDetector 实现
+ */
+
+#include "status_change.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace q25 {
+
+namespace {
+
+bool exceeds(float value, float baseline, float step) {
+    return std::fabs(value - baseline) > step;
+}
+
+int64_t mileageBucket(float mileage_km, float bucket_km) {
+    return bucket_km > 0.0f ? static_cast<int64_t>(std::floor(mileage_km / bucket_km)) : 0;
+}
+
+} // namespace
+
+StatusChangeDetector::StatusChangeDetector(const ChangeDetectorConfig& config)
+    : config_(config)
+    , has_motion_(false)
+    , has_system_(false)
+    , mileage_bucket_(0) {
+    memset(&motion_, 0, sizeof(motion_));
+    memset(&system_, 0, sizeof(system_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+void StatusChangeDetector::attach(StatusDispatcher& dispatcher) {
+    dispatcher.onMotion([this](const PacketHeader& header, const MotionData& motion) {
+        updateMotion(header, motion);
+    });
+    dispatcher.onSystem([this](const PacketHeader& header, const SystemData& system) {
+        updateSystem(header, system);
+    });
+}
+
+void StatusChangeDetector::onMotionChange(uint32_t fields, const MotionChangeHandler& handler) {
+    MotionSubscriber subscriber;
+    subscriber.fields = fields;
+    subscriber.handler = handler;
+    motion_subscribers_.push_back(subscriber);
+}
+
+void StatusChangeDetector::onSystemChange(uint32_t fields, const SystemChangeHandler& handler) {
+    SystemSubscriber subscriber;
+    subscriber.fields = fields;
+    subscriber.handler = handler;
+    system_subscribers_.push_back(subscriber);
+}
+
+uint32_t StatusChangeDetector::updateMotion(const PacketHeader& header, const MotionData& motion) {
+    stats_.motion_packets++;
+
+    uint32_t changed = MOTION_ALL;
+    if (has_motion_) {
+        changed = 0;
+        if (motion.gait != motion_.gait) {
+            changed |= MOTION_GAIT;
+        }
+        if (motion.motion_mode != motion_.motion_mode) {
+            changed |= MOTION_MODE;
+        }
+        if (exceeds(motion.velocity_x, motion_.velocity_x, config_.velocity_step) ||
+            exceeds(motion.velocity_y, motion_.velocity_y, config_.velocity_step) ||
+            exceeds(motion.yaw_rate, motion_.yaw_rate, config_.velocity_step)) {
+            changed |= MOTION_VELOCITY;
+        }
+        if (exceeds(motion.body_height, motion_.body_height, config_.height_step_m)) {
+            changed |= MOTION_HEIGHT;
+        }
+    }
+    if (changed == 0) {
+        return 0;
+    }
+
+    // 只更新变化了的字段的基准，未越过死区的小变化继续累积
+    if (changed & MOTION_GAIT) {
+        motion_.gait = motion.gait;
+    }
+    if (changed & MOTION_MODE) {
+        motion_.motion_mode = motion.motion_mode;
+    }
+    if (changed & MOTION_VELOCITY) {
+        motion_.velocity_x = motion.velocity_x;
+        motion_.velocity_y = motion.velocity_y;
+        motion_.yaw_rate = motion.yaw_rate;
+    }
+    if (changed & MOTION_HEIGHT) {
+        motion_.body_height = motion.body_height;
+    }
+    has_motion_ = true;
+    stats_.motion_changes++;
+
+    for (size_t i = 0; i < motion_subscribers_.size(); i++) {
+        if (motion_subscribers_[i].fields & changed) {
+            motion_subscribers_[i].handler(header, motion, changed);
+        }
+    }
+    return changed;
+}
+
+uint32_t StatusChangeDetector::updateSystem(const PacketHeader& header, const SystemData& system) {
+    stats_.system_packets++;
+
+    int64_t bucket = mileageBucket(system.mileage_km, config_.mileage_bucket_km);
+    uint32_t changed = SYSTEM_ALL & ~SYSTEM_REBOOT;
+    if (has_system_) {
+        changed = 0;
+        if (system.firmware_version != system_.firmware_version ||
+            system.software_version != system_.software_version) {
+            changed |= SYSTEM_VERSION;
+        }
+        if (system.error_code != system_.error_code) {
+            changed |= SYSTEM_ERROR;
+        }
+        if (bucket != mileage_bucket_) {
+            changed |= SYSTEM_MILEAGE;
+        }
+        if (system.uptime_s < system_.uptime_s) {
+            changed |= SYSTEM_REBOOT;
+        }
+    }
+    // 运行时间每包都变，总是更新，用于下一次的重启判断
+    system_ = system;
+    mileage_bucket_ = bucket;
+    has_system_ = true;
+    if (changed == 0) {
+        return 0;
+    }
+    stats_.system_changes++;
+
+    for (size_t i = 0; i < system_subscribers_.size(); i++) {
+        if (system_subscribers_[i].fields & changed) {
+            system_subscribers_[i].handler(header, system, changed);
+        }
+    }
+    return changed;
+}
+
+} // namespace q25
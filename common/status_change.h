@@ -0,0 +1,125 @@
+// ====================================================================
+//          Created:    2026/10/14/ 19:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_change.h
+ * @brief 运动状态 / 系统信息的字段级变化检测
+ *
+ * 运动状态与系统信息按固定频率上报，绝大多数数据包与上一个相同。
+ * StatusChangeDetector 订阅 StatusDispatcher，逐字段与上次通知时的值比较，
+ * 只在订阅的字段真正变化时回调:
+ *
+ *     StatusChangeDetector changes;
+ *     changes.attach(dispatcher);
+ *     changes.onMotionChange(MOTION_GAIT | MOTION_MODE,
+ *         [](const PacketHeader&, const MotionData& motion, uint32_t changed) { ... });
+ *
+ * 步态、模式、版本、故障码按值比较；速度、机身高度与上次通知时相差超过死区才算变化
+ * （基准只在变化时更新，缓慢漂移累积超过死区后同样会通知）；里程按档位比较；
+ * 运行时间不通知，只用于检测重启。收到的第一个数据包视为全部字段变化。
+ * 系统信息的字段（含里程档位与重启检测所依据的里程、运行时间）来自暂定的 SystemData 布局，
+ * 见 status_protocol.h。
+ *
+ * 与 StatusDispatcher 相同，回调在调用 parsePacket() 的线程中同步执行。
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "status_dispatcher.h"
+#include "status_protocol.h"
+
+namespace q25 {
+
+// ============ 字段 ============
+enum MotionField : uint32_t {
+    MOTION_GAIT     = 1u << 0,
+    MOTION_MODE     = 1u << 1,
+    MOTION_VELOCITY = 1u << 2,  // velocity_x / velocity_y / yaw_rate
+    MOTION_HEIGHT   = 1u << 3,
+    MOTION_ALL      = 0xF
+};
+
+enum SystemField : uint32_t {
+    SYSTEM_VERSION = 1u << 0,  // firmware_version / software_version
+    SYSTEM_ERROR   = 1u << 1,
+    SYSTEM_MILEAGE = 1u << 2,  // 里程跨过档位
+    SYSTEM_REBOOT  = 1u << 3,  // 运行时间变小
+    SYSTEM_ALL     = 0xF
+};
+
+// ============ 检测配置 ============
+struct ChangeDetectorConfig {
+    float velocity_step;      // 速度 (m/s) / 角速度 (rad/s) 死区
+    float height_step_m;      // 机身高度死区 (m)
+    float mileage_bucket_km;  // 里程档位 (km)
+
+    ChangeDetectorConfig()
+        : velocity_step(0.05f)
+        , height_step_m(0.01f)
+        , mileage_bucket_km(0.1f) {}
+};
+
+// ============ 检测统计 ============
+struct ChangeDetectorStats {
+    uint64_t motion_packets;  // 收到的运动状态包
+    uint64_t motion_changes;  // 有字段变化的运动状态包
+    uint64_t system_packets;
+    uint64_t system_changes;
+};
+
+class StatusChangeDetector {
+public:
+    // changed 为本次变化的字段（MotionField / SystemField 位）
+    typedef std::function<void(const PacketHeader&, const MotionData&, uint32_t changed)> MotionChangeHandler;
+    typedef std::function<void(const PacketHeader&, const SystemData&, uint32_t changed)> SystemChangeHandler;
+
+    explicit StatusChangeDetector(const ChangeDetectorConfig& config = ChangeDetectorConfig());
+
+    // 订阅 dispatcher 的运动状态与系统信息，需在开始分发之前调用
+    void attach(StatusDispatcher& dispatcher);
+
+    // ============ 订阅 ============
+    // fields 中至少一个字段变化时回调
+    void onMotionChange(uint32_t fields, const MotionChangeHandler& handler);
+    void onSystemChange(uint32_t fields, const SystemChangeHandler& handler);
+
+    // ============ 检测 ============
+    // 比较并更新基准，通知订阅者，返回变化的字段；不经 attach() 时也可直接调用
+    uint32_t updateMotion(const PacketHeader& header, const MotionData& motion);
+    uint32_t updateSystem(const PacketHeader& header, const SystemData& system);
+
+    const ChangeDetectorStats& stats() const { return stats_; }
+
+private:
+    struct MotionSubscriber {
+        uint32_t fields;
+        MotionChangeHandler handler;
+    };
+    struct SystemSubscriber {
+        uint32_t fields;
+        SystemChangeHandler handler;
+    };
+
+    ChangeDetectorConfig config_;
+
+    std::vector<MotionSubscriber> motion_subscribers_;
+    std::vector<SystemSubscriber> system_subscribers_;
+
+    // 各字段上次通知时的值
+    bool       has_motion_;
+    MotionData motion_;
+    bool       has_system_;
+    SystemData system_;
+    int64_t    mileage_bucket_;
+
+    ChangeDetectorStats stats_;
+};
+
+} // namespace q25
@@ -0,0 +1,101 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_dispatcher.cpp
+ * @brief StatusDispatcher 实现
+ */
+
+#include "status_dispatcher.h"
+
+#include "trace.h"
+
+namespace q25 {
+
+StatusDispatcher::StatusDispatcher() {
+    stats_.packets = 0;
+    stats_.short_packets = 0;
+    stats_.size_mismatch = 0;
+    stats_.unknown = 0;
+}
+
+void StatusDispatcher::parsePacket(const uint8_t* buffer, size_t len) {
+    Q25_TRACE_SCOPE(trace, "status.parse");
+    if (len < sizeof(PacketHeader)) {
+        stats_.short_packets++;
+        return;
+    }
+
+    const PacketHeader& header = *reinterpret_cast<const PacketHeader*>(buffer);
+    const uint8_t* payload = buffer + sizeof(PacketHeader);
+    size_t payload_len = len - sizeof(PacketHeader);
+    stats_.packets++;
+    Q25_TRACE_ARG(trace, header.type);
+
+    switch (header.type) {
+        case DATA_TYPE_BATTERY: {
+            if (payload_len < sizeof(BatteryData)) {
+                stats_.short_packets++;
+                return;
+            }
+            const BatteryData& battery = *reinterpret_cast<const BatteryData*>(payload);
+            for (size_t i = 0; i < battery_handlers_.size(); i++) {
+                battery_handlers_[i](header, battery);
+            }
+            break;
+        }
+        case DATA_TYPE_IMU: {
+            if (payload_len < sizeof(IMUData)) {
+                stats_.short_packets++;
+                return;
+            }
+            const IMUData& imu = *reinterpret_cast<const IMUData*>(payload);
+            for (size_t i = 0; i < imu_handlers_.size(); i++) {
+                imu_handlers_[i](header, imu);
+            }
+            break;
+        }
+        case DATA_TYPE_JOINT: {
+            JointSpan joints;
+            joints.data = reinterpret_cast<const JointData*>(payload);
+            joints.size = payload_len / sizeof(JointData);
+            for (size_t i = 0; i < joint_handlers_.size(); i++) {
+                joint_handlers_[i](header, joints);
+            }
+            break;
+        }
+        case DATA_TYPE_MOTION: {
+            if (payload_len != sizeof(MotionData)) {
+                stats_.size_mismatch++;
+                return;
+            }
+            const MotionData& motion = *reinterpret_cast<const MotionData*>(payload);
+            for (size_t i = 0; i < motion_handlers_.size(); i++) {
+                motion_handlers_[i](header, motion);
+            }
+            break;
+        }
+        case DATA_TYPE_SYSTEM: {
+            if (payload_len != sizeof(SystemData)) {
+                stats_.size_mismatch++;
+                return;
+            }
+            const SystemData& system = *reinterpret_cast<const SystemData*>(payload);
+            for (size_t i = 0; i < system_handlers_.size(); i++) {
+                system_handlers_[i](header, system);
+            }
+            break;
+        }
+        default:
+            stats_.unknown++;
+            for (size_t i = 0; i < unknown_handlers_.size(); i++) {
+                unknown_handlers_[i](header, payload, payload_len);
+            }
+            break;
+    }
+}
+
+} // namespace q25
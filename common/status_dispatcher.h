@@ -0,0 +1,74 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_dispatcher.h
+ * @brief 状态数据包类型化分发
+ *
+ * parsePacket() 只做长度校验和类型分发，不做任何输出。布局尚未确认的类型（见 status_protocol.h）
+ * 要求长度完全一致，避免按错误的布局解读数据。订阅者收到的
+ * const IMUData& / JointSpan 等直接指向接收缓冲区，不发生拷贝，
+ * 仅在回调期间有效，需要保留时由订阅者自行复制。
+ *
+ * 订阅需在开始分发之前完成；分发过程在调用 parsePacket() 的线程中同步执行。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "status_protocol.h"
+
+namespace q25 {
+
+// ============ 分发统计 ============
+struct DispatchStats {
+    uint64_t packets;        // 已分发的数据包
+    uint64_t short_packets;  // 长度不足被丢弃的数据包
+    uint64_t size_mismatch;  // 长度与暂定结构 (MotionData / SystemData) 不一致被丢弃的数据包
+    uint64_t unknown;        // 未知类型数据包
+};
+
+class StatusDispatcher {
+public:
+    typedef std::function<void(const PacketHeader&, const BatteryData&)> BatteryHandler;
+    typedef std::function<void(const PacketHeader&, const IMUData&)> IMUHandler;
+    typedef std::function<void(const PacketHeader&, JointSpan)> JointHandler;
+    typedef std::function<void(const PacketHeader&, const MotionData&)> MotionHandler;
+    typedef std::function<void(const PacketHeader&, const SystemData&)> SystemHandler;
+    typedef std::function<void(const PacketHeader&, const uint8_t*, size_t)> RawHandler;
+
+    StatusDispatcher();
+
+    // ============ 订阅 ============
+    void onBattery(const BatteryHandler& handler) { battery_handlers_.push_back(handler); }
+    void onIMU(const IMUHandler& handler) { imu_handlers_.push_back(handler); }
+    void onJoint(const JointHandler& handler) { joint_handlers_.push_back(handler); }
+    void onMotion(const MotionHandler& handler) { motion_handlers_.push_back(handler); }
+    void onSystem(const SystemHandler& handler) { system_handlers_.push_back(handler); }
+    // 未单独解析的数据类型，收到原始数据体
+    void onUnknown(const RawHandler& handler) { unknown_handlers_.push_back(handler); }
+
+    // ============ 分发 ============
+    void parsePacket(const uint8_t* buffer, size_t len);
+
+    const DispatchStats& stats() const { return stats_; }
+
+private:
+    std::vector<BatteryHandler> battery_handlers_;
+    std::vector<IMUHandler> imu_handlers_;
+    std::vector<JointHandler> joint_handlers_;
+    std::vector<MotionHandler> motion_handlers_;
+    std::vector<SystemHandler> system_handlers_;
+    std::vector<RawHandler> unknown_handlers_;
+
+    DispatchStats stats_;
+};
+
+} // namespace q25
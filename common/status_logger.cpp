@@ -0,0 +1,124 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_logger.cpp
+ * @brief StatusLogger 实现
+ */
+
+#include "status_logger.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace q25 {
+
+namespace {
+
+// 最长限频间隔，避免过小的频率换算后超出时钟计数范围
+constexpr double MAX_INTERVAL_SEC = 3600.0;
+
+double intervalSec(double max_lines_per_sec) {
+    double interval = 1.0 / max_lines_per_sec;
+    return interval < MAX_INTERVAL_SEC ? interval : MAX_INTERVAL_SEC;
+}
+
+} // namespace
+
+StatusLogger::StatusLogger(double max_lines_per_sec)
+    // 0、负数与 NaN 都不满足 > 0，均视为关闭
+    : enabled_(max_lines_per_sec > 0.0)
+    , min_interval_(enabled_ ? std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(intervalSec(max_lines_per_sec))) : Clock::duration::zero())
+    , suppressed_(0) {
+    for (int i = 0; i < CH_COUNT; i++) {
+        next_allowed_[i] = Clock::time_point::min();
+    }
+}
+
+void StatusLogger::attach(StatusDispatcher& dispatcher) {
+    dispatcher.onBattery([this](const PacketHeader&, const BatteryData& battery) {
+        if (allow(CH_BATTERY)) logBattery(battery);
+    });
+    dispatcher.onIMU([this](const PacketHeader&, const IMUData& imu) {
+        if (allow(CH_IMU)) logIMU(imu);
+    });
+    dispatcher.onJoint([this](const PacketHeader&, JointSpan joints) {
+        if (allow(CH_JOINT)) logJoint(joints);
+    });
+    dispatcher.onMotion([this](const PacketHeader&, const MotionData& motion) {
+        if (allow(CH_MOTION)) logMotion(motion);
+    });
+    dispatcher.onSystem([this](const PacketHeader&, const SystemData& system) {
+        if (allow(CH_SYSTEM)) logSystem(system);
+    });
+    dispatcher.onUnknown([this](const PacketHeader& header, const uint8_t*, size_t payload_len) {
+        if (allow(CH_OTHER)) logOther(header, payload_len);
+    });
+}
+
+bool StatusLogger::allow(Channel channel) {
+    if (!enabled_) {
+        suppressed_++;
+        return false;
+    }
+    Clock::time_point now = Clock::now();
+    if (now < next_allowed_[channel]) {
+        suppressed_++;
+        return false;
+    }
+    next_allowed_[channel] = now + min_interval_;
+    return true;
+}
+
+void StatusLogger::logBattery(const BatteryData& battery) {
+    std::cout << "[Battery] Capacity: " << std::fixed << std::setprecision(1)
+              << battery.percentage << "%, "
+              << "Voltage: " << battery.voltage << "V, "
+              << "Current: " << battery.current << "A, "
+              << "Temperature: " << battery.temperature << " C" << '\n';
+}
+
+void StatusLogger::logIMU(const IMUData& imu) {
+    std::cout << "[IMU] Roll: " << std::fixed << std::setprecision(3)
+              << imu.roll << ", Pitch: " << imu.pitch
+              << ", Yaw: " << imu.yaw << '\n';
+}
+
+void StatusLogger::logJoint(JointSpan joints) {
+    std::cout << "[Joint] Total " << joints.size << " joint data" << '\n';
+
+    // Only print brief info for first 4 joints
+    for (size_t i = 0; i < (std::min)(joints.size, (size_t)4); i++) {
+        std::cout << "  Joint" << i << ": pos=" << std::fixed << std::setprecision(2)
+                  << joints[i].position << ", vel=" << joints[i].velocity << '\n';
+    }
+}
+
+void StatusLogger::logMotion(const MotionData& motion) {
+    std::cout << "[Motion] Gait: 0x" << std::hex << motion.gait
+              << ", Mode: 0x" << motion.motion_mode << std::dec
+              << std::fixed << std::setprecision(2)
+              << ", Velocity: (" << motion.velocity_x << ", " << motion.velocity_y << ") m/s"
+              << ", Yaw rate: " << motion.yaw_rate << " rad/s"
+              << ", Height: " << motion.body_height << " m" << '\n';
+}
+
+void StatusLogger::logSystem(const SystemData& system) {
+    std::cout << "[System] Firmware: 0x" << std::hex << system.firmware_version
+              << ", Software: 0x" << system.software_version << std::dec
+              << ", Uptime: " << system.uptime_s << " s"
+              << ", Mileage: " << std::fixed << std::setprecision(2) << system.mileage_km << " km"
+              << ", Error: 0x" << std::hex << system.error_code << std::dec << '\n';
+}
+
+void StatusLogger::logOther(const PacketHeader& header, size_t payload_len) {
+    std::cout << "[INFO] Received data type: 0x" << std::hex << header.type
+              << std::dec << ", Length: " << payload_len + sizeof(PacketHeader) << " bytes" << '\n';
+}
+
+} // namespace q25
@@ -0,0 +1,58 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:20
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_logger.h
+ * @brief 可选的限频状态日志订阅者
+ *
+ * 按数据类型分别限频（默认每种类型每秒最多一行），超出频率的数据包只计数不输出。
+ * 输出使用 '\n' 而不是 std::endl，避免每行都刷新控制台。
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "status_dispatcher.h"
+
+namespace q25 {
+
+class StatusLogger {
+public:
+    /**
+     * @param max_lines_per_sec 每种数据类型每秒最多输出的行数；<= 0（或非数值）表示关闭输出，
+     *        全部数据包只计入 suppressed()；小于每小时一行时按每小时一行处理
+     */
+    explicit StatusLogger(double max_lines_per_sec = 1.0);
+
+    // 订阅 dispatcher 中的全部数据类型
+    void attach(StatusDispatcher& dispatcher);
+
+    uint64_t suppressed() const { return suppressed_; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // 电池 / IMU / 关节 / 运动状态 / 系统信息 / 其他 各自独立限频
+    enum Channel { CH_BATTERY, CH_IMU, CH_JOINT, CH_MOTION, CH_SYSTEM, CH_OTHER, CH_COUNT };
+
+    bool allow(Channel channel);
+
+    void logBattery(const BatteryData& battery);
+    void logIMU(const IMUData& imu);
+    void logJoint(JointSpan joints);
+    void logMotion(const MotionData& motion);
+    void logSystem(const SystemData& system);
+    void logOther(const PacketHeader& header, size_t payload_len);
+
+    bool enabled_;
+    Clock::duration min_interval_;
+    Clock::time_point next_allowed_[CH_COUNT];
+    uint64_t suppressed_;
+};
+
+} // namespace q25
@@ -0,0 +1,116 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file status_protocol.h
+ * @brief 机器人主动上报的状态数据包定义
+ *
+ * 每个数据包 = PacketHeader + 数据体，数据体结构由 PacketHeader::type 决定。
+ * 根据实际协议定义，这里列出常见的数据类型。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace q25 {
+
+// ============ 默认监听配置 ============
+// 本机监听配置（需与机器人端配置的目标地址一致）
+constexpr const char* DEFAULT_LOCAL_IP = "192.168.3.157";  // 本机IP
+constexpr int DEFAULT_LOCAL_PORT = 43893;                  // 监听端口
+
+// 接收缓冲区大小（UDP 数据报最大长度）
+constexpr size_t RECV_BUFFER_SIZE = 65535;
+
+// ============ 数据包类型标识 ============
+constexpr uint32_t DATA_TYPE_BATTERY  = 0x01;  // 电池数据
+constexpr uint32_t DATA_TYPE_IMU      = 0x02;  // IMU数据
+constexpr uint32_t DATA_TYPE_JOINT    = 0x03;  // 关节数据
+constexpr uint32_t DATA_TYPE_MOTION   = 0x04;  // 运动状态
+constexpr uint32_t DATA_TYPE_SYSTEM   = 0x05;  // 系统信息
+
+// ============ 数据结构定义 ============
+#pragma pack(push, 1)
+
+// 通用数据包头
+struct PacketHeader {
+    uint32_t type;        // 数据类型
+    uint32_t length;      // 数据长度
+    uint64_t timestamp;   // 时间戳
+};
+
+// 电池数据
+struct BatteryData {
+    float voltage;        // 电压 (V)
+    float current;        // 电流 (A)
+    float percentage;     // 电量百分比 (0-100)
+    float temperature;    // 温度 (℃)
+};
+
+// IMU数据
+struct IMUData {
+    // 姿态角 (rad)
+    float roll;
+    float pitch;
+    float yaw;
+    // 角速度 (rad/s)
+    float gyro_x;
+    float gyro_y;
+    float gyro_z;
+    // 加速度 (m/s^2)
+    float acc_x;
+    float acc_y;
+    float acc_z;
+};
+
+// 运动状态
+// 暂定布局：接口说明只给出"当前步态、运动模式、速度等"，以下字段顺序、单位及 body_height
+// 均为推测，尚未与真机报文核对。StatusDispatcher 只接受长度恰为 sizeof(MotionData) 的运动状态，
+// 依赖机身高度 / 转向角速度的等待条件与基准在布局确认前只有参考意义
+struct MotionData {
+    uint32_t gait;         // 当前步态
+    uint32_t motion_mode;  // 运动模式
+    float velocity_x;      // 前后速度 (m/s)，前进为正
+    float velocity_y;      // 左右速度 (m/s)，左移为正
+    float yaw_rate;        // 转向角速度 (rad/s)，左转为正
+    float body_height;     // 机身高度 (m)
+};
+
+// 系统信息
+// 暂定布局：仓库中没有系统信息数据体的定义，以下字段（版本、运行时间、里程、故障码）均为推测，
+// 尚未与接口说明或真机报文核对。StatusDispatcher 只接受长度恰为 sizeof(SystemData) 的系统信息
+struct SystemData {
+    uint32_t firmware_version;  // 运动控制固件版本，按字节编码 主.次.修订.构建
+    uint32_t software_version;  // 主控软件版本，编码同上
+    uint32_t uptime_s;          // 本次上电运行时间 (s)
+    float    mileage_km;        // 累计里程 (km)
+    uint32_t error_code;        // 故障码，0 表示无故障
+};
+
+// 单关节数据
+struct JointData {
+    float position;       // 位置 (rad)
+    float velocity;       // 速度 (rad/s)
+    float torque;         // 力矩 (Nm)
+    float temperature;    // 温度 (℃)
+};
+
+#pragma pack(pop)
+
+// ============ 关节数据视图 ============
+// 直接指向接收缓冲区中的关节数组，不拷贝数据；仅在回调期间有效
+struct JointSpan {
+    const JointData* data;
+    size_t size;
+
+    const JointData& operator[](size_t i) const { return data[i]; }
+    const JointData* begin() const { return data; }
+    const JointData* end() const { return data + size; }
+};
+
+} // namespace q25
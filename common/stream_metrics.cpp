@@ -0,0 +1,234 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file stream_metrics.cpp
+ * @brief StreamMetrics 实现
+ */
+
+#include "stream_metrics.h"
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace q25 {
+
+namespace {
+
+constexpr int64_t NO_VALUE = std::numeric_limits<int64_t>::max();
+
+// 周期估计至少基于这么多个间隔后才开始判定间断
+constexpr uint64_t MIN_PACKETS_FOR_GAPS = 8;
+constexpr double GAP_FACTOR = 1.5;
+
+// 时间戳回退超过 RESTART_PERIODS 个周期（周期未知时为 1 秒，且不超过 1 秒）视为流重新开始
+constexpr double RESTART_PERIODS = 50.0;
+constexpr int64_t RESTART_MAX_BACKWARD_NS = 1000000000;
+
+bool isRestart(const StreamStats& s, int64_t robot_ns) {
+    int64_t backward = s.max_robot_ns - robot_ns;
+    if (backward <= 0) {
+        return false;
+    }
+    double threshold = static_cast<double>(RESTART_MAX_BACKWARD_NS);
+    if (s.period_ns > 0.0 && RESTART_PERIODS * s.period_ns < threshold) {
+        threshold = RESTART_PERIODS * s.period_ns;
+    }
+    return static_cast<double>(backward) > threshold;
+}
+
+double toMs(double ns) { return ns / 1e6; }
+double usToMs(uint64_t us) { return static_cast<double>(us) / 1e3; }
+
+} // namespace
+
+constexpr size_t StreamMetrics::STREAM_COUNT;
+
+StreamStats::StreamStats()
+    : packets(0)
+    , interval_packets(0)
+    , gaps(0)
+    , lost_estimate(0)
+    , reorders(0)
+    , duplicates(0)
+    , restarts(0)
+    , jitter_ns(0.0)
+    , period_ns(0.0)
+    , last_recv_ns(0)
+    , last_robot_ns(0)
+    , max_robot_ns(0)
+    , run_packets(0) {}
+
+StreamMetrics::StreamMetrics(const StreamMetricsConfig& config)
+    : config_(config)
+    , offset_min_current_(NO_VALUE)
+    , offset_min_previous_(NO_VALUE)
+    , offset_window_start_ns_(0)
+    , offset_window_ns_(static_cast<int64_t>(config.offset_window_sec * 1e9))
+    , interval_start_ns_(0)
+    , report_interval_ns_(static_cast<int64_t>(config.report_interval_sec * 1e9)) {}
+
+void StreamMetrics::record(const uint8_t* data, size_t len, int64_t recv_time_ns) {
+    if (len < sizeof(PacketHeader)) {
+        return;
+    }
+    PacketHeader header;
+    memcpy(&header, data, sizeof(header));
+    record(header, recv_time_ns);
+}
+
+void StreamMetrics::record(const PacketHeader& header, int64_t recv_time_ns) {
+    if (interval_start_ns_ == 0) {
+        interval_start_ns_ = recv_time_ns;
+    }
+
+    StreamStats& s = streams_[slotOf(header.type)];
+    int64_t robot_ns = static_cast<int64_t>(header.timestamp) * config_.timestamp_unit_ns;
+
+    s.packets++;
+    s.interval_packets++;
+    if (s.run_packets > 0 && isRestart(s, robot_ns)) {
+        restartStream(s);
+    }
+    if (s.run_packets++ > 0) {
+        int64_t robot_delta = robot_ns - s.max_robot_ns;
+        if (robot_delta < 0) {
+            // 乱序包不参与周期、抖动与偏移估计
+            s.reorders++;
+            return;
+        }
+        if (robot_delta == 0) {
+            s.duplicates++;
+            return;
+        }
+
+        // 间断判定基于更新前的周期估计
+        if (s.run_packets > MIN_PACKETS_FOR_GAPS && s.period_ns > 0.0 &&
+            robot_delta > GAP_FACTOR * s.period_ns) {
+            s.gaps++;
+            s.lost_estimate += static_cast<uint64_t>(std::floor(robot_delta / s.period_ns + 0.5)) - 1;
+        } else {
+            s.period_ns = s.period_ns > 0.0 ? s.period_ns + (robot_delta - s.period_ns) / 16.0
+                                            : static_cast<double>(robot_delta);
+        }
+
+        double transit_change = static_cast<double>((recv_time_ns - s.last_recv_ns) -
+                                                    (robot_ns - s.last_robot_ns));
+        s.jitter_ns += (std::fabs(transit_change) - s.jitter_ns) / 16.0;
+    }
+
+    s.last_recv_ns = recv_time_ns;
+    s.last_robot_ns = robot_ns;
+    s.max_robot_ns = robot_ns;
+
+    int64_t offset = recv_time_ns - robot_ns;
+    updateOffset(offset, recv_time_ns);
+
+    uint64_t latency_us = static_cast<uint64_t>((offset - clockOffsetNs()) / 1000);
+    s.latency_interval.record(latency_us);
+    s.latency_total.record(latency_us);
+}
+
+// 之前的周期与偏移基准属于旧时钟，全部丢弃，下一个包按首包处理
+void StreamMetrics::restartStream(StreamStats& s) {
+    s.restarts++;
+    s.run_packets = 0;
+    s.period_ns = 0.0;
+    s.jitter_ns = 0.0;
+    offset_min_current_ = NO_VALUE;
+    offset_min_previous_ = NO_VALUE;
+    offset_window_start_ns_ = 0;
+}
+
+void StreamMetrics::updateOffset(int64_t offset, int64_t recv_time_ns) {
+    if (recv_time_ns - offset_window_start_ns_ >= offset_window_ns_) {
+        offset_min_previous_ = offset_min_current_;
+        offset_min_current_ = NO_VALUE;
+        offset_window_start_ns_ = recv_time_ns;
+    }
+    if (offset < offset_min_current_) {
+        offset_min_current_ = offset;
+    }
+}
+
+int64_t StreamMetrics::clockOffsetNs() const {
+    int64_t base = offset_min_current_ < offset_min_previous_ ? offset_min_current_ : offset_min_previous_;
+    return base == NO_VALUE ? 0 : base;
+}
+
+bool StreamMetrics::reportDue(int64_t now_ns) const {
+    return interval_start_ns_ != 0 && now_ns - interval_start_ns_ >= report_interval_ns_;
+}
+
+const char* StreamMetrics::streamName(size_t slot) {
+    switch (slot) {
+        case DATA_TYPE_BATTERY: return "Battery";
+        case DATA_TYPE_IMU:     return "IMU";
+        case DATA_TYPE_JOINT:   return "Joint";
+        case DATA_TYPE_MOTION:  return "Motion";
+        case DATA_TYPE_SYSTEM:  return "System";
+        default:                return "Other";
+    }
+}
+
+void StreamMetrics::report(std::ostream& out, int64_t now_ns) {
+    double elapsed_sec = static_cast<double>(now_ns - interval_start_ns_) / 1e9;
+    if (elapsed_sec <= 0.0) {
+        elapsed_sec = 1.0;
+    }
+
+    out << std::fixed << std::setprecision(2);
+    out << "[Metrics] interval " << elapsed_sec << "s, latency above best path (ms)" << '\n';
+    for (size_t i = 0; i < STREAM_COUNT; i++) {
+        StreamStats& s = streams_[i];
+        if (s.interval_packets == 0) {
+            continue;
+        }
+        const LatencyHistogram& h = s.latency_interval;
+        out << "[Metrics] " << std::left << std::setw(7) << streamName(i) << std::right
+            << " rate " << s.interval_packets / elapsed_sec << "/s"
+            << ", jitter " << toMs(s.jitter_ns)
+            << ", p50 " << usToMs(h.percentile(50.0))
+            << " p99 " << usToMs(h.percentile(99.0))
+            << " p99.9 " << usToMs(h.percentile(99.9))
+            << " max " << usToMs(h.max())
+            << ", gaps " << s.gaps << " (~" << s.lost_estimate << " lost)"
+            << ", reorder " << s.reorders
+            << ", dup " << s.duplicates
+            << ", restart " << s.restarts << '\n';
+        s.interval_packets = 0;
+        s.latency_interval.reset();
+    }
+    out.flush();
+    interval_start_ns_ = now_ns;
+}
+
+void StreamMetrics::reportTotals(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < STREAM_COUNT; i++) {
+        const StreamStats& s = streams_[i];
+        if (s.packets == 0) {
+            continue;
+        }
+        const LatencyHistogram& h = s.latency_total;
+        out << "[Metrics] " << std::left << std::setw(7) << streamName(i) << std::right
+            << " total " << s.packets
+            << ", p50 " << usToMs(h.percentile(50.0))
+            << " p99 " << usToMs(h.percentile(99.0))
+            << " p99.9 " << usToMs(h.percentile(99.9))
+            << " max " << usToMs(h.max()) << " ms"
+            << ", gaps " << s.gaps << " (~" << s.lost_estimate << " lost)"
+            << ", reorder " << s.reorders
+            << ", dup " << s.duplicates
+            << ", restart " << s.restarts << '\n';
+    }
+    out.flush();
+}
+
+} // namespace q25
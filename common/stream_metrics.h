@@ -0,0 +1,120 @@
+// ====================================================================
+//          Created:    2026/10/14/ 15:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file stream_metrics.h
+ * @brief 按数据类型统计状态流的到达率、抖动、单向延迟与丢包/乱序
+ *
+ * 基于 PacketHeader.timestamp（机器人时钟）与本机接收时间（steady_clock）:
+ *   - 到达率:   每个统计区间内的包数 / 区间时长
+ *   - 抖动:     RFC 3550 到达间隔抖动，J += (|D| - J) / 16，
+ *               D = 本机到达间隔 - 机器人发送间隔
+ *   - 单向延迟: 两端时钟未同步，无法得到绝对值。取 offset = 本机时间 - 机器人时间，
+ *               在滑动窗口内取最小值作为"最快路径"基准，offset - 基准即为
+ *               超出最好情况的排队/调度延迟。窗口随时间滚动以跟随时钟漂移
+ *   - 丢包:     机器人时间戳间隔超过预期周期 1.5 倍视为一次间断，按间隔估算丢失数
+ *   - 乱序:     时间戳小于该流已见过的最大时间戳
+ *   - 重启:     时间戳回退超出乱序范围（50 个周期，最多 1 秒）视为机器人重启或时间戳重置，
+ *               计一次重启后从该包重新估计周期、抖动与偏移基准
+ *
+ * 延迟直方图分"本区间"与"累计"两份，report() 输出本区间后清零。
+ * 若延迟在多个流同时升高，通常是网络或本机；只有单个流的间隔变大则多为机器人端。
+ *
+ * 非线程安全，应在处理线程中调用 record()。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#include "latency_histogram.h"
+#include "status_protocol.h"
+
+namespace q25 {
+
+struct StreamMetricsConfig {
+    int64_t timestamp_unit_ns;   // PacketHeader.timestamp 的单位（纳秒数），默认毫秒
+    double offset_window_sec;    // 时钟偏移最小值滤波窗口
+    double report_interval_sec;  // reportDue() 的周期
+
+    StreamMetricsConfig()
+        : timestamp_unit_ns(1000000)
+        , offset_window_sec(10.0)
+        , report_interval_sec(5.0) {}
+};
+
+// 单个数据类型的统计
+struct StreamStats {
+    uint64_t packets;         // 累计包数
+    uint64_t interval_packets;
+    uint64_t gaps;            // 时间戳间断次数
+    uint64_t lost_estimate;   // 按预期周期估算的丢包数
+    uint64_t reorders;        // 时间戳回退
+    uint64_t duplicates;      // 时间戳重复
+    uint64_t restarts;        // 时间戳大幅回退（机器人重启 / 时间戳重置）
+    double jitter_ns;         // RFC 3550 到达间隔抖动
+    double period_ns;         // 机器人端发送周期估计（时间戳间隔的滑动平均）
+
+    int64_t last_recv_ns;
+    int64_t last_robot_ns;
+    int64_t max_robot_ns;
+    uint64_t run_packets;     // 本次（重新）开始以来的包数
+
+    LatencyHistogram latency_interval;  // 单位: 微秒
+    LatencyHistogram latency_total;
+
+    StreamStats();
+};
+
+class StreamMetrics {
+public:
+    // 数据类型 1~5 各占一个槽，其他类型计入槽 0
+    static constexpr size_t STREAM_COUNT = DATA_TYPE_SYSTEM + 1;
+
+    explicit StreamMetrics(const StreamMetricsConfig& config = StreamMetricsConfig());
+
+    /** @brief 统计一个数据包，recv_time_ns 为 steady_clock 接收时间 */
+    void record(const PacketHeader& header, int64_t recv_time_ns);
+
+    /** @brief 从原始数据包读取包头后统计，长度不足包头时忽略 */
+    void record(const uint8_t* data, size_t len, int64_t recv_time_ns);
+
+    bool reportDue(int64_t now_ns) const;
+
+    /** @brief 输出每个流本区间的统计并开始新的区间 */
+    void report(std::ostream& out, int64_t now_ns);
+
+    /** @brief 输出累计统计（退出时使用） */
+    void reportTotals(std::ostream& out) const;
+
+    const StreamStats& stream(uint32_t type) const { return streams_[slotOf(type)]; }
+
+    // 当前时钟偏移基准（本机 - 机器人，纳秒），尚无数据时返回 0
+    int64_t clockOffsetNs() const;
+
+private:
+    static size_t slotOf(uint32_t type) { return type < STREAM_COUNT ? type : 0; }
+    static const char* streamName(size_t slot);
+
+    void updateOffset(int64_t offset, int64_t recv_time_ns);
+    void restartStream(StreamStats& s);
+
+    StreamMetricsConfig config_;
+    StreamStats streams_[STREAM_COUNT];
+
+    // 两段窗口最小值滤波：当前窗口与上一窗口取较小者
+    int64_t offset_min_current_;
+    int64_t offset_min_previous_;
+    int64_t offset_window_start_ns_;
+    int64_t offset_window_ns_;
+
+    int64_t interval_start_ns_;
+    int64_t report_interval_ns_;
+};
+
+} // namespace q25
@@ -0,0 +1,109 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_format.h
+ * @brief 遥测记录文件格式 (.q25tlm)
+ *
+ * 每个段文件按固定大小预分配，布局为:
+ *
+ *   [SegmentHeader, 填充到 chunk_bytes][Chunk 0][Chunk 1]...[Chunk N-1]
+ *
+ * 每个 Chunk 固定 chunk_bytes 字节:
+ *
+ *   [ChunkHeader][RecordHeader + 数据报, 8 字节对齐]...
+ *
+ * ChunkHeader 即该块的索引: 各数据类型的包数、本机接收时间与机器人时间戳的范围。
+ * 按类型或时间查找时只需按 chunk_bytes 步长读取块头，无需扫描记录。
+ *
+ * 写入顺序保证崩溃后也能读出已写入的前缀: 先写记录内容，再更新块头的
+ * record_count / used_bytes，最后更新段头的 chunk_count。
+ * 正常关闭时段文件被截断到实际使用的长度。
+ *
+ * 所有字段为小端序（与 x86 主机一致）。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace q25 {
+
+constexpr uint64_t TELEMETRY_SEGMENT_MAGIC = 0x31304d4c54353251ULL;  // "Q25TLM01"
+constexpr uint32_t TELEMETRY_CHUNK_MAGIC   = 0x4b4e4843;             // "CHNK"
+constexpr uint32_t TELEMETRY_VERSION       = 1;
+
+// 记录数据报时 8 字节对齐
+constexpr uint32_t TELEMETRY_RECORD_ALIGN = 8;
+
+// 块索引中的类型槽: DATA_TYPE_* (1~5) 各占一槽，0 为未识别类型，最后一槽为其他类型
+constexpr uint32_t TELEMETRY_TYPE_SLOTS = 8;
+
+// 记录来源通道，同一段文件只包含一种
+constexpr uint16_t TELEMETRY_CHANNEL_STATUS  = 0;  // 机器人上报的状态数据报
+constexpr uint16_t TELEMETRY_CHANNEL_COMMAND = 1;  // 本机发出的控制指令
+
+// 段头标志
+constexpr uint32_t TELEMETRY_SEGMENT_CLOSED = 0x1;  // 已正常关闭（文件已截断）
+
+#pragma pack(push, 1)
+
+struct TelemetrySegmentHeader {
+    uint64_t magic;            // TELEMETRY_SEGMENT_MAGIC
+    uint32_t version;          // TELEMETRY_VERSION
+    uint32_t flags;            // TELEMETRY_SEGMENT_*
+    uint32_t segment_index;    // 本次记录中的段序号，从 0 开始
+    uint32_t chunk_bytes;      // 每块字节数，同时是段头区域的大小
+    uint32_t chunk_count;      // 已开始写入的块数
+    uint16_t channel;          // TELEMETRY_CHANNEL_*
+    uint16_t reserved0;
+    int64_t  created_unix_ns;  // 段创建时的系统时间，便于把 steady_clock 换算为绝对时间
+    int64_t  created_steady_ns;
+    uint64_t record_count;     // 段内记录总数
+    int64_t  first_recv_ns;    // 段内第一条/最后一条记录的本机接收时间
+    int64_t  last_recv_ns;
+    uint8_t  reserved[56];
+};
+
+struct TelemetryChunkHeader {
+    uint32_t magic;            // TELEMETRY_CHUNK_MAGIC
+    uint32_t record_count;
+    uint32_t used_bytes;       // 块头之后已使用的字节数
+    uint32_t type_mask;        // 第 i 位表示含有类型槽 i 的记录
+    int64_t  first_recv_ns;    // 本机接收时间范围（steady_clock）
+    int64_t  last_recv_ns;
+    uint64_t first_robot_ts;   // PacketHeader.timestamp 范围（最小/最大值）
+    uint64_t last_robot_ts;
+    uint32_t type_counts[TELEMETRY_TYPE_SLOTS];
+};
+
+struct TelemetryRecordHeader {
+    uint32_t length;           // 数据报字节数（不含本头和对齐填充）
+    uint32_t from_addr;        // 发送方 IPv4 地址（网络字节序），指令通道为 0
+    uint16_t from_port;        // 发送方端口（网络字节序）
+    uint16_t channel;          // TELEMETRY_CHANNEL_*
+    uint32_t reserved;
+    int64_t  recv_time_ns;     // 本机接收/发送时间（steady_clock）
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(TelemetrySegmentHeader) == 128, "TelemetrySegmentHeader must be 128 bytes");
+static_assert(sizeof(TelemetryChunkHeader) == 80, "TelemetryChunkHeader must be 80 bytes");
+static_assert(sizeof(TelemetryRecordHeader) == 24, "TelemetryRecordHeader must be 24 bytes");
+
+// 数据报所属的类型槽
+inline uint32_t telemetryTypeSlot(uint32_t packet_type) {
+    return packet_type < TELEMETRY_TYPE_SLOTS - 1 ? packet_type : TELEMETRY_TYPE_SLOTS - 1;
+}
+
+// 一条记录占用的字节数（含记录头与对齐填充）
+inline uint32_t telemetryRecordSize(uint32_t length) {
+    uint32_t size = static_cast<uint32_t>(sizeof(TelemetryRecordHeader)) + length;
+    return (size + TELEMETRY_RECORD_ALIGN - 1) & ~(TELEMETRY_RECORD_ALIGN - 1);
+}
+
+} // namespace q25
@@ -0,0 +1,252 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_reader.cpp
+ * @brief TelemetryReader 实现
+ */
+
+#include "telemetry_reader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "status_protocol.h"
+
+namespace q25 {
+
+namespace {
+
+const char* SEGMENT_SUFFIX = ".q25tlm";
+constexpr size_t SEGMENT_INDEX_DIGITS = 4;
+
+} // namespace
+
+TelemetryReader::TelemetryReader()
+    : follow_segments_(true)
+    , type_filter_(TELEMETRY_ALL_TYPES)
+    , min_recv_ns_(std::numeric_limits<int64_t>::min())
+    , chunk_index_(0)
+    , chunk_begin_(nullptr)
+    , chunk_used_(0)
+    , chunk_records_(0)
+    , record_offset_(0)
+    , record_in_chunk_(0) {
+    memset(&segment_, 0, sizeof(segment_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+bool TelemetryReader::open(const std::string& path, bool follow_segments) {
+    close();
+    follow_segments_ = follow_segments;
+    min_recv_ns_ = std::numeric_limits<int64_t>::min();
+    memset(&stats_, 0, sizeof(stats_));
+    return openSegment(path);
+}
+
+void TelemetryReader::close() {
+    file_.close();
+    chunk_begin_ = nullptr;
+    chunk_used_ = 0;
+    chunk_records_ = 0;
+}
+
+std::string TelemetryReader::nextSegmentPath(const std::string& path) {
+    size_t suffix_len = strlen(SEGMENT_SUFFIX);
+    if (path.size() < suffix_len + SEGMENT_INDEX_DIGITS ||
+        path.compare(path.size() - suffix_len, suffix_len, SEGMENT_SUFFIX) != 0) {
+        return std::string();
+    }
+    size_t digits_begin = path.size() - suffix_len - SEGMENT_INDEX_DIGITS;
+    unsigned index = 0;
+    for (size_t i = digits_begin; i < digits_begin + SEGMENT_INDEX_DIGITS; i++) {
+        if (path[i] < '0' || path[i] > '9') {
+            return std::string();
+        }
+        index = index * 10 + static_cast<unsigned>(path[i] - '0');
+    }
+    char digits[16];
+    snprintf(digits, sizeof(digits), "%04u", index + 1);
+    return path.substr(0, digits_begin) + digits + SEGMENT_SUFFIX;
+}
+
+bool TelemetryReader::openSegment(const std::string& path) {
+    if (!file_.openReadOnly(path)) {
+        return false;
+    }
+    if (file_.size() < sizeof(TelemetrySegmentHeader)) {
+        std::cerr << "[ERROR] Not a telemetry segment: " << path << std::endl;
+        file_.close();
+        return false;
+    }
+    memcpy(&segment_, file_.data(), sizeof(segment_));
+    if (segment_.magic != TELEMETRY_SEGMENT_MAGIC || segment_.version != TELEMETRY_VERSION ||
+        segment_.chunk_bytes < sizeof(TelemetryChunkHeader)) {
+        std::cerr << "[ERROR] Unsupported telemetry segment: " << path << std::endl;
+        file_.close();
+        return false;
+    }
+
+    stats_.segments++;
+    chunk_index_ = 0;
+    return loadChunk(0) || advanceChunk();
+}
+
+bool TelemetryReader::nextSegment() {
+    if (!follow_segments_) {
+        return false;
+    }
+    std::string next_path = nextSegmentPath(file_.path());
+    if (next_path.empty()) {
+        return false;
+    }
+    // 后续段不存在即为读完，不视为错误
+    FILE* probe = fopen(next_path.c_str(), "rb");
+    if (probe == nullptr) {
+        return false;
+    }
+    fclose(probe);
+    close();
+    return openSegment(next_path);
+}
+
+bool TelemetryReader::chunkWanted(const TelemetryChunkHeader& chunk) const {
+    if ((chunk.type_mask & type_filter_) == 0) {
+        return false;
+    }
+    return chunk.record_count > 0 && chunk.last_recv_ns >= min_recv_ns_;
+}
+
+// 载入当前段的第 chunk_index 块；块不存在、损坏或不符合过滤条件时返回 false
+bool TelemetryReader::loadChunk(uint32_t chunk_index) {
+    chunk_index_ = chunk_index;
+    chunk_begin_ = nullptr;
+    chunk_used_ = 0;
+    chunk_records_ = 0;
+    record_offset_ = 0;
+    record_in_chunk_ = 0;
+
+    if (chunk_index >= segment_.chunk_count) {
+        return false;
+    }
+    size_t offset = static_cast<size_t>(chunk_index + 1) * segment_.chunk_bytes;
+    if (offset + sizeof(TelemetryChunkHeader) > file_.size()) {
+        return false;
+    }
+
+    TelemetryChunkHeader chunk;
+    memcpy(&chunk, file_.data() + offset, sizeof(chunk));
+    if (chunk.magic != TELEMETRY_CHUNK_MAGIC) {
+        stats_.corrupt++;
+        return false;
+    }
+    if (!chunkWanted(chunk)) {
+        stats_.chunks_skipped++;
+        return false;
+    }
+
+    // 截断或崩溃的段：可读长度以文件实际长度为准
+    size_t available = file_.size() - offset - sizeof(TelemetryChunkHeader);
+    size_t capacity = segment_.chunk_bytes - sizeof(TelemetryChunkHeader);
+    if (chunk.used_bytes > capacity || chunk.used_bytes > available) {
+        stats_.corrupt++;
+        chunk.used_bytes = static_cast<uint32_t>(available < capacity ? available : capacity);
+    }
+
+    chunk_begin_ = file_.data() + offset + sizeof(TelemetryChunkHeader);
+    chunk_used_ = chunk.used_bytes;
+    chunk_records_ = chunk.record_count;
+    return true;
+}
+
+bool TelemetryReader::advanceChunk() {
+    for (;;) {
+        while (chunk_index_ + 1 < segment_.chunk_count) {
+            if (loadChunk(chunk_index_ + 1)) {
+                return true;
+            }
+        }
+        if (!nextSegment()) {
+            return false;
+        }
+        if (chunk_begin_ != nullptr) {
+            return true;
+        }
+    }
+}
+
+bool TelemetryReader::peekRecord(TelemetryRecord& record, uint32_t& record_size) {
+    if (chunk_begin_ == nullptr || record_in_chunk_ >= chunk_records_ ||
+        record_offset_ + sizeof(TelemetryRecordHeader) > chunk_used_) {
+        return false;
+    }
+    const TelemetryRecordHeader* header =
+        reinterpret_cast<const TelemetryRecordHeader*>(chunk_begin_ + record_offset_);
+    record_size = telemetryRecordSize(header->length);
+    if (header->length > chunk_used_ || record_offset_ + record_size > chunk_used_) {
+        stats_.corrupt++;
+        return false;
+    }
+    record.header = header;
+    record.data = chunk_begin_ + record_offset_ + sizeof(TelemetryRecordHeader);
+    record.segment_index = segment_.segment_index;
+    return true;
+}
+
+bool TelemetryReader::recordWanted(const TelemetryRecordHeader& header, const uint8_t* data) const {
+    if (header.recv_time_ns < min_recv_ns_) {
+        return false;
+    }
+    if (type_filter_ == TELEMETRY_ALL_TYPES) {
+        return true;
+    }
+    uint32_t type_slot = 0;
+    if (header.channel == TELEMETRY_CHANNEL_STATUS && header.length >= sizeof(PacketHeader)) {
+        PacketHeader packet;
+        memcpy(&packet, data, sizeof(packet));
+        type_slot = telemetryTypeSlot(packet.type);
+    }
+    return (type_filter_ & (1u << type_slot)) != 0;
+}
+
+bool TelemetryReader::next(TelemetryRecord& record) {
+    for (;;) {
+        uint32_t record_size = 0;
+        if (!peekRecord(record, record_size)) {
+            if (!advanceChunk()) {
+                return false;
+            }
+            continue;
+        }
+        record_offset_ += record_size;
+        record_in_chunk_++;
+        if (recordWanted(*record.header, record.data)) {
+            stats_.records++;
+            return true;
+        }
+    }
+}
+
+bool TelemetryReader::seekTime(int64_t recv_time_ns) {
+    min_recv_ns_ = recv_time_ns;
+
+    // 整段跳过：段头的时间范围已覆盖不到目标时间
+    while (segment_.record_count > 0 && segment_.last_recv_ns < recv_time_ns) {
+        if (!nextSegment()) {
+            return false;
+        }
+    }
+
+    // 当前块不含目标时间时由 advanceChunk 按块头跳过
+    if (chunk_begin_ == nullptr) {
+        return advanceChunk();
+    }
+    return true;
+}
+
+} // namespace q25
@@ -0,0 +1,113 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_reader.h
+ * @brief 遥测段文件 (.q25tlm) 顺序读取与按类型/时间跳块
+ *
+ * 只读映射段文件，next() 返回的记录直接指向映射内存，不发生拷贝，
+ * 在切换到下一个段文件或 close() 之前有效。
+ *
+ * 打开第一个段文件后可自动按文件名中的段序号继续读取后续段
+ * (..._0000.q25tlm -> ..._0001.q25tlm)。未正常关闭（崩溃）的段同样可读，
+ * 读到块头记录的已提交长度为止。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mapped_file.h"
+#include "telemetry_format.h"
+
+namespace q25 {
+
+constexpr uint32_t TELEMETRY_ALL_TYPES = 0xFFFFFFFFu;
+
+struct TelemetryRecord {
+    const TelemetryRecordHeader* header;
+    const uint8_t* data;     // 数据报内容，长度为 header->length
+    uint32_t segment_index;
+};
+
+struct TelemetryReaderStats {
+    uint64_t records;         // 已返回的记录
+    uint64_t segments;        // 已打开的段文件
+    uint64_t chunks_skipped;  // 按类型/时间整块跳过的块
+    uint64_t corrupt;         // 长度越界等损坏的块（其后内容被跳过）
+};
+
+class TelemetryReader {
+public:
+    TelemetryReader();
+
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    /**
+     * @brief 打开段文件
+     * @param follow_segments 当前段读完后是否继续读取下一个序号的段文件
+     */
+    bool open(const std::string& path, bool follow_segments = true);
+    void close();
+
+    /**
+     * @brief 只返回指定类型槽的记录（第 i 位对应 telemetryTypeSlot() == i）
+     *
+     * 块头 type_mask 与过滤条件无交集的块整块跳过。
+     */
+    void setTypeFilter(uint32_t type_mask) { type_filter_ = type_mask; }
+
+    /**
+     * @brief 定位到第一条接收时间 >= recv_time_ns 的记录
+     *
+     * 先按段头、块头的时间范围整段/整块跳过，再在块内逐条查找。
+     * 只能向后定位。
+     */
+    bool seekTime(int64_t recv_time_ns);
+
+    /** @brief 读取下一条记录，全部读完时返回 false */
+    bool next(TelemetryRecord& record);
+
+    // 当前段信息
+    const TelemetrySegmentHeader& segmentHeader() const { return segment_; }
+    const std::string& currentPath() const { return file_.path(); }
+
+    const TelemetryReaderStats& stats() const { return stats_; }
+
+    // 按段序号推导下一个段文件名，不符合命名规则时返回空串
+    static std::string nextSegmentPath(const std::string& path);
+
+private:
+    bool openSegment(const std::string& path);
+    bool nextSegment();
+    bool loadChunk(uint32_t chunk_index);
+    bool advanceChunk();
+    bool chunkWanted(const TelemetryChunkHeader& chunk) const;
+    bool recordWanted(const TelemetryRecordHeader& header, const uint8_t* data) const;
+    // 取出当前位置的记录（不做过滤），当前块读完或损坏时返回 false
+    bool peekRecord(TelemetryRecord& record, uint32_t& record_size);
+
+    MappedFile file_;
+    bool follow_segments_;
+    TelemetrySegmentHeader segment_;
+    uint32_t type_filter_;
+    int64_t min_recv_ns_;
+
+    // 当前块
+    uint32_t chunk_index_;
+    const uint8_t* chunk_begin_;   // 块头之后的第一条记录
+    uint32_t chunk_used_;          // 块内可读字节数
+    uint32_t chunk_records_;
+    uint32_t record_offset_;
+    uint32_t record_in_chunk_;
+
+    TelemetryReaderStats stats_;
+};
+
+} // namespace q25
@@ -0,0 +1,322 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_recorder.cpp
+ * @brief TelemetryRecorder 实现
+ */
+
+#include "telemetry_recorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <new>
+
+#include "status_protocol.h"
+#include "thread_utils.h"
+
+namespace q25 {
+
+namespace {
+
+constexpr size_t PAGE_BYTES = 4096;
+
+// 段文件创建失败（如磁盘已满）后的重试间隔，期间收到的记录计入丢弃
+constexpr int64_t SEGMENT_RETRY_NS = 1000000000;
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// 块至少能放下段头，以及一条最大长度的记录
+size_t normalizeChunkBytes(const TelemetryRecorderConfig& config) {
+    size_t min_bytes = sizeof(TelemetryChunkHeader) +
+                       telemetryRecordSize(static_cast<uint32_t>(config.slot_size));
+    if (min_bytes < sizeof(TelemetrySegmentHeader)) {
+        min_bytes = sizeof(TelemetrySegmentHeader);
+    }
+    size_t bytes = config.chunk_bytes > min_bytes ? config.chunk_bytes : min_bytes;
+    return roundUp(bytes, PAGE_BYTES);
+}
+
+// 段至少包含段头区域与一个块
+size_t normalizeSegmentBytes(const TelemetryRecorderConfig& config, size_t chunk_bytes) {
+    size_t bytes = roundUp(config.segment_bytes, chunk_bytes);
+    return bytes >= 2 * chunk_bytes ? bytes : 2 * chunk_bytes;
+}
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t unixNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string currentTimeStamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y%m%d_%H%M%S", &local);
+    return buffer;
+}
+
+} // namespace
+
+TelemetryRecorder::TelemetryRecorder(const TelemetryRecorderConfig& config)
+    : config_(config)
+    , ring_(nullptr)
+    , running_(false)
+    , segment_index_(0)
+    , segment_(nullptr)
+    , chunk_(nullptr)
+    , chunk_offset_(0)
+    , next_retry_ns_(0)
+    , records_(0)
+    , bytes_(0)
+    , segments_(0)
+    , chunks_(0)
+    , errors_(0)
+    , unwritten_(0) {
+    config_.chunk_bytes = normalizeChunkBytes(config_);
+    config_.segment_bytes = normalizeSegmentBytes(config_, config_.chunk_bytes);
+}
+
+TelemetryRecorder::~TelemetryRecorder() {
+    stop();
+    if (ring_ != nullptr) {
+        ring_->~PacketRing();
+        alignedFree(ring_);
+    }
+}
+
+bool TelemetryRecorder::start() {
+    if (running_) {
+        return true;
+    }
+
+    if (ring_ == nullptr) {
+        void* memory = alignedAlloc(sizeof(PacketRing), CACHE_LINE_SIZE);
+        if (memory == nullptr) {
+            std::cerr << "[ERROR] Failed to allocate telemetry buffer" << std::endl;
+            return false;
+        }
+        ring_ = new (memory) PacketRing(config_.ring_capacity, config_.slot_size);
+    }
+
+    session_stamp_ = currentTimeStamp();
+    segment_index_ = 0;
+    if (!openSegment()) {
+        return false;
+    }
+
+    running_ = true;
+    thread_ = std::thread(&TelemetryRecorder::run, this);
+    return true;
+}
+
+void TelemetryRecorder::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeSegment();
+}
+
+bool TelemetryRecorder::record(const uint8_t* data, size_t len, uint32_t from_addr,
+                               uint16_t from_port, int64_t recv_time_ns) {
+    if (ring_ == nullptr) {
+        return false;
+    }
+    return ring_->push(data, len, from_addr, from_port, recv_time_ns);
+}
+
+TelemetryRecorderStats TelemetryRecorder::stats() const {
+    PacketRingStats ring_stats = {};
+    if (ring_ != nullptr) {
+        ring_stats = ring_->stats();
+    }
+    TelemetryRecorderStats stats;
+    stats.records = records_.load(std::memory_order_relaxed);
+    stats.bytes = bytes_.load(std::memory_order_relaxed);
+    stats.dropped = ring_stats.overflows + unwritten_.load(std::memory_order_relaxed);
+    stats.oversized = ring_stats.oversized;
+    stats.segments = segments_.load(std::memory_order_relaxed);
+    stats.chunks = chunks_.load(std::memory_order_relaxed);
+    stats.errors = errors_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ============ 写入线程 ============
+
+void TelemetryRecorder::run() {
+    pinCurrentThread(config_.cpu_core);
+
+    // 停止后继续写完环中剩余的记录
+    for (;;) {
+        PacketSlot* slot = ring_->peek();
+        if (slot == nullptr) {
+            if (!running_) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (segment_ == nullptr) {
+            retrySegment();
+        }
+        if (segment_ == nullptr || !append(*slot)) {
+            unwritten_++;
+        }
+        ring_->release();
+    }
+}
+
+bool TelemetryRecorder::openSegment() {
+    char name[64];
+    snprintf(name, sizeof(name), "_%s_%04u.q25tlm", session_stamp_.c_str(), segment_index_);
+    std::string path = config_.directory + "/" + config_.prefix + name;
+
+    if (!file_.create(path, config_.segment_bytes)) {
+        errors_++;
+        segment_ = nullptr;
+        chunk_ = nullptr;
+        return false;
+    }
+
+    segment_ = reinterpret_cast<TelemetrySegmentHeader*>(file_.data());
+    memset(segment_, 0, sizeof(TelemetrySegmentHeader));
+    segment_->magic = TELEMETRY_SEGMENT_MAGIC;
+    segment_->version = TELEMETRY_VERSION;
+    segment_->segment_index = segment_index_;
+    segment_->chunk_bytes = static_cast<uint32_t>(config_.chunk_bytes);
+    segment_->channel = config_.channel;
+    segment_->created_unix_ns = unixNowNs();
+    segment_->created_steady_ns = steadyNowNs();
+
+    segments_++;
+    beginChunk(config_.chunk_bytes);
+    std::cout << "[INFO] Recording telemetry to " << path << std::endl;
+    return true;
+}
+
+void TelemetryRecorder::retrySegment() {
+    int64_t now_ns = steadyNowNs();
+    if (now_ns < next_retry_ns_) {
+        return;
+    }
+    if (!openSegment()) {
+        next_retry_ns_ = now_ns + SEGMENT_RETRY_NS;
+    }
+}
+
+void TelemetryRecorder::closeSegment() {
+    if (segment_ == nullptr) {
+        return;
+    }
+    // 截断到最后一个块实际使用的位置
+    size_t used = chunk_offset_ + sizeof(TelemetryChunkHeader) + chunk_->used_bytes;
+    segment_->flags |= TELEMETRY_SEGMENT_CLOSED;
+    file_.flush(0, used);
+    file_.close(used);
+    segment_ = nullptr;
+    chunk_ = nullptr;
+}
+
+void TelemetryRecorder::beginChunk(size_t offset) {
+    chunk_offset_ = offset;
+    chunk_ = reinterpret_cast<TelemetryChunkHeader*>(file_.data() + offset);
+    memset(chunk_, 0, sizeof(TelemetryChunkHeader));
+    chunk_->magic = TELEMETRY_CHUNK_MAGIC;
+    segment_->chunk_count++;
+    chunks_++;
+}
+
+bool TelemetryRecorder::append(const PacketSlot& slot) {
+    uint32_t record_size = telemetryRecordSize(slot.len);
+    size_t chunk_capacity = config_.chunk_bytes - sizeof(TelemetryChunkHeader);
+
+    if (chunk_->used_bytes + record_size > chunk_capacity) {
+        size_t next = chunk_offset_ + config_.chunk_bytes;
+        if (next + config_.chunk_bytes > file_.size()) {
+            // 段已写满，滚动到新文件；创建失败时丢弃记录，写入线程之后按间隔重试
+            closeSegment();
+            segment_index_++;
+            if (!openSegment()) {
+                next_retry_ns_ = steadyNowNs() + SEGMENT_RETRY_NS;
+                return false;
+            }
+        } else {
+            beginChunk(next);
+        }
+    }
+
+    // 先写记录内容
+    uint8_t* dest = reinterpret_cast<uint8_t*>(chunk_) + sizeof(TelemetryChunkHeader) + chunk_->used_bytes;
+    TelemetryRecordHeader record;
+    record.length = slot.len;
+    record.from_addr = slot.from_addr;
+    record.from_port = slot.from_port;
+    record.channel = config_.channel;
+    record.reserved = 0;
+    record.recv_time_ns = slot.recv_time_ns;
+    memcpy(dest, &record, sizeof(record));
+    memcpy(dest + sizeof(record), slot.data, slot.len);
+
+    // 再更新块索引
+    uint32_t type_slot = 0;
+    bool has_robot_ts = false;
+    uint64_t robot_ts = 0;
+    if (config_.channel == TELEMETRY_CHANNEL_STATUS && slot.len >= sizeof(PacketHeader)) {
+        PacketHeader header;
+        memcpy(&header, slot.data, sizeof(header));
+        type_slot = telemetryTypeSlot(header.type);
+        robot_ts = header.timestamp;
+        has_robot_ts = true;
+    }
+
+    if (chunk_->record_count == 0) {
+        chunk_->first_recv_ns = slot.recv_time_ns;
+        if (has_robot_ts) {
+            chunk_->first_robot_ts = robot_ts;
+            chunk_->last_robot_ts = robot_ts;
+        }
+    } else if (has_robot_ts) {
+        if (robot_ts < chunk_->first_robot_ts) chunk_->first_robot_ts = robot_ts;
+        if (robot_ts > chunk_->last_robot_ts) chunk_->last_robot_ts = robot_ts;
+    }
+    chunk_->last_recv_ns = slot.recv_time_ns;
+    chunk_->type_mask |= 1u << type_slot;
+    chunk_->type_counts[type_slot]++;
+    chunk_->used_bytes += record_size;
+    chunk_->record_count++;
+
+    // 最后更新段头
+    if (segment_->record_count == 0) {
+        segment_->first_recv_ns = slot.recv_time_ns;
+    }
+    segment_->last_recv_ns = slot.recv_time_ns;
+    segment_->record_count++;
+
+    records_++;
+    bytes_ += slot.len;
+    return true;
+}
+
+} // namespace q25
@@ -0,0 +1,125 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_recorder.h
+ * @brief 原始数据报遥测记录器（内存映射、仅追加、分块索引、按大小滚动）
+ *
+ * record() 只把数据报拷贝进记录器自己的 PacketRing 后立即返回，环满时丢弃计数，
+ * 不会阻塞调用方（接收线程）。独立的写入线程把记录追加到预分配并映射到内存的
+ * 段文件中，写入即内存拷贝，不经过逐条的 write() 系统调用。
+ *
+ * 文件格式见 telemetry_format.h。段文件写满后自动滚动到下一个文件:
+ *   <directory>/<prefix>_<YYYYMMDD_HHMMSS>_<段序号>.q25tlm
+ *
+ * record() 为单生产者接口；需要同时记录多个来源时使用多个记录器实例
+ * （不同 prefix / channel）。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "mapped_file.h"
+#include "packet_ring.h"
+#include "telemetry_format.h"
+
+namespace q25 {
+
+struct TelemetryRecorderConfig {
+    std::string directory;  // 输出目录（需已存在）
+    std::string prefix;     // 文件名前缀
+    uint16_t channel;       // TELEMETRY_CHANNEL_*
+    size_t segment_bytes;   // 段文件预分配大小，取整为 chunk_bytes 的倍数
+    size_t chunk_bytes;     // 块大小，取整为 4KB 的倍数
+    size_t ring_capacity;   // 写入线程前的缓冲槽位数
+    size_t slot_size;       // 每槽最大数据报字节数
+    int cpu_core;           // 写入线程绑定的 CPU 核，-1 不绑定
+
+    TelemetryRecorderConfig()
+        : directory(".")
+        , prefix("telemetry")
+        , channel(TELEMETRY_CHANNEL_STATUS)
+        , segment_bytes(256u * 1024 * 1024)
+        , chunk_bytes(1024u * 1024)
+        , ring_capacity(4096)
+        , slot_size(4096)
+        , cpu_core(-1) {}
+};
+
+struct TelemetryRecorderStats {
+    uint64_t records;    // 已写入文件的记录
+    uint64_t bytes;      // 已写入的数据报字节数
+    uint64_t dropped;    // 缓冲环满，或段文件滚动失败、暂无可写文件而丢弃
+    uint64_t oversized;  // 超过槽位大小丢弃
+    uint64_t segments;   // 已创建的段文件
+    uint64_t chunks;     // 已开始写入的块
+    uint64_t errors;     // 段文件创建失败等
+};
+
+class TelemetryRecorder {
+public:
+    explicit TelemetryRecorder(const TelemetryRecorderConfig& config = TelemetryRecorderConfig());
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    /** @brief 分配缓冲环、创建第一个段文件并启动写入线程 */
+    bool start();
+
+    /** @brief 写完缓冲中剩余的记录后关闭段文件，可重复调用 */
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 提交一条记录（单生产者，非阻塞）
+     * @return 未启动、缓冲环满或数据报过长时返回 false
+     */
+    bool record(const uint8_t* data, size_t len, uint32_t from_addr, uint16_t from_port,
+                int64_t recv_time_ns);
+
+    TelemetryRecorderStats stats() const;
+
+private:
+    void run();
+    bool openSegment();
+    void closeSegment();
+    void beginChunk(size_t offset);
+    // 段文件滚动失败时返回 false，记录未写入
+    bool append(const PacketSlot& slot);
+    // 没有可写段文件时按间隔重试创建
+    void retrySegment();
+
+    TelemetryRecorderConfig config_;
+    // 缓冲环在 start() 时才分配（按缓存行对齐），未启用记录时不占内存
+    PacketRing* ring_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    // 以下仅写入线程访问
+    MappedFile file_;
+    std::string session_stamp_;
+    uint32_t segment_index_;
+    TelemetrySegmentHeader* segment_;
+    TelemetryChunkHeader* chunk_;
+    size_t chunk_offset_;
+    int64_t next_retry_ns_;
+
+    std::atomic<uint64_t> records_;
+    std::atomic<uint64_t> bytes_;
+    std::atomic<uint64_t> segments_;
+    std::atomic<uint64_t> chunks_;
+    std::atomic<uint64_t> errors_;
+    std::atomic<uint64_t> unwritten_;
+};
+
+} // namespace q25
@@ -0,0 +1,109 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_replay.cpp
+ * @brief TelemetryReplayer 实现
+ */
+
+#include "telemetry_replay.h"
+
+#include <chrono>
+#include <thread>
+
+namespace q25 {
+
+namespace {
+
+// 距目标时间超过该值时睡眠，剩余部分让出 CPU 轮询
+constexpr int64_t SLEEP_MARGIN_NS = 2000000;
+constexpr int64_t LATE_THRESHOLD_NS = 1000000;
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+TelemetryReplayer::TelemetryReplayer(TelemetryReader& reader, const TelemetryReplayConfig& config)
+    : reader_(reader)
+    , config_(config)
+    , started_(false)
+    , first_recv_ns_(0)
+    , start_ns_(0) {
+    stats_.records = 0;
+    stats_.late = 0;
+    stats_.recorded_ns = 0;
+    stats_.elapsed_ns = 0;
+}
+
+void TelemetryReplayer::waitUntil(int64_t target_ns) {
+    int64_t remaining = target_ns - steadyNowNs();
+    if (remaining > SLEEP_MARGIN_NS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - SLEEP_MARGIN_NS / 2));
+    }
+    while (steadyNowNs() < target_ns) {
+        std::this_thread::yield();
+    }
+}
+
+uint64_t TelemetryReplayer::run(const RecordHandler& handler, const std::atomic<bool>* running) {
+    uint64_t delivered = 0;
+    TelemetryRecord record;
+
+    while (running == nullptr || running->load(std::memory_order_relaxed)) {
+        if (config_.max_records > 0 && stats_.records >= config_.max_records) {
+            break;
+        }
+        if (!reader_.next(record)) {
+            break;
+        }
+
+        int64_t recv_ns = record.header->recv_time_ns;
+        if (!started_) {
+            started_ = true;
+            first_recv_ns_ = recv_ns;
+            start_ns_ = steadyNowNs();
+        }
+
+        if (config_.speed > 0.0) {
+            int64_t offset = static_cast<int64_t>(static_cast<double>(recv_ns - first_recv_ns_) / config_.speed);
+            int64_t target = start_ns_ + offset;
+            if (steadyNowNs() - target > LATE_THRESHOLD_NS) {
+                stats_.late++;
+            } else {
+                waitUntil(target);
+            }
+        }
+
+        handler(record);
+        delivered++;
+        stats_.records++;
+        stats_.recorded_ns = recv_ns - first_recv_ns_;
+        stats_.elapsed_ns = steadyNowNs() - start_ns_;
+    }
+    return delivered;
+}
+
+bool TelemetryReplayer::step(const RecordHandler& handler) {
+    TelemetryRecord record;
+    if (!reader_.next(record)) {
+        return false;
+    }
+    if (!started_) {
+        started_ = true;
+        first_recv_ns_ = record.header->recv_time_ns;
+        start_ns_ = steadyNowNs();
+    }
+    handler(record);
+    stats_.records++;
+    stats_.recorded_ns = record.header->recv_time_ns - first_recv_ns_;
+    stats_.elapsed_ns = steadyNowNs() - start_ns_;
+    return true;
+}
+
+} // namespace q25
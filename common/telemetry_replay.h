@@ -0,0 +1,75 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_replay.h
+ * @brief 遥测记录回放：按原始节奏、N 倍速、尽快或单步把记录交给处理函数
+ *
+ * 回放是确定性的：记录按文件顺序逐条交付，数据内容与记录时完全一致，
+ * 速度只影响两条记录之间的等待时间。处理函数在调用 run()/step() 的线程中
+ * 同步执行，通常直接调用 StatusDispatcher::parsePacket()，走与实时接收相同的订阅路径。
+ *
+ * 定时以第一条记录为基准: 第 i 条记录在 (recv_i - recv_0) / speed 时交付，
+ * 处理函数变慢不会累积漂移；落后于计划时立即交付并计入 late。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "telemetry_reader.h"
+
+namespace q25 {
+
+struct TelemetryReplayConfig {
+    double speed;       // 回放倍速，1.0 为原始节奏；<= 0 表示不等待、尽快回放
+    uint64_t max_records;  // 最多回放的记录数，0 表示不限
+
+    TelemetryReplayConfig()
+        : speed(1.0)
+        , max_records(0) {}
+};
+
+struct TelemetryReplayStats {
+    uint64_t records;       // 已交付的记录
+    uint64_t late;          // 交付时已晚于计划超过 1ms 的记录
+    int64_t  recorded_ns;   // 已回放记录覆盖的原始时长
+    int64_t  elapsed_ns;    // 实际耗时
+};
+
+class TelemetryReplayer {
+public:
+    typedef std::function<void(const TelemetryRecord&)> RecordHandler;
+
+    TelemetryReplayer(TelemetryReader& reader,
+                      const TelemetryReplayConfig& config = TelemetryReplayConfig());
+
+    /**
+     * @brief 回放到结束、达到 max_records 或 running 被置为 false
+     * @return 本次交付的记录数
+     */
+    uint64_t run(const RecordHandler& handler, const std::atomic<bool>* running = nullptr);
+
+    /** @brief 单步：不等待，立即交付下一条记录；读完时返回 false */
+    bool step(const RecordHandler& handler);
+
+    const TelemetryReplayStats& stats() const { return stats_; }
+
+private:
+    void waitUntil(int64_t target_ns);
+
+    TelemetryReader& reader_;
+    TelemetryReplayConfig config_;
+    TelemetryReplayStats stats_;
+
+    bool started_;
+    int64_t first_recv_ns_;
+    int64_t start_ns_;
+};
+
+} // namespace q25
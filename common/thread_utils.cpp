@@ -0,0 +1,105 @@
+// ====================================================================
+//          Created:    2026/10/14/ 11:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file thread_utils.cpp
+ * @brief 线程绑核 / 优先级设置实现
+ */
+
+#include "thread_utils.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <cstring>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#endif
+
+namespace q25 {
+
+#ifdef _WIN32
+
+bool pinCurrentThread(int core) {
+    if (core < 0) {
+        return true;
+    }
+    if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+        std::cerr << "[ERROR] Invalid CPU core: " << core << std::endl;
+        return false;
+    }
+    DWORD_PTR mask = static_cast<DWORD_PTR>(1) << core;
+    if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+        std::cerr << "[ERROR] Failed to pin thread to core " << core
+                  << ", error: " << GetLastError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool setCurrentThreadRealtime() {
+    if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+        std::cerr << "[ERROR] Failed to raise thread priority, error: " << GetLastError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void cpuRelax() {
+    YieldProcessor();
+}
+
+#else
+
+bool pinCurrentThread(int core) {
+    if (core < 0) {
+        return true;
+    }
+    if (core >= CPU_SETSIZE) {
+        std::cerr << "[ERROR] Invalid CPU core: " << core << std::endl;
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        std::cerr << "[ERROR] Failed to pin thread to core " << core
+                  << ", error: " << strerror(rc) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool setCurrentThreadRealtime() {
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (rc != 0) {
+        std::cerr << "[ERROR] Failed to set SCHED_FIFO priority, error: " << strerror(rc) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+#endif
+
+} // namespace q25
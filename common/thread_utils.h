@@ -0,0 +1,33 @@
+// ====================================================================
+//          Created:    2026/10/14/ 11:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file thread_utils.h
+ * @brief 线程绑核 / 优先级设置
+ *
+ * 只作用于调用线程，需在目标线程内部调用。
+ *   - Windows: SetThreadAffinityMask / THREAD_PRIORITY_TIME_CRITICAL
+ *   - Linux:   pthread_setaffinity_np / SCHED_FIFO（需 CAP_SYS_NICE 或 root），
+ *              配合 isolcpus / nohz_full 隔离的核可获得最稳定的周期
+ */
+
+#pragma once
+
+namespace q25 {
+
+/**
+ * @brief 将当前线程绑定到指定 CPU 核
+ * @param core CPU 核编号（从 0 开始），小于 0 时不做任何处理
+ */
+bool pinCurrentThread(int core);
+
+/** @brief 将当前线程设为最高（实时）调度优先级 */
+bool setCurrentThreadRealtime();
+
+/** @brief 自旋等待时的 CPU 提示（x86 为 pause 指令），降低自旋对同核超线程的干扰 */
+void cpuRelax();
+
+} // namespace q25
@@ -0,0 +1,209 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file time_series.cpp
+ * @brief TimeSeriesStore 实现
+ */
+
+#include "time_series.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "cache_line.h"
+
+namespace q25 {
+
+namespace {
+
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+TimeSeriesStore::TimeSeriesStore(size_t signals, size_t capacity, int64_t stats_window_ns)
+    : signals_(signals)
+    , capacity_(roundUpPowerOfTwo(capacity < 2 ? 2 : capacity))
+    , mask_(capacity_ - 1)
+    , window_ns_(stats_window_ns)
+    , head_(0)
+    , win_begin_(0)
+    , since_resync_(0)
+    , states_(signals)
+    , min_queue_(signals * capacity_)
+    , max_queue_(signals * capacity_) {
+    times_ = static_cast<int64_t*>(alignedAlloc(sizeof(int64_t) * capacity_));
+    values_ = static_cast<float*>(alignedAlloc(sizeof(float) * capacity_ * signals_));
+    if (times_ == nullptr || values_ == nullptr) {
+        std::cerr << "[ERROR] Failed to allocate time series storage" << std::endl;
+    }
+    memset(&states_[0], 0, sizeof(SignalState) * signals_);
+}
+
+TimeSeriesStore::~TimeSeriesStore() {
+    alignedFree(times_);
+    alignedFree(values_);
+}
+
+void TimeSeriesStore::append(int64_t time_ns, const float* values) {
+    if (times_ == nullptr || values_ == nullptr) {
+        return;
+    }
+
+    // 即将被覆盖的最旧样本必须先移出统计窗口
+    if (head_ >= capacity_ && win_begin_ <= head_ - capacity_) {
+        evict();
+    }
+
+    uint64_t index = head_;
+    size_t slot = static_cast<size_t>(index & mask_);
+    times_[slot] = time_ns;
+    for (size_t s = 0; s < signals_; s++) {
+        float v = values[s];
+        values_[s * capacity_ + slot] = v;
+
+        SignalState& state = states_[s];
+        state.sum += v;
+        state.sum_sq += static_cast<double>(v) * v;
+
+        // 单调队列：队尾比新值差的样本不可能再成为窗口最值
+        const float* series = values_ + s * capacity_;
+        uint64_t* min_q = &min_queue_[s * capacity_];
+        while (state.min_back > state.min_front &&
+               series[min_q[(state.min_back - 1) & mask_] & mask_] >= v) {
+            state.min_back--;
+        }
+        min_q[state.min_back++ & mask_] = index;
+
+        uint64_t* max_q = &max_queue_[s * capacity_];
+        while (state.max_back > state.max_front &&
+               series[max_q[(state.max_back - 1) & mask_] & mask_] <= v) {
+            state.max_back--;
+        }
+        max_q[state.max_back++ & mask_] = index;
+    }
+    head_++;
+
+    // 移出超出窗口时长的样本
+    while (win_begin_ < head_ && times_[win_begin_ & mask_] < time_ns - window_ns_) {
+        evict();
+    }
+
+    // 每写满一圈重新求和，避免增减累积的浮点误差
+    if (++since_resync_ >= capacity_) {
+        resync();
+    }
+}
+
+void TimeSeriesStore::evict() {
+    uint64_t index = win_begin_++;
+    size_t slot = static_cast<size_t>(index & mask_);
+    for (size_t s = 0; s < signals_; s++) {
+        float v = values_[s * capacity_ + slot];
+        SignalState& state = states_[s];
+        state.sum -= v;
+        state.sum_sq -= static_cast<double>(v) * v;
+        if (state.min_back > state.min_front && min_queue_[s * capacity_ + (state.min_front & mask_)] == index) {
+            state.min_front++;
+        }
+        if (state.max_back > state.max_front && max_queue_[s * capacity_ + (state.max_front & mask_)] == index) {
+            state.max_front++;
+        }
+    }
+}
+
+void TimeSeriesStore::resync() {
+    since_resync_ = 0;
+    for (size_t s = 0; s < signals_; s++) {
+        const float* series = values_ + s * capacity_;
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (uint64_t i = win_begin_; i < head_; i++) {
+            double v = series[i & mask_];
+            sum += v;
+            sum_sq += v * v;
+        }
+        states_[s].sum = sum;
+        states_[s].sum_sq = sum_sq;
+    }
+}
+
+WindowStats TimeSeriesStore::stats(size_t signal) const {
+    WindowStats result = { 0, 0.0, 0.0, 0.0f, 0.0f };
+    size_t count = static_cast<size_t>(head_ - win_begin_);
+    if (count == 0 || signal >= signals_) {
+        return result;
+    }
+    const SignalState& state = states_[signal];
+    const float* series = values_ + signal * capacity_;
+
+    result.count = count;
+    result.mean = state.sum / count;
+    double variance = state.sum_sq / count - result.mean * result.mean;
+    result.variance = variance > 0.0 ? variance : 0.0;
+    result.min = series[min_queue_[signal * capacity_ + (state.min_front & mask_)] & mask_];
+    result.max = series[max_queue_[signal * capacity_ + (state.max_front & mask_)] & mask_];
+    return result;
+}
+
+// 最近 duration_ns 内第一个样本的绝对序号（二分查找）
+uint64_t TimeSeriesStore::findStart(int64_t duration_ns) const {
+    uint64_t lo = oldest();
+    uint64_t hi = head_;
+    if (lo == hi) {
+        return hi;
+    }
+    int64_t threshold = latestTime() - duration_ns;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (times_[mid & mask_] < threshold) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <typename T>
+RingView<T> TimeSeriesStore::view(const T* data, uint64_t begin) const {
+    RingView<T> result = { nullptr, 0, nullptr, 0 };
+    size_t count = static_cast<size_t>(head_ - begin);
+    if (count == 0) {
+        return result;
+    }
+    size_t start = static_cast<size_t>(begin & mask_);
+    size_t first = capacity_ - start < count ? capacity_ - start : count;
+    result.first = data + start;
+    result.first_size = first;
+    result.second = data;
+    result.second_size = count - first;
+    return result;
+}
+
+RingView<float> TimeSeriesStore::window(size_t signal, int64_t duration_ns) const {
+    if (signal >= signals_ || values_ == nullptr) {
+        RingView<float> empty = { nullptr, 0, nullptr, 0 };
+        return empty;
+    }
+    return view(values_ + signal * capacity_, findStart(duration_ns));
+}
+
+RingView<int64_t> TimeSeriesStore::windowTimes(int64_t duration_ns) const {
+    if (times_ == nullptr) {
+        RingView<int64_t> empty = { nullptr, 0, nullptr, 0 };
+        return empty;
+    }
+    return view(times_, findStart(duration_ns));
+}
+
+} // namespace q25
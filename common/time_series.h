@@ -0,0 +1,123 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:50
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file time_series.h
+ * @brief 定长环形时间序列存储与滑动窗口统计
+ *
+ * 一组同时采样的信号（例如 IMU 的 9 个分量）共用一个时间戳数组，
+ * 每个信号一个 float 数组（结构体数组布局），容量为 2 的幂，全部内存在构造时分配:
+ *
+ *   times[]       | t0 t1 t2 ... |
+ *   values[0][]   | v0 v1 v2 ... |   signal 0
+ *   values[1][]   | ...          |   signal 1
+ *
+ * append() 为 O(信号数)；window() 返回最近一段时间的零拷贝视图，环绕时分为两段。
+ *
+ * 每个信号维护一个固定时长的滑动统计窗口，append() 时增量更新:
+ *   - 和 / 平方和（double），每写满一圈按窗口重新求和一次，消除累计误差
+ *   - 最小 / 最大值使用单调队列，均摊 O(1)
+ * 因此 stats() 为 O(1)，不重新扫描窗口。窗口内样本数超过容量时，以容量为准。
+ *
+ * 时间戳需单调不减。非线程安全，应在同一线程中写入和查询。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace q25 {
+
+// ============ 零拷贝视图 ============
+// 环形缓冲区中的一段连续逻辑区间，物理上最多分为两段
+template <typename T>
+struct RingView {
+    const T* first;
+    size_t first_size;
+    const T* second;
+    size_t second_size;
+
+    size_t size() const { return first_size + second_size; }
+    bool empty() const { return size() == 0; }
+    const T& operator[](size_t i) const {
+        return i < first_size ? first[i] : second[i - first_size];
+    }
+};
+
+// ============ 滑动窗口统计 ============
+struct WindowStats {
+    size_t count;
+    double mean;
+    double variance;  // 总体方差
+    float min;
+    float max;
+};
+
+class TimeSeriesStore {
+public:
+    /**
+     * @param signals          信号个数
+     * @param capacity         保留的样本数，向上取整为 2 的幂
+     * @param stats_window_ns  滑动统计窗口时长
+     */
+    TimeSeriesStore(size_t signals, size_t capacity, int64_t stats_window_ns);
+    ~TimeSeriesStore();
+
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    /** @brief 追加一个样本，values 包含 signals() 个值 */
+    void append(int64_t time_ns, const float* values);
+
+    size_t signals() const { return signals_; }
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return static_cast<size_t>(head_ - oldest()); }
+    int64_t latestTime() const { return head_ > 0 ? times_[(head_ - 1) & mask_] : 0; }
+
+    // 最近 duration_ns 内（含边界）的样本
+    RingView<float> window(size_t signal, int64_t duration_ns) const;
+    RingView<int64_t> windowTimes(int64_t duration_ns) const;
+
+    /** @brief 信号在统计窗口内的统计量，O(1) */
+    WindowStats stats(size_t signal) const;
+
+private:
+    uint64_t oldest() const { return head_ > capacity_ ? head_ - capacity_ : 0; }
+    uint64_t findStart(int64_t duration_ns) const;
+    template <typename T>
+    RingView<T> view(const T* data, uint64_t begin) const;
+
+    void evict();
+    void resync();
+
+    size_t signals_;
+    size_t capacity_;
+    size_t mask_;
+    int64_t window_ns_;
+
+    int64_t* times_;
+    float* values_;        // signals_ x capacity_
+
+    uint64_t head_;        // 已写入的样本总数
+    uint64_t win_begin_;   // 统计窗口内第一个样本（绝对序号）
+    uint64_t since_resync_;
+
+    // 每个信号的统计状态
+    struct SignalState {
+        double sum;
+        double sum_sq;
+        uint64_t min_front, min_back;
+        uint64_t max_front, max_back;
+    };
+    std::vector<SignalState> states_;
+    // 单调队列：存放样本的绝对序号，每个信号 capacity_ 个槽
+    std::vector<uint64_t> min_queue_;
+    std::vector<uint64_t> max_queue_;
+};
+
+} // namespace q25
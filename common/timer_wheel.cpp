@@ -0,0 +1,211 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file timer_wheel.cpp
+ * @brief TimerWheel 实现
+ */
+
+#include "timer_wheel.h"
+
+namespace q25 {
+
+constexpr int TimerWheel::LEVELS;
+constexpr int TimerWheel::LEVEL_BITS;
+constexpr size_t TimerWheel::LEVEL_SLOTS;
+constexpr uint64_t TimerWheel::MAX_DELAY_TICKS;
+constexpr uint32_t TimerWheel::NIL;
+
+namespace {
+
+constexpr uint64_t SLOT_MASK = TimerWheel::LEVEL_SLOTS - 1;
+
+// 第 level 层槽位号
+inline size_t slotIndex(uint64_t tick, int level) {
+    return static_cast<size_t>((tick >> (TimerWheel::LEVEL_BITS * level)) & SLOT_MASK);
+}
+
+} // namespace
+
+TimerWheel::TimerWheel(size_t max_timers)
+    : nodes_(max_timers)
+    , slots_(LEVELS * LEVEL_SLOTS, NIL)
+    , free_head_(NIL)
+    , current_tick_(0)
+    , active_(0) {
+    expired_.reserve(max_timers);
+
+    // 空闲链表复用 next 字段
+    for (size_t i = nodes_.size(); i > 0; i--) {
+        Node& node = nodes_[i - 1];
+        node.expires = 0;
+        node.user_data = 0;
+        node.prev = NIL;
+        node.next = free_head_;
+        node.slot = NIL;
+        node.generation = 1;
+        node.state = NODE_FREE;
+        free_head_ = static_cast<uint32_t>(i - 1);
+    }
+}
+
+TimerId TimerWheel::schedule(uint64_t expires_tick, uint64_t user_data) {
+    if (free_head_ == NIL) {
+        return INVALID_TIMER_ID;
+    }
+    uint32_t index = free_head_;
+    Node& node = nodes_[index];
+    free_head_ = node.next;
+
+    node.expires = expires_tick > current_tick_ ? expires_tick : current_tick_ + 1;
+    node.user_data = user_data;
+    link(index);
+    active_++;
+    return makeId(index, node.generation);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    uint32_t index = resolve(id);
+    if (index == NIL) {
+        return false;
+    }
+    if (nodes_[index].state == NODE_LINKED) {
+        unlink(index);
+    }
+    release(index);
+    return true;
+}
+
+bool TimerWheel::reschedule(TimerId id, uint64_t expires_tick) {
+    uint32_t index = resolve(id);
+    if (index == NIL || nodes_[index].state != NODE_LINKED) {
+        return false;
+    }
+    unlink(index);
+    nodes_[index].expires = expires_tick > current_tick_ ? expires_tick : current_tick_ + 1;
+    link(index);
+    return true;
+}
+
+void TimerWheel::clear() {
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        if (nodes_[i].state == NODE_LINKED) {
+            unlink(static_cast<uint32_t>(i));
+        }
+        if (nodes_[i].state != NODE_FREE) {
+            release(static_cast<uint32_t>(i));
+        }
+    }
+    expired_.clear();
+}
+
+uint32_t TimerWheel::resolve(TimerId id) const {
+    uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= nodes_.size()) {
+        return NIL;
+    }
+    const Node& node = nodes_[index];
+    if (node.state == NODE_FREE || node.generation != generation) {
+        return NIL;
+    }
+    return index;
+}
+
+void TimerWheel::link(uint32_t index) {
+    Node& node = nodes_[index];
+
+    // 剩余时间落在 [256^L, 256^(L+1)) 时放入第 L 层；下放时剩余时间可能为 0，放入第 0 层当前槽位
+    uint64_t delay = node.expires - current_tick_;
+    uint64_t expires = node.expires;
+    if (delay > MAX_DELAY_TICKS) {
+        expires = current_tick_ + MAX_DELAY_TICKS;
+        delay = MAX_DELAY_TICKS;
+    }
+    int level = 0;
+    while (level < LEVELS - 1 && delay >= (static_cast<uint64_t>(1) << (LEVEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(level * LEVEL_SLOTS + slotIndex(expires, level));
+    uint32_t& head = slots_[slot];
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = head;
+    if (head != NIL) {
+        nodes_[head].prev = index;
+    }
+    head = index;
+    node.state = NODE_LINKED;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        slots_[node.slot] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.prev = NIL;
+    node.next = NIL;
+    node.slot = NIL;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.state = NODE_FREE;
+    node.generation++;
+    if (node.generation == 0) {
+        node.generation = 1;  // generation 0 会使 ID 可能等于 INVALID_TIMER_ID
+    }
+    node.next = free_head_;
+    free_head_ = index;
+    active_--;
+}
+
+void TimerWheel::step() {
+    current_tick_++;
+
+    // 第 L 层转完一圈（低 8L 位全为 0）时，下放第 L+1 层对应槽位；由高到低，
+    // 保证从高层下放的定时器在低层槽位下放之前就位
+    int top = 0;
+    while (top < LEVELS - 1 && slotIndex(current_tick_, top) == 0) {
+        top++;
+    }
+    for (int level = top; level >= 1; level--) {
+        cascade(level);
+    }
+
+    uint32_t& head = slots_[slotIndex(current_tick_, 0)];
+    uint32_t index = head;
+    while (index != NIL) {
+        Node& node = nodes_[index];
+        uint32_t next = node.next;
+        node.prev = NIL;
+        node.next = NIL;
+        node.slot = NIL;
+        node.state = NODE_PENDING;
+        expired_.push_back(std::make_pair(index, node.generation));
+        index = next;
+    }
+    head = NIL;
+}
+
+void TimerWheel::cascade(int level) {
+    uint32_t& head = slots_[level * LEVEL_SLOTS + slotIndex(current_tick_, level)];
+    uint32_t index = head;
+    head = NIL;
+    while (index != NIL) {
+        uint32_t next = nodes_[index].next;
+        link(index);  // 按剩余时间重新放入更低的层
+        index = next;
+    }
+}
+
+} // namespace q25
@@ -0,0 +1,162 @@
+// ====================================================================
+//          Created:    2026/10/14/ 13:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file timer_wheel.h
+ * @brief 分层定时器轮 (hierarchical timing wheel)
+ *
+ * 时间以 tick 为单位（由调用方决定 tick 长度）。共 4 层，每层 256 个槽位，
+ * 第 L 层每个槽位覆盖 256^L 个 tick，合计可表示 2^32 个 tick（1ms tick 约 49 天）:
+ *   - schedule() / cancel() / reschedule() 为 O(1)，按剩余时间放入对应层
+ *   - advance() 每推进一个 tick 只触发第 0 层的一个槽位；低层转完一圈时，
+ *     把上一层的下一个槽位整体下放（cascade），定时器只会被下放至多 3 次
+ *   - 槽位中的定时器都在本圈到期，推进时不需要跳过未到期的定时器
+ *
+ * 心跳、运动段结束、指令超时、状态看门狗等成千上万个定时器可同时存在，
+ * 每个 tick 的开销与定时器总数无关。
+ *
+ * 所有定时器节点在构造时一次性分配，运行期不分配内存；定时器为一次性，
+ * 周期任务在回调中重新 schedule()。非线程安全，只应在事件循环线程中使用。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace q25 {
+
+typedef uint64_t TimerId;
+constexpr TimerId INVALID_TIMER_ID = 0;
+
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int LEVEL_BITS = 8;
+    static constexpr size_t LEVEL_SLOTS = static_cast<size_t>(1) << LEVEL_BITS;
+    // 可表示的最长定时，更远的定时器先放在最高层，下放时重新计算
+    static constexpr uint64_t MAX_DELAY_TICKS = (static_cast<uint64_t>(1) << (LEVEL_BITS * LEVELS)) - 1;
+
+    /** @param max_timers 同时存在的定时器上限 */
+    explicit TimerWheel(size_t max_timers);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief 添加一次性定时器
+     * @param expires_tick 到期 tick；不晚于当前 tick 时在下一个 tick 到期
+     * @param user_data    回调时原样传回
+     * @return 定时器 ID，已达上限时返回 INVALID_TIMER_ID
+     */
+    TimerId schedule(uint64_t expires_tick, uint64_t user_data);
+
+    /** @brief 取消尚未触发的定时器，ID 已失效时返回 false */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief 修改尚未触发的定时器的到期 tick，ID 保持不变（看门狗续期用）
+     * @return ID 已失效（已触发或已取消）时返回 false
+     */
+    bool reschedule(TimerId id, uint64_t expires_tick);
+
+    /**
+     * @brief 推进到 now_tick，按到期顺序触发所有到期定时器
+     *
+     * handler 签名为 void(TimerId id, uint64_t user_data)。触发时定时器已被移除，
+     * 回调中可以 schedule() 新定时器或 cancel() 其他定时器。
+     *
+     * @return 触发的定时器个数
+     */
+    template <typename Handler>
+    size_t advance(uint64_t now_tick, Handler&& handler);
+
+    /** @brief 取消全部定时器（不触发回调），当前 tick 不变 */
+    void clear();
+
+    uint64_t currentTick() const { return current_tick_; }
+    size_t activeTimers() const { return active_; }
+    size_t capacity() const { return nodes_.size(); }
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+
+    enum NodeState : uint32_t {
+        NODE_FREE    = 0,
+        NODE_LINKED  = 1,  // 在槽位链表中
+        NODE_PENDING = 2   // 已到期、等待回调
+    };
+
+    struct Node {
+        uint64_t expires;
+        uint64_t user_data;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t slot;        // 所在槽位（层 * LEVEL_SLOTS + 槽位号）
+        uint32_t generation;  // 每次释放加 1，使旧 ID 失效
+        uint32_t state;
+    };
+
+    static TimerId makeId(uint32_t index, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    // ID 有效时返回节点下标，否则返回 NIL
+    uint32_t resolve(TimerId id) const;
+    // 按相对 current_tick_ 的剩余时间放入对应层的槽位
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+
+    // 推进一个 tick：必要时逐层下放，再把第 0 层当前槽位的节点移入 expired_
+    void step();
+    void cascade(int level);
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> slots_;  // LEVELS * LEVEL_SLOTS 个槽位链表的头节点
+    std::vector<std::pair<uint32_t, uint32_t> > expired_;  // (下标, generation)
+    uint32_t free_head_;
+    uint64_t current_tick_;
+    size_t active_;
+};
+
+// ============ 模板实现 ============
+
+template <typename Handler>
+size_t TimerWheel::advance(uint64_t now_tick, Handler&& handler) {
+    if (now_tick <= current_tick_) {
+        return 0;
+    }
+
+    size_t fired = 0;
+    while (current_tick_ < now_tick) {
+        if (active_ == 0) {
+            current_tick_ = now_tick;  // 没有定时器时直接跳到目标 tick
+            break;
+        }
+        step();
+
+        for (size_t i = 0; i < expired_.size(); i++) {
+            uint32_t index = expired_[i].first;
+            uint32_t generation = expired_[i].second;
+            Node& node = nodes_[index];
+            // 被前面的回调取消的定时器不再触发
+            if (node.state != NODE_PENDING || node.generation != generation) {
+                continue;
+            }
+            uint64_t user_data = node.user_data;
+            release(index);
+            handler(makeId(index, generation), user_data);
+            fired++;
+        }
+        expired_.clear();
+    }
+    return fired;
+}
+
+} // namespace q25
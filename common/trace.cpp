@@ -0,0 +1,239 @@
+// ====================================================================
+//          Created:    2026/10/14/ 20:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file trace.cpp
+ * @brief 线程缓冲区注册与 Chrome trace 导出
+ */
+
+#include "trace.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace q25 {
+
+namespace {
+
+constexpr size_t DEFAULT_BUFFER_EVENTS = 16384;
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 缓冲区在线程退出后保留，供之后导出，进程结束前不释放
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<TraceBuffer*> buffers;
+    size_t buffer_events;
+
+    TraceRegistry() : buffer_events(DEFAULT_BUFFER_EVENTS) {}
+};
+
+TraceRegistry& registry() {
+    static TraceRegistry instance;
+    return instance;
+}
+
+// 时间戳计数器校准基准，导出时与当前的 steady_clock 比较得到计数频率
+struct TraceClockBase {
+    uint64_t ticks;
+    int64_t  steady_ns;
+
+    TraceClockBase() : ticks(traceNow()), steady_ns(steadyNowNs()) {}
+};
+
+const TraceClockBase clock_base;
+
+// 事件名写入 JSON 字符串，转义引号与反斜杠
+void writeName(std::ostream& out, const char* name) {
+    out << '"';
+    for (const char* p = name; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            out << '\\';
+        }
+        out << *p;
+    }
+    out << '"';
+}
+
+} // namespace
+
+// ============ TraceBuffer ============
+
+TraceBuffer::TraceBuffer(size_t capacity, uint32_t thread_id)
+    : slots_(nullptr)
+    , mask_(nextPowerOfTwo(capacity) - 1)
+    , thread_id_(thread_id)
+    , name_(nullptr)
+    , head_(0) {
+    void* memory = alignedAlloc(sizeof(TraceSlot) * (mask_ + 1));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    // 逐个构造槽位，同时预先触碰全部内存，避免记录时缺页
+    slots_ = static_cast<TraceSlot*>(memory);
+    for (size_t i = 0; i <= mask_; i++) {
+        new (&slots_[i]) TraceSlot();
+    }
+}
+
+TraceBuffer::~TraceBuffer() {
+    // TraceSlot 只含原子整数 / 指针，无需逐个析构
+    alignedFree(slots_);
+}
+
+size_t TraceBuffer::snapshot(TraceEvent* out, uint64_t& lost) const {
+    const uint64_t capacity = mask_ + 1;
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0;
+    for (uint64_t i = first; i < head; i++) {
+        const TraceSlot& slot = slots_[i & mask_];
+        TraceEvent& event = out[i - first];
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.arg = slot.arg.load(std::memory_order_relaxed);
+    }
+
+    // 拷贝期间写者继续前进时，序号不大于 after - capacity 的槽位（含正在写入的一个）可能已被覆盖
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = head_.load(std::memory_order_relaxed);
+    uint64_t valid = after + 1 > capacity ? after + 1 - capacity : 0;
+    size_t skip = 0;
+    if (valid > first) {
+        skip = static_cast<size_t>(valid - first < head - first ? valid - first : head - first);
+    }
+    size_t count = static_cast<size_t>(head - first) - skip;
+    if (skip > 0) {
+        memmove(out, out + skip, count * sizeof(TraceEvent));
+    }
+    lost += first + skip;
+    return count;
+}
+
+// ============ 注册 ============
+
+TraceBuffer& traceRegisterThread() {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    // 按缓存行对齐分配（head_ 独占缓存行，C++11 的 new 不保证超对齐）
+    void* memory = alignedAlloc(sizeof(TraceBuffer));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    TraceBuffer* buffer = new (memory) TraceBuffer(reg.buffer_events, static_cast<uint32_t>(reg.buffers.size() + 1));
+    reg.buffers.push_back(buffer);
+    traceThreadSlot() = buffer;
+    return *buffer;
+}
+
+bool traceEnabled() {
+#ifdef Q25_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void traceSetBufferEvents(size_t events) {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.buffer_events = events > 0 ? events : DEFAULT_BUFFER_EVENTS;
+}
+
+// ============ 导出 ============
+
+bool traceDump(const std::string& path) {
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[ERROR] Cannot write trace file: " << path << std::endl;
+        return false;
+    }
+
+    // 计数频率：启动以来的计数差 / 时间差
+    uint64_t now_ticks = traceNow();
+    int64_t elapsed_ns = steadyNowNs() - clock_base.steady_ns;
+    double ticks_per_us = 1000.0;
+    if (elapsed_ns > 0 && now_ticks > clock_base.ticks) {
+        ticks_per_us = static_cast<double>(now_ticks - clock_base.ticks) * 1000.0 / static_cast<double>(elapsed_ns);
+    }
+
+    std::vector<TraceBuffer*> buffers;
+    {
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers = reg.buffers;
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first_event = true;
+    uint64_t total = 0;
+    uint64_t lost = 0;
+    std::vector<TraceEvent> events;
+    char number[64];
+
+    for (size_t b = 0; b < buffers.size(); b++) {
+        const TraceBuffer& buffer = *buffers[b];
+        uint32_t tid = buffer.threadId();
+
+        const char* thread_name = buffer.name();
+        if (thread_name != nullptr) {
+            out << (first_event ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"name\":";
+            writeName(out, thread_name);
+            out << "}}";
+            first_event = false;
+        }
+
+        events.resize(buffer.capacity());
+        size_t count = buffer.snapshot(&events[0], lost);
+        for (size_t i = 0; i < count; i++) {
+            const TraceEvent& event = events[i];
+            double ts_us = static_cast<double>(static_cast<int64_t>(event.start - clock_base.ticks)) / ticks_per_us;
+            out << (first_event ? "" : ",\n") << "{\"name\":";
+            writeName(out, event.name);
+            snprintf(number, sizeof(number), "%.3f", ts_us);
+            out << ",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << number;
+            if (event.duration == TRACE_INSTANT) {
+                out << ",\"ph\":\"i\",\"s\":\"t\"";
+            } else {
+                snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.duration) / ticks_per_us);
+                out << ",\"ph\":\"X\",\"dur\":" << number;
+            }
+            out << ",\"args\":{\"arg\":" << event.arg << "}}";
+            first_event = false;
+        }
+        total += count;
+    }
+    out << "\n]}\n";
+    out.close();
+
+    if (!out) {
+        std::cerr << "[ERROR] Failed writing trace file: " << path << std::endl;
+        return false;
+    }
+    std::cout << "[INFO] Wrote " << total << " trace events from " << buffers.size() << " thread(s) to " << path
+              << " (" << lost << " overwritten)" << std::endl;
+    return true;
+}
+
+} // namespace q25
@@ -0,0 +1,201 @@
+// ====================================================================
+//          Created:    2026/10/14/ 20:10
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file trace.h
+ * @brief 热路径跟踪点：按线程写入无锁环形缓冲区，导出为 Chrome trace / Perfetto 格式
+ *
+ * 用于定位控制循环漏掉的 tick、接收停顿等偶发问题:
+ *
+ *     void BatchSender::flush() {
+ *         Q25_TRACE_SCOPE(trace, "send.flush");  // 作用域结束时记录一个区间事件
+ *         Q25_TRACE_ARG(trace, count_);           // 附带一个整数参数
+ *         ...
+ *     }
+ *     Q25_TRACE_INSTANT("control.missed", missed);  // 瞬时事件
+ *     Q25_TRACE_THREAD("Receiver");                 // 导出时显示的线程名
+ *
+ *     traceDump("trace.json");  // 在 chrome://tracing 或 ui.perfetto.dev 中打开
+ *
+ * 跟踪点需以 CMake 选项 Q25_ENABLE_TRACE=ON 构建，否则宏展开为空、没有任何开销。
+ * 开启时每个事件只读一次时间戳计数器（x86 为 TSC，其他平台为 steady_clock）
+ * 并写入本线程缓冲区的一个槽位，不加锁、不分配内存、不做系统调用，可以常开。
+ *
+ * 每个线程第一次记录时分配自己的缓冲区（容量见 traceSetBufferEvents()），写满后覆盖最早的事件，
+ * 始终保留最近的一段。缓冲区在线程退出后仍保留，导出可在任意线程、任意时刻进行；
+ * 与写入并发时，导出期间被覆盖的事件会被丢弃；槽位按原子字存放（同 seqlock.h），
+ * 并发导出符合 C++ 内存模型。
+ * 事件名只保存指针，必须是字符串字面量。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "cache_line.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define Q25_TRACE_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define Q25_TRACE_TSC 1
+#else
+#include <chrono>
+#endif
+
+namespace q25 {
+
+// ============ 时间戳 ============
+// 计数值与纳秒的换算在导出时按启动以来的 steady_clock 校准
+inline uint64_t traceNow() {
+#ifdef Q25_TRACE_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// ============ 跟踪事件 ============
+constexpr uint64_t TRACE_INSTANT = ~0ull;  // duration 取该值表示瞬时事件
+
+struct TraceEvent {
+    uint64_t    start;     // traceNow() 计数
+    uint64_t    duration;  // 计数差，TRACE_INSTANT 为瞬时事件
+    const char* name;
+    uint64_t    arg;
+};
+
+// ============ 线程缓冲区 ============
+
+// 环形缓冲区中的一个槽位；字段均为 relaxed 原子操作，导出与写入并发时不构成数据竞争
+struct TraceSlot {
+    std::atomic<uint64_t>    start;
+    std::atomic<uint64_t>    duration;
+    std::atomic<const char*> name;
+    std::atomic<uint64_t>    arg;
+
+    TraceSlot() : start(0), duration(0), name(nullptr), arg(0) {}
+};
+
+// 单写者（所属线程）环形缓冲区，写满覆盖最早的事件
+class TraceBuffer {
+public:
+    TraceBuffer(size_t capacity, uint32_t thread_id);
+    ~TraceBuffer();
+
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+    void record(const char* name, uint64_t start, uint64_t duration, uint64_t arg) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        // 与 snapshot() 中的 acquire 栅栏配对：读到本次写入的字段时，必然也能看到 head_ 已到达 head
+        std::atomic_thread_fence(std::memory_order_release);
+        TraceSlot& slot = slots_[head & mask_];
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.duration.store(duration, std::memory_order_relaxed);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.arg.store(arg, std::memory_order_relaxed);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 拷贝当前保留的事件（可与写入并发）
+     * @param out  至少 capacity() 个元素
+     * @param lost 累加被覆盖而未能导出的事件数
+     * @return 拷贝的事件数，按时间先后排列
+     */
+    size_t snapshot(TraceEvent* out, uint64_t& lost) const;
+
+    size_t capacity() const { return mask_ + 1; }
+    uint32_t threadId() const { return thread_id_; }
+
+    void setName(const char* name) { name_.store(name, std::memory_order_release); }
+    const char* name() const { return name_.load(std::memory_order_acquire); }
+
+private:
+    TraceSlot*  slots_;
+    size_t      mask_;
+    uint32_t    thread_id_;
+    std::atomic<const char*> name_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_;
+};
+
+// 注册并返回当前线程的缓冲区（首次记录时调用）
+TraceBuffer& traceRegisterThread();
+
+inline TraceBuffer*& traceThreadSlot() {
+    static thread_local TraceBuffer* buffer = nullptr;
+    return buffer;
+}
+
+inline TraceBuffer& traceThreadBuffer() {
+    TraceBuffer* buffer = traceThreadSlot();
+    return buffer != nullptr ? *buffer : traceRegisterThread();
+}
+
+// ============ 记录 ============
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name_(name), arg_(0), start_(traceNow()) {}
+    ~TraceScope() {
+        uint64_t end = traceNow();
+        traceThreadBuffer().record(name_, start_, end - start_, arg_);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    void setArg(uint64_t arg) { arg_ = arg; }
+
+private:
+    const char* name_;
+    uint64_t    arg_;
+    uint64_t    start_;
+};
+
+inline void traceInstant(const char* name, uint64_t arg) {
+    traceThreadBuffer().record(name, traceNow(), TRACE_INSTANT, arg);
+}
+
+inline void traceThreadName(const char* name) {
+    traceThreadBuffer().setName(name);
+}
+
+// ============ 配置与导出 ============
+
+// 是否以 Q25_ENABLE_TRACE 构建
+bool traceEnabled();
+
+// 之后新注册线程的缓冲区容量（事件数，向上取整为 2 的幂），默认 16384（512KB）
+void traceSetBufferEvents(size_t events);
+
+/**
+ * @brief 把全部线程缓冲区中保留的事件写为 Chrome trace JSON
+ * @return 文件无法写入时返回 false
+ */
+bool traceDump(const std::string& path);
+
+} // namespace q25
+
+// ============ 跟踪点 ============
+#ifdef Q25_TRACE
+#define Q25_TRACE_SCOPE(var, name)     ::q25::TraceScope var(name)
+#define Q25_TRACE_ARG(var, value)      var.setArg(static_cast<uint64_t>(value))
+#define Q25_TRACE_INSTANT(name, value) ::q25::traceInstant(name, static_cast<uint64_t>(value))
+#define Q25_TRACE_THREAD(name)         ::q25::traceThreadName(name)
+#else
+#define Q25_TRACE_SCOPE(var, name)     ((void)0)
+#define Q25_TRACE_ARG(var, value)      ((void)0)
+#define Q25_TRACE_INSTANT(name, value) ((void)0)
+#define Q25_TRACE_THREAD(name)         ((void)0)
+#endif
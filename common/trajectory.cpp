@@ -0,0 +1,113 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file trajectory.cpp
+ * @brief TrajectoryEngine 实现
+ */
+
+#include "trajectory.h"
+
+#include <cmath>
+
+namespace q25 {
+
+namespace {
+
+void segmentTarget(const TrajectorySegment& segment, int32_t out[4]) {
+    out[0] = segment.left_x;
+    out[1] = segment.left_y;
+    out[2] = segment.right_x;
+    out[3] = segment.right_y;
+}
+
+// 斜坡进度 u ∈ [0, 1] 映射为插值权重
+double rampWeight(uint32_t profile, double u) {
+    switch (profile) {
+    case RAMP_LINEAR: return u;
+    case RAMP_SMOOTH: return u * u * (3.0 - 2.0 * u);
+    default:          return 1.0;
+    }
+}
+
+void storeAxis(const int32_t values[4], AxisCommand& out) {
+    out.left_x = static_cast<uint32_t>(values[0]);
+    out.left_y = static_cast<uint32_t>(values[1]);
+    out.right_x = static_cast<uint32_t>(values[2]);
+    out.right_y = static_cast<uint32_t>(values[3]);
+}
+
+} // namespace
+
+uint32_t trajectoryDurationMs(const TrajectorySegment* segments, size_t count) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += segments[i].duration_ms;
+    }
+    return total;
+}
+
+TrajectoryEngine::TrajectoryEngine()
+    : segments_(nullptr)
+    , count_(0)
+    , index_(0)
+    , segment_start_us_(0) {
+    for (int i = 0; i < 4; i++) {
+        from_[i] = 0;
+    }
+}
+
+void TrajectoryEngine::start(const TrajectorySegment* segments, size_t count, const AxisCommand& from) {
+    segments_ = count > 0 ? segments : nullptr;
+    count_ = count;
+    index_ = 0;
+    segment_start_us_ = 0;
+    from_[0] = static_cast<int32_t>(from.left_x);
+    from_[1] = static_cast<int32_t>(from.left_y);
+    from_[2] = static_cast<int32_t>(from.right_x);
+    from_[3] = static_cast<int32_t>(from.right_y);
+}
+
+bool TrajectoryEngine::evaluate(uint64_t elapsed_us, AxisCommand& out) {
+    if (segments_ == nullptr) {
+        storeAxis(from_, out);
+        return false;
+    }
+
+    // 跨过已结束的段；时间单调，每段只跨过一次。斜坡不超过段长，段结束时已到达目标值
+    while (index_ < count_ &&
+           elapsed_us >= segment_start_us_ + static_cast<uint64_t>(segments_[index_].duration_ms) * 1000) {
+        segmentTarget(segments_[index_], from_);
+        segment_start_us_ += static_cast<uint64_t>(segments_[index_].duration_ms) * 1000;
+        index_++;
+    }
+    if (index_ == count_) {
+        segments_ = nullptr;
+        storeAxis(from_, out);
+        return false;
+    }
+
+    const TrajectorySegment& segment = segments_[index_];
+    int32_t target[4];
+    segmentTarget(segment, target);
+
+    uint32_t ramp_ms = segment.ramp_ms < segment.duration_ms ? segment.ramp_ms : segment.duration_ms;
+    uint64_t offset_us = elapsed_us - segment_start_us_;
+    if (segment.profile == RAMP_STEP || ramp_ms == 0 || offset_us >= static_cast<uint64_t>(ramp_ms) * 1000) {
+        storeAxis(target, out);
+        return true;
+    }
+
+    double weight = rampWeight(segment.profile, static_cast<double>(offset_us) / (ramp_ms * 1000.0));
+    int32_t values[4];
+    for (int i = 0; i < 4; i++) {
+        values[i] = from_[i] + static_cast<int32_t>(std::lround((target[i] - from_[i]) * weight));
+    }
+    storeAxis(values, out);
+    return true;
+}
+
+} // namespace q25
@@ -0,0 +1,91 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:30
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file trajectory.h
+ * @brief 轴值轨迹：按段预先给出的路线，每个控制周期插值得到当前设定值
+ *
+ * 一条路线是一组 TrajectorySegment（段长 + 四轴目标值 + 斜坡），通常写成常量数组:
+ *
+ *     const TrajectorySegment ROUTE[] = {
+ *         // 段长ms  left_x left_y right_x right_y  斜坡ms  斜坡曲线
+ *         { 2000,    0,     500,   0,      0,       300,    RAMP_SMOOTH },  // 前进
+ *         { 2000,    0,     0,     -500,   0,       300,    RAMP_SMOOTH },  // 左转
+ *         { 500,     0,     0,     0,      0,       300,    RAMP_SMOOTH },  // 减速停止
+ *     };
+ *     loop.playTrajectory(ROUTE);
+ *
+ * 每段在开始后的 ramp_ms 内从上一段结束时的轴值过渡到本段目标值，其余时间保持目标值。
+ * TrajectoryEngine 只保存指向数组的指针与当前段的位置，按控制周期的时间顺序求值，
+ * 每次求值 O(1)，不分配内存。路线数组由调用方持有，需在播放结束前保持有效。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "q25_protocol.h"
+
+namespace q25 {
+
+// ============ 斜坡曲线 ============
+enum RampProfile : uint32_t {
+    RAMP_STEP   = 0,  // 段开始时直接跳到目标值
+    RAMP_LINEAR = 1,  // 线性过渡
+    RAMP_SMOOTH = 2   // smoothstep (3u^2 - 2u^3)，起止处变化率为 0，减小冲击
+};
+
+// ============ 轨迹段 ============
+struct TrajectorySegment {
+    uint32_t duration_ms;  // 段长（含斜坡）
+    int32_t  left_x;       // 目标轴值 [-1000, 1000]
+    int32_t  left_y;
+    int32_t  right_x;
+    int32_t  right_y;
+    uint32_t ramp_ms;      // 过渡时间，超过段长时按段长计
+    uint32_t profile;      // RampProfile
+};
+
+// 路线总时长（毫秒）
+uint32_t trajectoryDurationMs(const TrajectorySegment* segments, size_t count);
+
+template <size_t N>
+uint32_t trajectoryDurationMs(const TrajectorySegment (&segments)[N]) {
+    return trajectoryDurationMs(segments, N);
+}
+
+class TrajectoryEngine {
+public:
+    TrajectoryEngine();
+
+    /**
+     * @brief 开始播放路线，时间从 0 开始计
+     * @param from 第一段斜坡的起点（一般为当前轴值）
+     */
+    void start(const TrajectorySegment* segments, size_t count, const AxisCommand& from);
+
+    void stop() { segments_ = nullptr; }
+
+    bool active() const { return segments_ != nullptr; }
+
+    /**
+     * @brief 求 elapsed_us 时刻的轴值；elapsed_us 需单调不减
+     * @return 路线已播放完时返回 false（out 为最后一段的目标值），并转为未激活
+     */
+    bool evaluate(uint64_t elapsed_us, AxisCommand& out);
+
+    size_t segmentIndex() const { return index_; }
+
+private:
+    const TrajectorySegment* segments_;
+    size_t   count_;
+    size_t   index_;             // 当前段
+    uint64_t segment_start_us_;  // 当前段的开始时刻
+    int32_t  from_[4];           // 当前段斜坡的起点 (left_x, left_y, right_x, right_y)
+};
+
+} // namespace q25
@@ -0,0 +1,153 @@
+// ====================================================================
+//          Created:    2026/10/14/ 09:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file udp_transport.cpp
+ * @brief UdpTransport 实现
+ */
+
+#include "udp_transport.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "net_platform.h"
+#include "telemetry_recorder.h"
+
+namespace q25 {
+
+UdpTransport::UdpTransport()
+    : sock_(INVALID_SOCKET)
+    , batch_(16, MAX_COMMAND_SIZE)
+    , recorder_(nullptr)
+    , sent_packets_(0)
+    , send_errors_(0) {}
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+bool UdpTransport::open(const char* ip, int port) {
+    close();
+
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET) {
+        std::cerr << "[ERROR] Failed to create socket: " << lastSocketError() << std::endl;
+        return false;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, ip, &addr.sin_addr) != 1) {
+        std::cerr << "[ERROR] Invalid robot address: " << ip << std::endl;
+        closeSocketHandle(sock);
+        return false;
+    }
+
+    // UDP connect 只记录默认目的地址，不产生网络交互；
+    // 之后使用 send() 即可，内核无需每次解析目的地址
+    if (connect(sock, (struct sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR) {
+        std::cerr << "[ERROR] Failed to connect socket to " << ip << ":" << port
+                  << ", error: " << lastSocketError() << std::endl;
+        closeSocketHandle(sock);
+        return false;
+    }
+
+    sock_ = sock;
+    batch_.open(sock);
+    return true;
+}
+
+void UdpTransport::close() {
+    batch_.close();
+    if (sock_ != INVALID_SOCKET) {
+        closeSocketHandle(sock_);
+        sock_ = INVALID_SOCKET;
+    }
+}
+
+bool UdpTransport::applyTuning(const SocketTuning& tuning) {
+    if (sock_ == INVALID_SOCKET) {
+        std::cerr << "[ERROR] Transport is not open" << std::endl;
+        return false;
+    }
+    return applySocketTuning(sock_, tuning);
+}
+
+bool UdpTransport::sendCommand(uint32_t cmd_code, int32_t param) {
+    uint8_t buf[sizeof(UDPCommand)];
+    return sendRaw(buf, encodeSimple(buf, cmd_code, param));
+}
+
+bool UdpTransport::sendAxisControl(const AxisCommand& axis_cmd) {
+    // 头 + 16 字节数据体，共 28 字节
+    return send<cmd::AxisControl>(axis_cmd);
+}
+
+bool UdpTransport::sendRaw(const void* data, size_t len) {
+    int sent = ::send(sock_, reinterpret_cast<const char*>(data), static_cast<int>(len), 0);
+    if (sent == SOCKET_ERROR) {
+        send_errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    sent_packets_.fetch_add(1, std::memory_order_relaxed);
+    record(data, len);
+    return true;
+}
+
+bool UdpTransport::queueCommand(uint32_t cmd_code, int32_t param) {
+    uint8_t buf[sizeof(UDPCommand)];
+    return queueRaw(buf, encodeSimple(buf, cmd_code, param));
+}
+
+bool UdpTransport::queueAxisControl(const AxisCommand& axis_cmd) {
+    uint8_t buf[cmd::AxisControl::SIZE];
+    return queueRaw(buf, encode<cmd::AxisControl>(buf, axis_cmd));
+}
+
+bool UdpTransport::queueRaw(const void* data, size_t len) {
+    // 槽位满时 enqueue() 内部先发出已入队的数据包，这里同步发送计数
+    uint64_t sent_before = batch_.stats().datagrams;
+    uint64_t errors_before = batch_.stats().errors;
+    bool queued = batch_.enqueue(data, len);
+    sent_packets_.fetch_add(batch_.stats().datagrams - sent_before, std::memory_order_relaxed);
+    send_errors_.fetch_add(batch_.stats().errors - errors_before, std::memory_order_relaxed);
+    return queued;
+}
+
+size_t UdpTransport::flush() {
+    size_t queued = batch_.pending();
+    if (queued == 0) {
+        return 0;
+    }
+    size_t sent = batch_.flush();
+    sent_packets_.fetch_add(sent, std::memory_order_relaxed);
+    send_errors_.fetch_add(queued - sent, std::memory_order_relaxed);
+    return sent;
+}
+
+void UdpTransport::setRecorder(TelemetryRecorder* recorder) {
+    recorder_ = recorder;
+    // 批量发送的数据包由 BatchSender 在成功交给内核后回调记录
+    if (recorder != nullptr) {
+        batch_.onSent([this](const uint8_t* data, size_t len) { record(data, len); });
+    } else {
+        batch_.onSent(BatchSender::SentHandler());
+    }
+}
+
+void UdpTransport::record(const void* data, size_t len) {
+    if (recorder_ != nullptr) {
+        int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        recorder_->record(static_cast<const uint8_t*>(data), len, 0, 0, now_ns);
+    }
+}
+
+} // namespace q25
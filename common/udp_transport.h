@@ -0,0 +1,160 @@
+// ====================================================================
+//          Created:    2026/10/14/ 09:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file udp_transport.h
+ * @brief 面向单台机器人的持久化 UDP 发送通道
+ *
+ * 每台机器人只创建一个 socket，并在 open() 时 connect() 到机器人地址，
+ * 之后心跳、简单指令 (UDPCommand) 和扩展指令 (AxisControlMessage)
+ * 都复用该 socket，每次发送只需要一次 send() 系统调用。
+ *
+ * 同一周期内要发出多个数据包时（心跳 + 步态 + 高度 + 轴值），可改用 queue*() 入队、
+ * 周期末 flush() 一次发出（见 batch_sender.h），数据包按入队顺序到达内核。
+ *
+ * 线程约定:
+ *   - send*() 每次只调用一次 send()，未设置 recorder 时可在多个线程间共享同一实例
+ *   - queue*() / flush() 使用非线程安全的发送槽位，只应由单一发送线程（如 ControlLoop）调用
+ *   - 设置 recorder 后，包括 send*() 在内的全部发送都只应来自同一线程
+ *
+ * 使用前需先构造 NetworkRuntime（Windows 下初始化 Winsock）。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+#include "batch_sender.h"
+#include "net_types.h"
+#include "packet_cache.h"
+#include "q25_codec.h"
+#include "q25_protocol.h"
+#include "socket_options.h"
+
+namespace q25 {
+
+class TelemetryRecorder;
+
+class UdpTransport {
+public:
+    UdpTransport();
+    ~UdpTransport();
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    /**
+     * @brief 创建 socket 并 connect 到机器人地址
+     * @return 成功返回 true；失败时输出错误信息并返回 false
+     */
+    bool open(const char* ip, int port);
+
+    /** @brief 关闭 socket，可重复调用 */
+    void close();
+
+    bool isOpen() const { return sock_ != INVALID_SOCKET; }
+
+    /**
+     * @brief 设置发送 socket 的选项，需在 open() 之后调用
+     *
+     * 控制指令一般设置 dscp = DSCP_EF，让沿途设备优先转发。
+     */
+    bool applyTuning(const SocketTuning& tuning);
+
+    // ============ 按描述符发送（编码在编译期确定，见 q25_codec.h） ============
+
+    // 无参数简单指令，如 send<cmd::StandUp>()，直接发送预编码包
+    template <typename Cmd>
+    bool send() {
+        return sendImage(packetImage<Cmd>());
+    }
+
+    // 固定参数简单指令，如 send<cmd::ChangeHeight, HEIGHT_LOW>()，直接发送预编码包
+    template <typename Cmd, int32_t Param>
+    bool send() {
+        return sendImage(packetImage<Cmd, Param>());
+    }
+
+    // 带参数简单指令 send<cmd::ChangeHeight>(HEIGHT_LOW)，
+    // 或扩展指令 send<cmd::AxisControl>(axis)
+    template <typename Cmd, typename Arg>
+    bool send(const Arg& arg) {
+        uint8_t buf[Cmd::SIZE];
+        return sendRaw(buf, encode<Cmd>(buf, arg));
+    }
+
+    // 发送运行期指令码的简单指令（指令队列等）
+    bool sendCommand(uint32_t cmd_code, int32_t param = 0);
+
+    // 发送扩展轴控制指令 0x21010140
+    bool sendAxisControl(const AxisCommand& axis_cmd);
+
+    // 发送预编码包（见 packet_cache.h）
+    bool sendImage(const PacketImage& image) { return sendRaw(image.data, image.size); }
+
+    // 急停：预编码的 0x21010C0E，不经过任何编码步骤
+    bool sendEmergencyStop() {
+        return sendRaw(PreEncoded<cmd::EmergencyStop>::BYTES, PreEncoded<cmd::EmergencyStop>::SIZE);
+    }
+
+    // 发送已编码好的数据包
+    bool sendRaw(const void* data, size_t len);
+
+    // ============ 批量发送（单一发送线程） ============
+
+    template <typename Cmd>
+    bool queue() {
+        return queueImage(packetImage<Cmd>());
+    }
+
+    template <typename Cmd, int32_t Param>
+    bool queue() {
+        return queueImage(packetImage<Cmd, Param>());
+    }
+
+    bool queueCommand(uint32_t cmd_code, int32_t param = 0);
+    bool queueAxisControl(const AxisCommand& axis_cmd);
+    bool queueImage(const PacketImage& image) { return queueRaw(image.data, image.size); }
+
+    // 复制已编码好的数据包到发送槽位，槽位满时先发出已入队的数据包
+    bool queueRaw(const void* data, size_t len);
+
+    /**
+     * @brief 按入队顺序发出全部已入队的数据包（Linux 下为一次 sendmmsg）
+     * @return 成功发送的数据包个数
+     */
+    size_t flush();
+
+    size_t queuedPackets() const { return batch_.pending(); }
+    const BatchSenderStats& batchStats() const { return batch_.stats(); }
+
+    /**
+     * @brief 记录每个成功发送的数据包（指令回放用），传 nullptr 关闭
+     *
+     * 入队的数据包在 flush() 实际交给内核后才记录，发送失败的不记录。
+     * TelemetryRecorder::record() 为单生产者接口，只应在所有发送都来自同一线程
+     * （例如全部经由 ControlLoop）时启用，且需在开始发送前设置。
+     * recorder 一般使用 TELEMETRY_CHANNEL_COMMAND。
+     */
+    void setRecorder(TelemetryRecorder* recorder);
+
+    uint64_t sentPackets() const { return sent_packets_.load(std::memory_order_relaxed); }
+    uint64_t sendErrors() const { return send_errors_.load(std::memory_order_relaxed); }
+
+private:
+    // 记录到 recorder_（若已设置）
+    void record(const void* data, size_t len);
+
+    SOCKET sock_;
+    BatchSender batch_;
+    TelemetryRecorder* recorder_;
+    std::atomic<uint64_t> sent_packets_;
+    std::atomic<uint64_t> send_errors_;
+};
+
+} // namespace q25
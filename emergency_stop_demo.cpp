@@ -6,7 +6,7 @@
 
 /**
  * @file emergency_stop_demo.cpp
- * @brief 四足机器人急停控制Demo (Windows版)
+ * @brief 四足机器人急停控制Demo (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
  * 运行: emergency_stop_demo.exe
@@ -15,7 +15,7 @@
  *   1. 启动2Hz心跳（每500ms发送一次）
  *   2. 发送站立命令
  *   3. 等待2秒
- *   4. 发送急停命令（机器人会立即停止所有运动并趴下）
+ *   4. 经独立急停通道发送急停命令（3 份冗余，2ms 内发完），机器人立即停止所有运动并趴下
  *   5. 等待1秒后退出
  *
  * 急停说明:
@@ -29,75 +29,52 @@
 
 #include <cstring>
 #include <cstdint>
-#include <thread>
-#include <atomic>
 #include <iostream>
 
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include "control_loop.h"
+#include "estop_lane.h"
+#include "net_platform.h"
+#include "udp_transport.h"
+
+using namespace q25;
 
 // ============ 配置 ============
 const char* ROBOT_IP = "192.168.3.20";
 const int ROBOT_PORT = 43893;
 
-// ============ 命令码 ============
-constexpr uint32_t CMD_HEARTBEAT     = 0x21040001;
-constexpr uint32_t CMD_STAND_UP      = 0x21010202;
-constexpr uint32_t CMD_EMERGENCY_STOP = 0x21010C0E;  // 急停命令
-
-// ============ UDP命令结构 ============
-#pragma pack(push, 1)
-struct UDPCommand {
-    uint32_t code;
-    uint32_t parameters_size;
-    uint32_t type;
-
-    UDPCommand(uint32_t cmd) : code(cmd), parameters_size(0), type(0) {}
-};
-#pragma pack(pop)
-
-// ============ UDP发送函数 ============
-void sendCommand(const char* ip, int port, uint32_t cmd_code) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) return;
-
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
-
-    UDPCommand cmd(cmd_code);
-    sendto(sock, reinterpret_cast<const char*>(&cmd), sizeof(cmd), 0, 
-           (struct sockaddr*)&addr, sizeof(addr));
-
-    closesocket(sock);
-}
+// ============ 发送通道 ============
+// 所有指令复用同一个已 connect 的 socket
+UdpTransport transport;
 
-// ============ 心跳线程 ============
-std::atomic<bool> heartbeat_running(true);
+// ============ 控制循环 ============
+// 心跳与一次性指令由同一个线程统一发送
+ControlLoop loop(transport);
 
-void heartbeatThread() {
-    while (heartbeat_running) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_HEARTBEAT);
-        Sleep(500);  // 500ms = 2Hz
-    }
-}
+// ============ 急停通道 ============
+// 独立 socket（DSCP CS6），不经过控制循环队列，调用线程直接冗余突发发送
+EmergencyStopLane estop_lane;
 
 // ============ 急停函数 ============
 void emergencyStop() {
-    std::cout << "[WARNING] Sending EMERGENCY STOP command!" << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_EMERGENCY_STOP);
+    estop_lane.trigger();
+    // 急停包发出后再停止轴值流，避免控制循环继续发送运动指令
+    loop.stopAxis();
+    std::cout << "[WARNING] EMERGENCY STOP sent!" << std::endl;
 }
 
 // ============ 主函数 ============
 int main() {
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    if (!transport.open(ROBOT_IP, ROBOT_PORT)) {
+        return -1;
+    }
+    if (!estop_lane.open(ROBOT_IP, ROBOT_PORT)) {
+        transport.close();
         return -1;
     }
 
@@ -107,30 +84,35 @@ int main() {
     std::cout << "Target Robot: " << ROBOT_IP << ":" << ROBOT_PORT << std::endl;
     std::cout << std::endl;
 
-    // 启动心跳线程
-    std::thread hb_thread(heartbeatThread);
-    std::cout << "[INFO] Heartbeat thread started (2Hz)" << std::endl;
+    // 启动控制循环（内含2Hz心跳）
+    if (!loop.start()) {
+        estop_lane.close();
+        transport.close();
+        return -1;
+    }
+    std::cout << "[INFO] Control loop started (heartbeat 2Hz)" << std::endl;
 
     // 等待1s确保心跳已启动
-    Sleep(1000);
+    sleepMs(1000);
 
     // 站立
     std::cout << "[INFO] Sending stand up command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_STAND_UP);
+    loop.send<cmd::StandUp>();
     std::cout << "[INFO] Waiting 10 seconds..." << std::endl;
-    Sleep(10000);
+    sleepMs(10000);
 
     // 急停
     emergencyStop();
     std::cout << "[INFO] Robot emergency stopped" << std::endl;
-    Sleep(1000);
+    estop_lane.report(std::cout);
+    sleepMs(1000);
 
-    // 停止心跳线程
-    heartbeat_running = false;
-    hb_thread.join();
+    // 停止控制循环
+    loop.stop();
 
-    // 清理 Winsock
-    WSACleanup();
+    // 关闭发送通道并释放网络环境
+    estop_lane.close();
+    transport.close();
 
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
@@ -0,0 +1,158 @@
+// ====================================================================
+//          Created:    2026/10/14/ 14:05
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file fleet_control_demo.cpp
+ * @brief 多机器人集群控制Demo - 单个事件循环线程管理多台机器人 (Windows / Linux)
+ *
+ * 编译: 使用 CMake 或 Visual Studio
+ * 运行: fleet_control_demo.exe [配置文件]
+ *       未指定时读取当前目录下的 fleet.conf（示例见 config/fleet.conf）
+ *
+ * 流程:
+ *   1. 注册配置中的全部机器人，启动集群事件循环（每台各自 2Hz 心跳）
+ *   2. 所有机器人站立
+ *   3. 等待10秒确保站立完成
+ *   4. 所有机器人同时前进2秒（运动段由事件循环的定时器结束）
+ *   5. 停止并趴下，输出每台机器人的最新状态与集群统计后退出
+ *
+ * 注意:
+ *   - 各机器人需配置为把状态上报到 fleet.bind_ip:fleet.local_port
+ *   - 状态按源 IP 归属到机器人，同一 IP 只能注册一次
+ */
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "fleet_controller.h"
+#include "fleet_setup.h"
+#include "net_platform.h"
+#include "trace.h"
+
+using namespace q25;
+
+// ============ 轴值定义 ============
+constexpr int32_t AXIS_FORWARD = 500;  // 前进，轴值区间 [-1000, 1000]
+
+void printRobotStatus(const FleetController& fleet, const std::vector<std::string>& names) {
+    for (size_t i = 0; i < fleet.robotCount(); i++) {
+        RobotStatus status;
+        if (!fleet.status(static_cast<int>(i), status)) {
+            continue;
+        }
+        std::cout << "  [" << i << "] " << names[i] << ": " << (status.online ? "online" : "offline")
+                  << ", " << status.packets << " status packets";
+        if (status.valid & RobotStatus::HAS_BATTERY) {
+            std::cout << ", battery " << std::fixed << std::setprecision(1)
+                      << status.battery.percentage << "%";
+        }
+        if (status.valid & RobotStatus::HAS_MOTION) {
+            std::cout << ", gait " << status.motion.gait << ", mode " << status.motion.motion_mode;
+        }
+        std::cout << std::endl;
+    }
+}
+
+// ============ 主函数 ============
+int main(int argc, char* argv[]) {
+    const char* config_path = argc > 1 ? argv[1] : "fleet.conf";
+    Config config;
+    if (!config.load(config_path)) {
+        if (argc > 1) {
+            std::cerr << "[ERROR] Cannot open config file: " << config_path << std::endl;
+            return -1;
+        }
+        std::cout << "[INFO] " << config_path << " not found, using a single default robot" << std::endl;
+    }
+
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    // FleetController 需在 NetworkRuntime 之前析构（关闭 socket），放在独立作用域中
+    {
+        FleetController fleet(loadFleetConfig(config));
+
+        std::vector<std::string> names = fleetRobotList(config);
+        if (!addRobots(fleet, names)) {
+            return -1;
+        }
+
+        std::cout << "========================================" << std::endl;
+        std::cout << "  Quadruped Robot Fleet Control Demo" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "Robots: " << fleet.robotCount() << std::endl;
+        std::cout << std::endl;
+
+        if (!fleet.start()) {
+            return -1;
+        }
+        std::cout << "[INFO] Fleet event loop started (heartbeat 2Hz per robot)" << std::endl;
+
+        // 等待1s确保心跳已启动
+        sleepMs(1000);
+
+        std::cout << "[INFO] Sending stand up command to all robots..." << std::endl;
+        for (size_t i = 0; i < fleet.robotCount(); i++) {
+            fleet.send<cmd::StandUp>(static_cast<int>(i));
+        }
+        std::cout << "[INFO] Waiting 10 seconds for stand up..." << std::endl;
+        sleepMs(10000);
+
+        std::cout << "[INFO] Moving all robots forward 2s..." << std::endl;
+        AxisCommand forward;
+        forward.left_x = 0;
+        forward.left_y = AXIS_FORWARD;
+        forward.right_x = 0;
+        forward.right_y = 0;
+        for (size_t i = 0; i < fleet.robotCount(); i++) {
+            fleet.setAxis(static_cast<int>(i), forward, 2000);
+        }
+        sleepMs(3000);
+
+        std::cout << "[INFO] Sending lie down command to all robots..." << std::endl;
+        for (size_t i = 0; i < fleet.robotCount(); i++) {
+            fleet.send<cmd::LieDown>(static_cast<int>(i));
+        }
+        sleepMs(1000);
+
+        std::cout << "[INFO] Robot status:" << std::endl;
+        printRobotStatus(fleet, names);
+
+        fleet.stop();
+
+        FleetStats stats = fleet.stats();
+        std::cout << "[INFO] Fleet: " << stats.heartbeats << " heartbeats, "
+                  << stats.axis_packets << " axis packets, "
+                  << stats.suppressed_axis << " unchanged axis suppressed, "
+                  << stats.commands << " commands, "
+                  << stats.status_packets << " status packets, "
+                  << stats.unknown_source << " from unknown sources, "
+                  << stats.stale_status << " status timeouts, "
+                  << stats.send_errors << " send errors, "
+                  << stats.send_syscalls << " send syscalls" << std::endl;
+    }
+
+    // 以 Q25_ENABLE_TRACE 构建时导出事件循环的跟踪事件（心跳、批量发送、状态接收）
+    std::string trace_file = config.getString("trace.file", "");
+    if (!trace_file.empty()) {
+        if (traceEnabled()) {
+            traceDump(trace_file);
+        } else {
+            std::cerr << "[WARNING] trace.file requires a build with -DQ25_ENABLE_TRACE=ON" << std::endl;
+        }
+    }
+
+
+    std::cout << "[INFO] Demo finished" << std::endl;
+    return 0;
+}
@@ -6,7 +6,7 @@
 
 /**
  * @file height_control_demo.cpp
- * @brief 四足机器人高度调节Demo (Windows版)
+ * @brief 四足机器人高度调节Demo (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
  * 运行: height_control_demo.exe
@@ -15,11 +15,11 @@
  *   1. 启动2Hz心跳（每500ms发送一次）
  *   2. 发送站立命令
  *   3. 设置匍匐
- *   4. 等待2秒
+ *   4. 等待运动状态上报的机身高度变化
  *   5. 设置中高度
- *   6. 等待2秒
+ *   6. 等待运动状态上报的机身高度变化
  *   7. 设置高高度
- *   8. 等待2秒
+ *   8. 等待运动状态上报的机身高度变化
  *   9. 趴下并退出
  *
  * 高度说明:
@@ -30,89 +30,58 @@
 
 #include <cstring>
 #include <cstdint>
-#include <thread>
-#include <atomic>
 #include <iostream>
 
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include "control_loop.h"
+#include "motion_monitor.h"
+#include "net_platform.h"
+#include "udp_transport.h"
+
+using namespace q25;
 
 // ============ 配置 ============
 const char* ROBOT_IP = "192.168.3.20";
 const int ROBOT_PORT = 43893;
 
-// ============ 命令码 ============
-constexpr uint32_t CMD_HEARTBEAT     = 0x21040001;
-constexpr uint32_t CMD_STAND_UP      = 0x21010202;
-constexpr uint32_t CMD_LIE_DOWN      = 0x21010222;
-constexpr uint32_t CMD_CHANGE_HEIGHT = 0x21010406;  // 高度调节
-
-// ============ 高度值定义 ============
-constexpr int32_t HEIGHT_LOW    = 0;  // 匍匐
-constexpr int32_t HEIGHT_HIGH   = 2;  // 正常高度
-
-// ============ UDP命令结构 ============
-#pragma pack(push, 1)
-struct UDPCommand {
-    uint32_t code;
-    uint32_t parameters_size;  // 对于高度指令，这个字段存储高度值
-    uint32_t type;
-
-    UDPCommand(uint32_t cmd, int32_t param = 0)
-        : code(cmd)
-        , parameters_size(static_cast<uint32_t>(param))
-        , type(0) {}
-};
-#pragma pack(pop)
-
-// ============ UDP发送函数 ============
-void sendCommand(const char* ip, int port, uint32_t cmd_code, int32_t param = 0) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) return;
-
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
-
-    UDPCommand cmd(cmd_code, param);
-    sendto(sock, reinterpret_cast<const char*>(&cmd), sizeof(cmd), 0, 
-           (struct sockaddr*)&addr, sizeof(addr));
-
-    closesocket(sock);
-}
+// 站立 / 趴下及高度变化以上报的机身高度判定，依赖暂定的 MotionData 布局（见 status_protocol.h）
+// 状态等待超时（毫秒），超时后给出警告并继续
+const int STAND_TIMEOUT_MS = 15000;
+const int TRANSITION_TIMEOUT_MS = 10000;
+const float HEIGHT_TOLERANCE_M = 0.02f;  // 机身高度变化超过该值视为调节已生效
 
-// ============ 心跳线程 ============
-std::atomic<bool> heartbeat_running(true);
+// ============ 发送通道 ============
+// 所有指令复用同一个已 connect 的 socket
+UdpTransport transport;
 
-void heartbeatThread() {
-    while (heartbeat_running) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_HEARTBEAT);
-        Sleep(500);  // 500ms = 2Hz
-    }
-}
+// ============ 控制循环 ============
+// 心跳与一次性指令由同一个线程统一发送
+ControlLoop loop(transport);
+
+// ============ 状态监视 ============
+// 接收机器人上报的运动状态，指令发出后等待到达目标状态，而不是固定 Sleep
+MotionMonitor monitor;
 
 // ============ 高度调节函数 ============
 
 void setHeightLow() {
     std::cout << "[INFO] Setting low height..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_CHANGE_HEIGHT, HEIGHT_LOW);
+    loop.send<cmd::ChangeHeight, HEIGHT_LOW>();
 }
 
 void setNormalHigh() {
     std::cout << "[INFO] Setting normal height..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_CHANGE_HEIGHT, HEIGHT_HIGH);
+    loop.send<cmd::ChangeHeight, HEIGHT_HIGH>();
 }
 
 // ============ 主函数 ============
 int main() {
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    if (!transport.open(ROBOT_IP, ROBOT_PORT)) {
         return -1;
     }
 
@@ -122,39 +91,51 @@ int main() {
     std::cout << "Target Robot: " << ROBOT_IP << ":" << ROBOT_PORT << std::endl;
     std::cout << std::endl;
 
-    // 启动心跳线程
-    std::thread hb_thread(heartbeatThread);
-    std::cout << "[INFO] Heartbeat thread started (2Hz)" << std::endl;
+    // 启动控制循环（内含2Hz心跳）
+    if (!loop.start()) {
+        transport.close();
+        return -1;
+    }
+    std::cout << "[INFO] Control loop started (heartbeat 2Hz)" << std::endl;
+
+    // 机器人需把状态上报到本机 DEFAULT_LOCAL_PORT；监视未启动时各等待退化为固定时长
+    if (!monitor.start()) {
+        std::cout << "[WARNING] Status monitor unavailable, falling back to fixed waits" << std::endl;
+    }
 
     // 等待1s确保心跳已启动
-    Sleep(1000);
+    sleepMs(1000);
 
     // 站立
     std::cout << "[INFO] Sending stand up command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_STAND_UP);
-    Sleep(10000);
+    loop.send<cmd::StandUp>();
+    monitor.await("Stand up", bodyHeightAbove(STAND_BODY_HEIGHT_M), STAND_TIMEOUT_MS);
+
+    // 调节高度：以调节前上报的机身高度为基准，等待高度变化
+    MotionData before;
+    memset(&before, 0, sizeof(before));
 
     // 设置匍匐
+    before = monitor.latestOr(before);
     setHeightLow();
-    std::cout << "[INFO] Waiting 10 seconds..." << std::endl;
-    Sleep(10000);
+    monitor.await("Low height", bodyHeightChangedFrom(before.body_height, HEIGHT_TOLERANCE_M), TRANSITION_TIMEOUT_MS);
 
     // 设置正常高度
+    before = monitor.latestOr(before);
     setNormalHigh();
-    std::cout << "[INFO] Waiting 10 seconds..." << std::endl;
-    Sleep(10000);
+    monitor.await("Normal height", bodyHeightChangedFrom(before.body_height, HEIGHT_TOLERANCE_M), TRANSITION_TIMEOUT_MS);
 
     // 趴下
     std::cout << "[INFO] Sending lie down command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LIE_DOWN);
-    Sleep(1000);
+    loop.send<cmd::LieDown>();
+    monitor.await("Lie down", bodyHeightBelow(LIE_BODY_HEIGHT_M), TRANSITION_TIMEOUT_MS);
 
-    // 停止心跳线程
-    heartbeat_running = false;
-    hb_thread.join();
+    // 停止状态监视与控制循环
+    monitor.stop();
+    loop.stop();
 
-    // 清理 Winsock
-    WSACleanup();
+    // 关闭发送通道并释放网络环境
+    transport.close();
 
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
@@ -0,0 +1,162 @@
+// ====================================================================
+//          Created:    2026/10/14/ 18:00
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file mission_demo.cpp
+ * @brief 任务脚本Demo - 集群事件循环在多台机器人上同时执行任务文件 (Windows / Linux)
+ *
+ * 编译: 使用 CMake 或 Visual Studio
+ * 运行: mission_demo.exe <配置文件> <任务文件> [任务文件...]
+ *       例: mission_demo.exe config/fleet.conf config/missions/stand_lie.mission
+ *       给出多个任务文件时按机器人编号轮流分配（第 i 台执行第 i % N 个）
+ *
+ * 流程:
+ *   1. 编译全部任务文件，有语法错误时直接退出
+ *   2. 注册配置中的全部机器人，启动集群事件循环（每台各自 2Hz 心跳）
+ *   3. 各机器人开始执行任务：指令、等待状态、轴值路线都在事件循环线程中推进
+ *   4. 全部任务结束后输出每台机器人的结果与集群统计后退出
+ *
+ * 任务文件格式见 common/mission.h，示例见 config/missions/。
+ *
+ * 注意:
+ *   - 各机器人需配置为把状态上报到 fleet.bind_ip:fleet.local_port，
+ *     await 依赖上报的运动状态，收不到状态时每个 await 都会等到超时
+ *   - await stand / lie / height_* 按机身高度判定，MotionData 布局为暂定（见 status_protocol.h），
+ *     与真机不符时这些等待会提前结束或超时
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "fleet_controller.h"
+#include "fleet_setup.h"
+#include "mission.h"
+#include "net_platform.h"
+
+using namespace q25;
+
+const char* missionStateName(uint32_t state) {
+    switch (state) {
+    case MISSION_IDLE:    return "idle";
+    case MISSION_RUNNING: return "running";
+    case MISSION_DONE:    return "completed";
+    case MISSION_FAILED:  return "failed";
+    case MISSION_ABORTED: return "aborted";
+    default:              return "unknown";
+    }
+}
+
+// ============ 主函数 ============
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <config file> <mission file> [mission file...]" << std::endl;
+        return -1;
+    }
+
+    Config config;
+    if (!config.load(argv[1])) {
+        std::cerr << "[ERROR] Cannot open config file: " << argv[1] << std::endl;
+        return -1;
+    }
+
+    // 任务只在启动时编译一次，执行期间各机器人共用
+    std::vector<Mission> missions(static_cast<size_t>(argc - 2));
+    for (size_t i = 0; i < missions.size(); i++) {
+        if (!loadMission(argv[i + 2], missions[i])) {
+            return -1;
+        }
+        std::cout << "[INFO] Mission " << missions[i].name << ": " << missions[i].steps.size()
+                  << " steps, " << missions[i].segments.size() << " route segments" << std::endl;
+    }
+
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    int exit_code = 0;
+    // FleetController 需在 NetworkRuntime 之前析构（关闭 socket），放在独立作用域中
+    {
+        FleetController fleet(loadFleetConfig(config));
+
+        std::vector<std::string> names = fleetRobotList(config);
+        if (!addRobots(fleet, names)) {
+            return -1;
+        }
+
+        std::cout << "========================================" << std::endl;
+        std::cout << "  Quadruped Robot Mission Demo" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "Robots: " << fleet.robotCount() << ", missions: " << missions.size() << std::endl;
+        std::cout << std::endl;
+
+        if (!fleet.start()) {
+            return -1;
+        }
+        std::cout << "[INFO] Fleet event loop started (heartbeat 2Hz per robot)" << std::endl;
+
+        // 等待1s确保心跳已启动
+        sleepMs(1000);
+
+        std::vector<uint32_t> states(fleet.robotCount(), MISSION_IDLE);
+        std::vector<bool> started(fleet.robotCount(), true);
+        for (size_t i = 0; i < fleet.robotCount(); i++) {
+            const Mission& mission = missions[i % missions.size()];
+            if (!fleet.runMission(static_cast<int>(i), mission)) {
+                std::cerr << "[ERROR] Failed to start mission " << mission.name
+                          << " on robot " << i << std::endl;
+                started[i] = false;
+            }
+        }
+
+        // 任务由事件循环推进，这里只轮询进度
+        bool running = true;
+        while (running) {
+            sleepMs(100);
+            running = false;
+            for (size_t i = 0; i < states.size(); i++) {
+                RobotStatus status;
+                if (!started[i]) {
+                    continue;
+                }
+                if (fleet.status(static_cast<int>(i), status)) {
+                    states[i] = status.mission_state;
+                }
+                if (states[i] == MISSION_IDLE || states[i] == MISSION_RUNNING) {
+                    running = true;
+                }
+            }
+        }
+
+        std::cout << "[INFO] Mission results:" << std::endl;
+        for (size_t i = 0; i < states.size(); i++) {
+            std::cout << "  [" << i << "] " << names[i] << ": "
+                      << missions[i % missions.size()].name << " "
+                      << missionStateName(states[i]) << std::endl;
+            if (states[i] != MISSION_DONE) {
+                exit_code = 1;
+            }
+        }
+
+        fleet.stop();
+
+        FleetStats stats = fleet.stats();
+        std::cout << "[INFO] Fleet: " << stats.missions_completed << " missions completed, "
+                  << stats.missions_failed << " failed, "
+                  << stats.missions_aborted << " aborted, "
+                  << stats.commands << " commands, "
+                  << stats.axis_packets << " axis packets, "
+                  << stats.status_packets << " status packets, "
+                  << stats.stale_status << " status timeouts" << std::endl;
+    }
+
+    std::cout << "[INFO] Demo finished" << std::endl;
+    return exit_code;
+}
@@ -6,7 +6,7 @@
 
 /**
  * @file motion_mode_demo.cpp
- * @brief 四足机器人运动模式切换Demo (Windows版)
+ * @brief 四足机器人运动模式切换Demo (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
  * 运行: motion_mode_demo.exe
@@ -14,11 +14,11 @@
  * 流程:
  *   1. 启动2Hz心跳（每500ms发送一次）
  *   2. 切换到手动模式
- *   3. 等待3秒
+ *   3. 等待运动状态上报的模式变化（最多3秒）
  *   4. 切换到导航模式
- *   5. 等待3秒
+ *   5. 等待运动状态上报的模式变化（最多3秒）
  *   6. 切换到辅助模式
- *   7. 等待1秒后退出
+ *   7. 等待运动状态上报的模式变化后退出
  *
  * 运动模式说明:
  *   - 手动模式(MANUAL): 机器人响应手动控制指令
@@ -28,90 +28,63 @@
 
 #include <cstring>
 #include <cstdint>
-#include <thread>
-#include <atomic>
 #include <iostream>
 
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include "control_loop.h"
+#include "motion_monitor.h"
+#include "net_platform.h"
+#include "udp_transport.h"
+
+using namespace q25;
 
 // ============ 配置 ============
 const char* ROBOT_IP = "192.168.3.20";
 const int ROBOT_PORT = 43893;
 
-// ============ 命令码 ============
-constexpr uint32_t CMD_HEARTBEAT      = 0x21040001;
-constexpr uint32_t CMD_MANUAL_MODE    = 0x21010C02;  // 手动模式
-constexpr uint32_t CMD_NAVI_MODE      = 0x21010C03;  // 导航模式
-constexpr uint32_t CMD_ASSISTANT_MODE = 0x21010C04;  // 辅助模式
-
-// ============ UDP命令结构 ============
-#pragma pack(push, 1)
-struct UDPCommand {
-    uint32_t code;
-    uint32_t parameters_size;
-    uint32_t type;
-
-    UDPCommand(uint32_t cmd) : code(cmd), parameters_size(0), type(0) {}
-};
-#pragma pack(pop)
-
-// ============ UDP发送函数 ============
-void sendCommand(const char* ip, int port, uint32_t cmd_code) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) return;
-
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
-
-    UDPCommand cmd(cmd_code);
-    sendto(sock, reinterpret_cast<const char*>(&cmd), sizeof(cmd), 0, 
-           (struct sockaddr*)&addr, sizeof(addr));
-
-    closesocket(sock);
-}
+// 模式切换等待超时（毫秒），超时后给出警告并继续
+const int MODE_TIMEOUT_MS = 3000;
 
-// ============ 心跳线程 ============
-std::atomic<bool> heartbeat_running(true);
+// ============ 发送通道 ============
+// 所有指令复用同一个已 connect 的 socket
+UdpTransport transport;
 
-void heartbeatThread() {
-    while (heartbeat_running) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_HEARTBEAT);
-        Sleep(500);  // 500ms = 2Hz
-    }
-}
+// ============ 控制循环 ============
+// 心跳与一次性指令由同一个线程统一发送
+ControlLoop loop(transport);
+
+// ============ 状态监视 ============
+// 接收机器人上报的运动状态，指令发出后等待到达目标状态，而不是固定 Sleep
+MotionMonitor monitor;
 
 // ============ 模式切换函数 ============
 
 // 切换到手动模式
 void switchToManualMode() {
     std::cout << "[INFO] Switching to Manual mode..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_MANUAL_MODE);
+    loop.send<cmd::ManualMode>();
 }
 
 // 切换到导航模式
 void switchToNaviMode() {
     std::cout << "[INFO] Switching to Navigation mode..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_NAVI_MODE);
+    loop.send<cmd::NaviMode>();
 }
 
 // 切换到辅助模式
 void switchToAssistantMode() {
     std::cout << "[INFO] Switching to Assistant mode..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_ASSISTANT_MODE);
+    loop.send<cmd::AssistantMode>();
 }
 
 // ============ 主函数 ============
 int main() {
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    if (!transport.open(ROBOT_IP, ROBOT_PORT)) {
         return -1;
     }
 
@@ -121,34 +94,46 @@ int main() {
     std::cout << "Target Robot: " << ROBOT_IP << ":" << ROBOT_PORT << std::endl;
     std::cout << std::endl;
 
-    // 启动心跳线程
-    std::thread hb_thread(heartbeatThread);
-    std::cout << "[INFO] Heartbeat thread started (2Hz)" << std::endl;
+    // 启动控制循环（内含2Hz心跳）
+    if (!loop.start()) {
+        transport.close();
+        return -1;
+    }
+    std::cout << "[INFO] Control loop started (heartbeat 2Hz)" << std::endl;
+
+    // 机器人需把状态上报到本机 DEFAULT_LOCAL_PORT；监视未启动时各等待退化为固定时长
+    if (!monitor.start()) {
+        std::cout << "[WARNING] Status monitor unavailable, falling back to fixed waits" << std::endl;
+    }
 
     // 等待1s确保心跳已启动
-    Sleep(1000);
+    sleepMs(1000);
+
+    // 切换模式：以切换前上报的模式为基准，等待上报值变化
+    MotionData before;
+    memset(&before, 0, sizeof(before));
 
     // 切换到手动模式
+    before = monitor.latestOr(before);
     switchToManualMode();
-    std::cout << "[INFO] Waiting 3 seconds..." << std::endl;
-    Sleep(3000);
+    monitor.await("Manual mode", modeChangedFrom(before.motion_mode), MODE_TIMEOUT_MS);
 
     // 切换到导航模式
+    before = monitor.latestOr(before);
     switchToNaviMode();
-    std::cout << "[INFO] Waiting 3 seconds..." << std::endl;
-    Sleep(3000);
+    monitor.await("Navigation mode", modeChangedFrom(before.motion_mode), MODE_TIMEOUT_MS);
 
     // 切换到辅助模式
+    before = monitor.latestOr(before);
     switchToAssistantMode();
-    std::cout << "[INFO] Waiting 1 second..." << std::endl;
-    Sleep(1000);
+    monitor.await("Assistant mode", modeChangedFrom(before.motion_mode), MODE_TIMEOUT_MS);
 
-    // 停止心跳线程
-    heartbeat_running = false;
-    hb_thread.join();
+    // 停止状态监视与控制循环
+    monitor.stop();
+    loop.stop();
 
-    // 清理 Winsock
-    WSACleanup();
+    // 关闭发送通道并释放网络环境
+    transport.close();
 
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
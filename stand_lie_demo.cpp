@@ -6,7 +6,7 @@
 
 /**
  * @file stand_lie_demo.cpp
- * @brief 四足机器人完整Demo - 心跳+站立+趴下 (Windows版)
+ * @brief 四足机器人完整Demo - 心跳+站立+趴下 (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
  * 运行: stand_lie_demo.exe
@@ -14,76 +14,52 @@
  * 流程:
  *   1. 启动2Hz心跳（每500ms发送一次）
  *   2. 发送站立命令
- *   3. 等待3秒
+ *   3. 等待运动状态上报站立完成（机身高度）
  *   4. 发送趴下命令
- *   5. 等待1秒后退出
+ *   5. 等待上报趴下完成后退出
  */
 
 #include <cstring>
 #include <cstdint>
-#include <thread>
-#include <atomic>
 #include <iostream>
 
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include "control_loop.h"
+#include "motion_monitor.h"
+#include "net_platform.h"
+#include "udp_transport.h"
+
+using namespace q25;
 
 // ============ 配置 ============
 const char* ROBOT_IP = "192.168.3.20";
 const int ROBOT_PORT = 43893;
 
-// ============ 命令码 ============
-constexpr uint32_t CMD_HEARTBEAT = 0x21040001;
-constexpr uint32_t CMD_STAND_UP  = 0x21010202;
-constexpr uint32_t CMD_LIE_DOWN  = 0x21010222;
-
-// ============ UDP命令结构 ============
-#pragma pack(push, 1)
-struct UDPCommand {
-    uint32_t code;
-    uint32_t parameters_size;
-    uint32_t type;
-
-    UDPCommand(uint32_t cmd) : code(cmd), parameters_size(0), type(0) {}
-};
-#pragma pack(pop)
-
-// ============ UDP发送函数 ============
-void sendCommand(const char* ip, int port, uint32_t cmd_code) {
-    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sock == INVALID_SOCKET) return;
-
-    struct sockaddr_in addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ip, &addr.sin_addr);
-
-    UDPCommand cmd(cmd_code);
-    sendto(sock, reinterpret_cast<const char*>(&cmd), sizeof(cmd), 0, 
-           (struct sockaddr*)&addr, sizeof(addr));
-
-    closesocket(sock);
-}
+// 站立 / 趴下以上报的机身高度判定，依赖暂定的 MotionData 布局（见 status_protocol.h）
+// 状态等待超时（毫秒），超时后给出警告并继续
+const int STAND_TIMEOUT_MS = 15000;
+const int TRANSITION_TIMEOUT_MS = 10000;
 
-// ============ 心跳线程 ============
-std::atomic<bool> heartbeat_running(true);
+// ============ 发送通道 ============
+// 所有指令复用同一个已 connect 的 socket
+UdpTransport transport;
 
-void heartbeatThread() {
-    while (heartbeat_running) {
-        sendCommand(ROBOT_IP, ROBOT_PORT, CMD_HEARTBEAT);
-        Sleep(500);  // 500ms = 2Hz
-    }
-}
+// ============ 控制循环 ============
+// 心跳与一次性指令由同一个线程统一发送
+ControlLoop loop(transport);
+
+// ============ 状态监视 ============
+// 接收机器人上报的运动状态，指令发出后等待到达目标状态，而不是固定 Sleep
+MotionMonitor monitor;
 
 // ============ 主函数 ============
 int main() {
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    if (!transport.open(ROBOT_IP, ROBOT_PORT)) {
         return -1;
     }
 
@@ -93,34 +69,37 @@ int main() {
     std::cout << "Target Robot: " << ROBOT_IP << ":" << ROBOT_PORT << std::endl;
     std::cout << std::endl;
 
-    // 启动心跳线程
-    std::thread hb_thread(heartbeatThread);
-    std::cout << "[INFO] Heartbeat thread started (2Hz)" << std::endl;
+    // 启动控制循环（内含2Hz心跳）
+    if (!loop.start()) {
+        transport.close();
+        return -1;
+    }
+    std::cout << "[INFO] Control loop started (heartbeat 2Hz)" << std::endl;
+
+    // 机器人需把状态上报到本机 DEFAULT_LOCAL_PORT；监视未启动时各等待退化为固定时长
+    if (!monitor.start()) {
+        std::cout << "[WARNING] Status monitor unavailable, falling back to fixed waits" << std::endl;
+    }
 
     // 等待1s确保心跳已启动
-    Sleep(1000);
+    sleepMs(1000);
 
     // 站立
     std::cout << "[INFO] Sending stand up command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_STAND_UP);
-
-    // 等待3秒
-    std::cout << "[INFO] Waiting 10 seconds..." << std::endl;
-    Sleep(10000);
+    loop.send<cmd::StandUp>();
+    monitor.await("Stand up", bodyHeightAbove(STAND_BODY_HEIGHT_M), STAND_TIMEOUT_MS);
 
     // 趴下
     std::cout << "[INFO] Sending lie down command..." << std::endl;
-    sendCommand(ROBOT_IP, ROBOT_PORT, CMD_LIE_DOWN);
-
-    // 等待1秒
-    Sleep(1000);
+    loop.send<cmd::LieDown>();
+    monitor.await("Lie down", bodyHeightBelow(LIE_BODY_HEIGHT_M), TRANSITION_TIMEOUT_MS);
 
-    // 停止心跳线程
-    heartbeat_running = false;
-    hb_thread.join();
+    // 停止状态监视与控制循环
+    monitor.stop();
+    loop.stop();
 
-    // 清理 Winsock
-    WSACleanup();
+    // 关闭发送通道并释放网络环境
+    transport.close();
 
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
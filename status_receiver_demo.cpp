@@ -6,10 +6,12 @@
 
 /**
  * @file status_receiver_demo.cpp
- * @brief 四足机器人状态接收Demo - 接收机器人上报的状态数据 (Windows版)
+ * @brief 四足机器人状态接收Demo - 接收机器人上报的状态数据 (Windows / Linux)
  *
  * 编译: 使用 CMake 或 Visual Studio
- * 运行: status_receiver_demo.exe
+ * 运行: status_receiver_demo.exe [配置文件]
+ *       不指定时读取当前目录下的 status_receiver.conf，不存在则使用内置默认值
+ *       (示例见 config/status_receiver.conf)
  *
  * ============================================================================
  *                              网络配置说明
@@ -41,177 +43,307 @@
 #include <cstdint>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
 #include <iostream>
-#include <iomanip>
-#include <algorithm>
-
-// Windows 特定头文件
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
+#include <string>
+
+#include "alloc_counter.h"
+#include "batch_receiver.h"
+#include "config.h"
+#include "joint_state.h"
+#include "net_platform.h"
+#include "packet_ring.h"
+#include "socket_options.h"
+#include "status_cache.h"
+#include "status_change.h"
+#include "status_dispatcher.h"
+#include "status_logger.h"
+#include "stream_metrics.h"
+#include "telemetry_recorder.h"
+#include "thread_utils.h"
+#include "time_series.h"
+#include "trace.h"
+
+using namespace q25;
 
 // ============ 配置 ============
-// 本机监听配置（需与机器人端配置的目标地址一致）
-const char* LOCAL_IP = "192.168.3.157";  // 本机IP
-const int LOCAL_PORT = 43893;            // 监听端口
-
-// 接收缓冲区大小
-constexpr size_t RECV_BUFFER_SIZE = 65535;
-
-// ============ 数据包类型标识 ============
-// 根据实际协议定义，这里列出常见的数据类型
-constexpr uint32_t DATA_TYPE_BATTERY  = 0x01;  // 电池数据
-constexpr uint32_t DATA_TYPE_IMU      = 0x02;  // IMU数据
-constexpr uint32_t DATA_TYPE_JOINT    = 0x03;  // 关节数据
-constexpr uint32_t DATA_TYPE_MOTION   = 0x04;  // 运动状态
-constexpr uint32_t DATA_TYPE_SYSTEM   = 0x05;  // 系统信息
-
-// ============ 数据结构定义 ============
-#pragma pack(push, 1)
-
-// 通用数据包头
-struct PacketHeader {
-    uint32_t type;        // 数据类型
-    uint32_t length;      // 数据长度
-    uint64_t timestamp;   // 时间戳
-};
-
-// 电池数据
-struct BatteryData {
-    float voltage;        // 电压 (V)
-    float current;        // 电流 (A)
-    float percentage;     // 电量百分比 (0-100)
-    float temperature;    // 温度 (℃)
-};
-
-// IMU数据
-struct IMUData {
-    // 姿态角 (rad)
-    float roll;
-    float pitch;
-    float yaw;
-    // 角速度 (rad/s)
-    float gyro_x;
-    float gyro_y;
-    float gyro_z;
-    // 加速度 (m/s^2)
-    float acc_x;
-    float acc_y;
-    float acc_z;
+// 默认配置文件名（可通过命令行参数指定其他路径）
+const char* DEFAULT_CONFIG_PATH = "status_receiver.conf";
+
+// 接收等待超时，用于定期检查退出标志
+constexpr int RECV_TIMEOUT_MS = 100;
+
+// IMU / 运动状态超过该时间未更新时告警
+constexpr int64_t STALE_STATUS_NS = 1000000000;
+
+// 接收端运行参数，默认值即未调优时的行为
+struct ReceiverSettings {
+    // 本机监听配置（需与机器人端配置的目标地址一致）
+    std::string bind_ip;    // 默认 0.0.0.0，监听所有网卡
+    int local_port;
+
+    SocketTuning tuning;    // SO_RCVBUF / busy-poll 等
+
+    // 批量接收：预投递缓冲区个数（单次系统调用最多取回的数据报数）
+    int batch_size;
+    // 接收线程与处理线程之间的数据包缓冲：槽位数 x 每槽字节数
+    int ring_capacity;
+    int slot_size;
+
+    int recv_cpu_core;      // 接收线程绑定的 CPU 核，-1 不绑定
+    bool recv_realtime;     // 接收线程提升为实时优先级
+    int proc_cpu_core;      // 处理线程绑定的 CPU 核，-1 不绑定
+
+    // 控制台日志限频：每种数据类型每秒最多输出行数
+    double log_lines_per_sec;
+
+    // 每种数据类型的到达率 / 抖动 / 延迟 / 丢包统计
+    StreamMetricsConfig metrics;
+
+    // IMU / 关节速度历史：保留时长、按最高频率估算容量、滑动统计窗口
+    double history_sec;
+    double history_rate_hz;
+    double history_window_sec;
+    int history_joints;
+
+    // 关节健康检查阈值（<= 0 不检查）
+    JointLimits joint_limits;
+
+    // 步态 / 模式 / 系统信息变化检测的死区与里程档位
+    ChangeDetectorConfig changes;
+
+    // 原始数据报记录（默认关闭）
+    bool record_enabled;
+    TelemetryRecorderConfig recorder;
+
+    // 稳态零分配检查（需以 Q25_COUNT_ALLOCATIONS 构建）：预热后接收 / 处理线程再有堆分配即退出
+    bool alloc_check;
+    int alloc_warmup_iterations;
+
+    // 跟踪点导出（需以 Q25_ENABLE_TRACE 构建）：退出时写入的 Chrome trace 文件，空表示不导出
+    std::string trace_file;
+    int trace_buffer_events;
+
+    ReceiverSettings()
+        : bind_ip("0.0.0.0")
+        , local_port(DEFAULT_LOCAL_PORT)
+        , batch_size(32)
+        , ring_capacity(1024)
+        , slot_size(4096)
+        , recv_cpu_core(-1)
+        , recv_realtime(false)
+        , proc_cpu_core(-1)
+        , log_lines_per_sec(1.0)
+        , history_sec(4.0)
+        , history_rate_hz(500.0)
+        , history_window_sec(1.0)
+        , history_joints(12)
+        , record_enabled(false)
+        , alloc_check(false)
+        , alloc_warmup_iterations(1000)
+        , trace_buffer_events(16384) {}
 };
 
-// 单关节数据
-struct JointData {
-    float position;       // 位置 (rad)
-    float velocity;       // 速度 (rad/s)
-    float torque;         // 力矩 (Nm)
-    float temperature;    // 温度 (℃)
-};
-
-#pragma pack(pop)
+ReceiverSettings loadSettings(const Config& config) {
+    ReceiverSettings settings;
+    settings.bind_ip = config.getString("receiver.bind_ip", settings.bind_ip);
+    settings.local_port = config.getInt("receiver.local_port", settings.local_port);
+    settings.tuning.recv_buffer_bytes = config.getInt("receiver.rcvbuf_bytes", settings.tuning.recv_buffer_bytes);
+    settings.tuning.busy_poll_us = config.getInt("receiver.busy_poll_us", settings.tuning.busy_poll_us);
+    settings.batch_size = config.getInt("receiver.batch_size", settings.batch_size);
+    settings.ring_capacity = config.getInt("receiver.ring_capacity", settings.ring_capacity);
+    settings.slot_size = config.getInt("receiver.slot_size", settings.slot_size);
+    settings.recv_cpu_core = config.getInt("receiver.cpu_core", settings.recv_cpu_core);
+    settings.recv_realtime = config.getBool("receiver.realtime", settings.recv_realtime);
+    settings.proc_cpu_core = config.getInt("processing.cpu_core", settings.proc_cpu_core);
+    settings.log_lines_per_sec = config.getDouble("log.lines_per_sec", settings.log_lines_per_sec);
+    settings.metrics.timestamp_unit_ns = config.getInt("metrics.timestamp_unit_ns",
+                                                       static_cast<int>(settings.metrics.timestamp_unit_ns));
+    settings.metrics.offset_window_sec = config.getDouble("metrics.offset_window_sec", settings.metrics.offset_window_sec);
+    settings.metrics.report_interval_sec = config.getDouble("metrics.report_interval_sec",
+                                                            settings.metrics.report_interval_sec);
+    settings.history_sec = config.getDouble("history.seconds", settings.history_sec);
+    settings.history_rate_hz = config.getDouble("history.rate_hz", settings.history_rate_hz);
+    settings.history_window_sec = config.getDouble("history.stats_window_sec", settings.history_window_sec);
+    settings.history_joints = config.getInt("history.joints", settings.history_joints);
+    settings.joint_limits.max_abs_velocity = static_cast<float>(
+        config.getDouble("health.max_joint_velocity", settings.joint_limits.max_abs_velocity));
+    settings.joint_limits.max_abs_torque = static_cast<float>(
+        config.getDouble("health.max_joint_torque", settings.joint_limits.max_abs_torque));
+    settings.joint_limits.max_temperature = static_cast<float>(
+        config.getDouble("health.max_joint_temperature", settings.joint_limits.max_temperature));
+    settings.changes.velocity_step = static_cast<float>(
+        config.getDouble("change.velocity_step", settings.changes.velocity_step));
+    settings.changes.height_step_m = static_cast<float>(
+        config.getDouble("change.height_step_m", settings.changes.height_step_m));
+    settings.changes.mileage_bucket_km = static_cast<float>(
+        config.getDouble("change.mileage_bucket_km", settings.changes.mileage_bucket_km));
+    settings.record_enabled = config.getBool("record.enabled", settings.record_enabled);
+    settings.recorder.directory = config.getString("record.directory", settings.recorder.directory);
+    settings.recorder.prefix = config.getString("record.prefix", settings.recorder.prefix);
+    settings.recorder.segment_bytes = static_cast<size_t>(
+        config.getInt("record.segment_mb", static_cast<int>(settings.recorder.segment_bytes >> 20))) << 20;
+    settings.recorder.chunk_bytes = static_cast<size_t>(
+        config.getInt("record.chunk_kb", static_cast<int>(settings.recorder.chunk_bytes >> 10))) << 10;
+    settings.recorder.slot_size = static_cast<size_t>(settings.slot_size);
+    settings.recorder.cpu_core = config.getInt("record.cpu_core", settings.recorder.cpu_core);
+    settings.alloc_check = config.getBool("alloc.check", settings.alloc_check);
+    settings.alloc_warmup_iterations = config.getInt("alloc.warmup_iterations", settings.alloc_warmup_iterations);
+    settings.trace_file = config.getString("trace.file", settings.trace_file);
+    settings.trace_buffer_events = config.getInt("trace.buffer_events", settings.trace_buffer_events);
+    return settings;
+}
 
 // ============ 全局变量 ============
 std::atomic<bool> running(true);
+
+// Ctrl+C 时正常退出，输出汇总统计并导出跟踪文件
+void onSignal(int) {
+    running = false;
+}
 std::atomic<uint64_t> packet_count(0);
+// alloc.check 发现稳态堆分配
+std::atomic<bool> allocation_failed(false);
 
-// ============ 数据解析函数 ============
+// 数据包分发：订阅者直接拿到指向缓冲区的类型化数据
+StatusDispatcher dispatcher;
 
-void parseBatteryData(const uint8_t* data, size_t len) {
-    if (len < sizeof(BatteryData)) return;
+// 各类型的最新快照，处理线程写入，任意线程无锁读取
+StatusCache status_cache;
 
-    const BatteryData* battery = reinterpret_cast<const BatteryData*>(data);
-    std::cout << "[Battery] Capacity: " << std::fixed << std::setprecision(1)
-              << battery->percentage << "%, "
-              << "Voltage: " << battery->voltage << "V, "
-              << "Current: " << battery->current << "A, "
-              << "Temperature: " << battery->temperature << " C" << std::endl;
+// 与 PacketSlot::recv_time_ns 同一时钟
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void parseIMUData(const uint8_t* data, size_t len) {
-    if (len < sizeof(IMUData)) return;
-    
-    const IMUData* imu = reinterpret_cast<const IMUData*>(data);
-    std::cout << "[IMU] Roll: " << std::fixed << std::setprecision(3) 
-              << imu->roll << ", Pitch: " << imu->pitch 
-              << ", Yaw: " << imu->yaw << std::endl;
-}
+// ============ 接收线程 ============
+// 只做接收与入环，环满时丢弃并计数，永远不会被处理线程或记录器阻塞
+// 启用 busy-poll 时不阻塞等待，持续轮询以降低唤醒延迟（占满一个核）
+void receiverThread(BatchReceiver* receiver, PacketRing* ring, TelemetryRecorder* recorder,
+                    const ReceiverSettings* settings) {
+    Q25_TRACE_THREAD("Receiver");
+    pinCurrentThread(settings->recv_cpu_core);
+    if (settings->recv_realtime) {
+        setCurrentThreadRealtime();
+    }
+    int timeout_ms = settings->tuning.busy_poll_us > 0 ? 0 : RECV_TIMEOUT_MS;
+    AllocationWatch alloc_watch("Receiver", static_cast<uint64_t>(settings->alloc_warmup_iterations));
 
-void parseJointData(const uint8_t* data, size_t len) {
-    size_t joint_count = len / sizeof(JointData);
-    std::cout << "[Joint] Total " << joint_count << " joint data" << std::endl;
+    while (running) {
+        // 一次系统调用取回一批数据报
+        size_t count = receiver->receive(timeout_ms);
+        if (count == 0) {
+            continue;
+        }
 
-    // Only print brief info for first 4 joints
-    const JointData* joints = reinterpret_cast<const JointData*>(data);
-    for (size_t i = 0; i < (std::min)(joint_count, (size_t)4); i++) {
-        std::cout << "  Joint" << i << ": pos=" << std::fixed << std::setprecision(2)
-                  << joints[i].position << ", vel=" << joints[i].velocity << std::endl;
-    }
-}
+        int64_t recv_time_ns = steadyNowNs();
 
-void parsePacket(const uint8_t* buffer, size_t len) {
-    if (len < sizeof(PacketHeader)) {
-        std::cout << "[WARNING] Packet too short: " << len << " bytes" << std::endl;
-        return;
-    }
+        for (size_t i = 0; i < count; i++) {
+            const ReceivedDatagram& datagram = receiver->datagram(i);
+            ring->push(datagram.data, datagram.len, datagram.from.sin_addr.s_addr,
+                       datagram.from.sin_port, recv_time_ns);
+            if (recorder != nullptr) {
+                recorder->record(datagram.data, datagram.len, datagram.from.sin_addr.s_addr,
+                                 datagram.from.sin_port, recv_time_ns);
+            }
+        }
 
-    const PacketHeader* header = reinterpret_cast<const PacketHeader*>(buffer);
-    const uint8_t* payload = buffer + sizeof(PacketHeader);
-    size_t payload_len = len - sizeof(PacketHeader);
-
-    switch (header->type) {
-        case DATA_TYPE_BATTERY:
-            parseBatteryData(payload, payload_len);
-            break;
-        case DATA_TYPE_IMU:
-            parseIMUData(payload, payload_len);
-            break;
-        case DATA_TYPE_JOINT:
-            parseJointData(payload, payload_len);
-            break;
-        default:
-            std::cout << "[INFO] Received data type: 0x" << std::hex << header->type
-                      << std::dec << ", Length: " << len << " bytes" << std::endl;
-            break;
+        if (settings->alloc_check && !alloc_watch.tick()) {
+            allocation_failed = true;
+            running = false;
+        }
     }
 }
 
-// ============ 接收线程 ============
-void receiverThread(SOCKET sock) {
-    uint8_t buffer[RECV_BUFFER_SIZE];
-    struct sockaddr_in sender_addr;
-    int sender_len = sizeof(sender_addr);
-    
+// ============ 处理线程 ============
+// 统计、解析与输出都在这里，接收线程不受影响
+void processingThread(PacketRing* ring, const ReceiverSettings* settings, StreamMetrics* metrics) {
+    Q25_TRACE_THREAD("Processing");
+    pinCurrentThread(settings->proc_cpu_core);
+    AllocationWatch alloc_watch("Processing", static_cast<uint64_t>(settings->alloc_warmup_iterations));
+
     while (running) {
-        int recv_len = recvfrom(sock, reinterpret_cast<char*>(buffer), RECV_BUFFER_SIZE, 0,
-                                (struct sockaddr*)&sender_addr, &sender_len);
-        
-        if (recv_len > 0) {
-            packet_count++;
-            
-            // Print statistics every 100 packets
-            if (packet_count % 100 == 0) {
-                char sender_ip[INET_ADDRSTRLEN];
-                inet_ntop(AF_INET, &sender_addr.sin_addr, sender_ip, INET_ADDRSTRLEN);
-                std::cout << "----------------------------------------" << std::endl;
-                std::cout << "[Statistics] Received " << packet_count << " packets, "
-                          << "From: " << sender_ip << ":" << ntohs(sender_addr.sin_port) << std::endl;
-                std::cout << "----------------------------------------" << std::endl;
-            }
-            
-            // 解析数据包
-            parsePacket(buffer, recv_len);
+        PacketSlot* slot = ring->peek();
+        if (slot == nullptr) {
+            // 环空时让出CPU
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
         }
+
+        packet_count++;
+
+        // Print statistics every 100 packets
+        if (packet_count % 100 == 0) {
+            char sender_ip[INET_ADDRSTRLEN];
+            struct in_addr sender_addr;
+            sender_addr.s_addr = slot->from_addr;
+            inet_ntop(AF_INET, &sender_addr, sender_ip, INET_ADDRSTRLEN);
+            PacketRingStats ring_stats = ring->stats();
+            std::cout << "----------------------------------------" << std::endl;
+            std::cout << "[Statistics] Received " << packet_count << " packets, "
+                      << "From: " << sender_ip << ":" << ntohs(slot->from_port) << std::endl;
+            std::cout << "[Statistics] Ring overflows: " << ring_stats.overflows
+                      << ", high water: " << ring_stats.high_water << "/" << ring->capacity()
+                      << std::endl;
+            std::cout << "----------------------------------------" << std::endl;
+        }
+
+        // 按包头时间戳统计，再解析并分发数据包
+        int64_t recv_time_ns = slot->recv_time_ns;
+        metrics->record(slot->data, slot->len, recv_time_ns);
+        status_cache.setReceiveTime(recv_time_ns);
+        dispatcher.parsePacket(slot->data, slot->len);
+        ring->release();
+
+        // 以接收时间驱动周期输出，无数据时不输出
+        if (metrics->reportDue(recv_time_ns)) {
+            metrics->report(std::cout, recv_time_ns);
+        }
+
+        if (settings->alloc_check && !alloc_watch.tick()) {
+            allocation_failed = true;
+            running = false;
+        }
+    }
+}
+
+// ============ 状态过期检查 ============
+// 在主线程中读取快照缓存，不与接收 / 处理线程争用
+void checkStaleStatus(const StatusCache& cache) {
+    int64_t now_ns = steadyNowNs();
+    IMUSnapshot imu;
+    if (cache.imu(imu) && now_ns - imu.recv_time_ns > STALE_STATUS_NS) {
+        std::cout << "[WARNING] IMU not updated for " << (now_ns - imu.recv_time_ns) / 1000000
+                  << " ms (last sequence " << imu.sequence << ")" << std::endl;
+    }
+    MotionSnapshot motion;
+    if (cache.motion(motion) && now_ns - motion.recv_time_ns > STALE_STATUS_NS) {
+        std::cout << "[WARNING] Motion state not updated for " << (now_ns - motion.recv_time_ns) / 1000000
+                  << " ms (last sequence " << motion.sequence << ")" << std::endl;
     }
 }
 
 // ============ 主函数 ============
-int main() {
-    // 初始化 Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        std::cerr << "[ERROR] Winsock initialization failed" << std::endl;
+int main(int argc, char* argv[]) {
+    // 初始化网络环境（Windows 下为 Winsock）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    // 读取配置：命令行指定的文件必须存在，默认文件可以没有
+    Config config;
+    const char* config_path = argc > 1 ? argv[1] : DEFAULT_CONFIG_PATH;
+    if (config.load(config_path)) {
+        std::cout << "[INFO] Loaded config: " << config_path << std::endl;
+    } else if (argc > 1) {
+        std::cerr << "[ERROR] Cannot open config file: " << config_path << std::endl;
         return -1;
     }
+    ReceiverSettings settings = loadSettings(config);
 
     std::cout << "========================================" << std::endl;
     std::cout << "  Quadruped Robot Status Receiver Demo" << std::endl;
@@ -231,8 +363,7 @@ int main() {
     // Create UDP socket
     SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if (sock == INVALID_SOCKET) {
-        std::cerr << "[ERROR] Socket creation failed: " << WSAGetLastError() << std::endl;
-        WSACleanup();
+        std::cerr << "[ERROR] Socket creation failed: " << lastSocketError() << std::endl;
         return -1;
     }
 
@@ -240,44 +371,200 @@ int main() {
     int opt = 1;
     setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
 
+    // 加大接收缓冲区等调优选项，需在 bind 之前设置
+    applySocketTuning(sock, settings.tuning);
+
     // Bind local address
     struct sockaddr_in local_addr;
     memset(&local_addr, 0, sizeof(local_addr));
     local_addr.sin_family = AF_INET;
-    local_addr.sin_port = htons(LOCAL_PORT);
-    local_addr.sin_addr.s_addr = INADDR_ANY;  // Listen on all network cards
+    local_addr.sin_port = htons(static_cast<uint16_t>(settings.local_port));
+    if (inet_pton(AF_INET, settings.bind_ip.c_str(), &local_addr.sin_addr) != 1) {
+        std::cerr << "[ERROR] Invalid bind address: " << settings.bind_ip << std::endl;
+        closeSocketHandle(sock);
+        return -1;
+    }
 
     if (bind(sock, (struct sockaddr*)&local_addr, sizeof(local_addr)) == SOCKET_ERROR) {
-        std::cerr << "[ERROR] Bind port " << LOCAL_PORT << " failed: " << WSAGetLastError() << std::endl;
-        closesocket(sock);
-        WSACleanup();
+        std::cerr << "[ERROR] Bind port " << settings.local_port << " failed: " << lastSocketError() << std::endl;
+        closeSocketHandle(sock);
         return -1;
     }
 
     std::cout << "[INFO] UDP Server started" << std::endl;
-    std::cout << "[INFO] Listening on port: " << LOCAL_PORT << std::endl;
+    std::cout << "[INFO] Listening on " << settings.bind_ip << ":" << settings.local_port << std::endl;
+    std::cout << "[INFO] Receive buffer: " << getRecvBufferSize(sock) << " bytes"
+              << (settings.tuning.busy_poll_us > 0 ? ", busy-poll" : "") << std::endl;
     std::cout << "[INFO] Waiting for robot status data..." << std::endl;
     std::cout << "[INFO] Press Ctrl+C to exit" << std::endl;
     std::cout << std::endl;
 
-    // 启动接收线程
-    std::thread recv_thread(receiverThread, sock);
+    // 订阅者需在开始接收前注册
+    StatusLogger status_logger(settings.log_lines_per_sec);
+    status_logger.attach(dispatcher);
+    status_cache.attach(dispatcher);
+
+    // 步态 / 模式与系统信息只在变化时立即输出，不受日志限频影响
+    StatusChangeDetector status_changes(settings.changes);
+    status_changes.attach(dispatcher);
+    status_changes.onMotionChange(MOTION_GAIT | MOTION_MODE,
+                                  [](const PacketHeader&, const MotionData& motion, uint32_t) {
+        std::cout << "[Change] Gait: 0x" << std::hex << motion.gait
+                  << ", Mode: 0x" << motion.motion_mode << std::dec << '\n';
+    });
+    status_changes.onSystemChange(SYSTEM_ALL, [](const PacketHeader&, const SystemData& system, uint32_t changed) {
+        if (changed & SYSTEM_REBOOT) {
+            std::cout << "[WARNING] Robot restarted (uptime " << system.uptime_s << " s)" << '\n';
+        }
+        if (changed & SYSTEM_VERSION) {
+            std::cout << "[Change] Firmware: 0x" << std::hex << system.firmware_version
+                      << ", Software: 0x" << system.software_version << std::dec << '\n';
+        }
+        if (changed & SYSTEM_ERROR) {
+            std::cout << "[Change] Error code: 0x" << std::hex << system.error_code << std::dec << '\n';
+        }
+        if (changed & SYSTEM_MILEAGE) {
+            std::cout << "[Change] Mileage: " << system.mileage_km << " km" << '\n';
+        }
+    });
+
+    // IMU 与关节速度历史（跌倒检测 / 振动分析用），时间轴使用机器人时间戳
+    size_t history_capacity = static_cast<size_t>(settings.history_sec * settings.history_rate_hz);
+    int64_t history_window_ns = static_cast<int64_t>(settings.history_window_sec * 1e9);
+    int64_t timestamp_unit_ns = settings.metrics.timestamp_unit_ns;
+    TimeSeriesStore imu_history(sizeof(IMUData) / sizeof(float), history_capacity, history_window_ns);
+    TimeSeriesStore joint_velocity_history(static_cast<size_t>(settings.history_joints), history_capacity,
+                                           history_window_ns);
+    int64_t next_history_report_ns = 0;
+    int64_t history_report_ns = static_cast<int64_t>(settings.metrics.report_interval_sec * 1e9);
+    dispatcher.onIMU([&imu_history, &next_history_report_ns, history_report_ns, timestamp_unit_ns](
+                         const PacketHeader& header, const IMUData& imu) {
+        int64_t time_ns = static_cast<int64_t>(header.timestamp) * timestamp_unit_ns;
+        imu_history.append(time_ns, reinterpret_cast<const float*>(&imu));
+        if (time_ns >= next_history_report_ns) {
+            // IMUData 字段顺序: roll, pitch, yaw, gyro_x/y/z, acc_x/y/z
+            WindowStats roll = imu_history.stats(0);
+            WindowStats pitch = imu_history.stats(1);
+            WindowStats acc_z = imu_history.stats(8);
+            std::cout << "[History] " << roll.count << " IMU samples in window, roll ["
+                      << roll.min << ", " << roll.max << "], pitch [" << pitch.min << ", " << pitch.max
+                      << "] rad, acc_z std " << std::sqrt(acc_z.variance) << " m/s^2" << '\n';
+            next_history_report_ns = time_ns + history_report_ns;
+        }
+    });
+
+    // 关节健康监测：每包原地更新 SoA 关节状态并做向量化阈值检查，
+    // 超限关节集合变化时输出一次
+    JointState joint_state;
+    JointLimits joint_limits = settings.joint_limits;
+    uint64_t last_alarm = 0;
+    dispatcher.onJoint([&joint_state, joint_limits, &last_alarm](const PacketHeader& header, JointSpan joints) {
+        joint_state.update(joints, header.timestamp);
+        JointHealth health = joint_state.check(joint_limits);
+        uint64_t alarm = health.over_velocity | health.over_torque | health.over_temperature;
+        if (alarm != last_alarm && alarm != 0) {
+            std::cout << "[WARNING] Joint limits exceeded, mask 0x" << std::hex << alarm << std::dec
+                      << " (max temp " << health.max_temperature << " C, torque RMS "
+                      << health.torque_rms << " Nm, max |vel| " << health.max_abs_velocity << " rad/s)" << '\n';
+        }
+        last_alarm = alarm;
+    });
+    // 在 JointState 之后注册，直接使用其速度数组
+    dispatcher.onJoint([&joint_state, &joint_velocity_history, timestamp_unit_ns](const PacketHeader& header, JointSpan) {
+        if (joint_state.size() >= joint_velocity_history.signals()) {
+            joint_velocity_history.append(static_cast<int64_t>(header.timestamp) * timestamp_unit_ns,
+                                          joint_state.velocities());
+        }
+    });
+
+    // 接收线程只负责把数据包放入缓冲环，解析与输出在处理线程中进行
+    PacketRing packet_ring(static_cast<size_t>(settings.ring_capacity),
+                           static_cast<size_t>(settings.slot_size));
+
+    // 预投递批量接收缓冲区
+    BatchReceiver receiver(static_cast<size_t>(settings.batch_size), RECV_BUFFER_SIZE);
+    if (!receiver.open(sock)) {
+        closeSocketHandle(sock);
+        return -1;
+    }
+
+    // 启动处理线程与接收线程
+    StreamMetrics metrics(settings.metrics);
+
+    // 记录器有自己的缓冲环与写入线程，不影响接收与处理
+    TelemetryRecorder recorder(settings.recorder);
+    TelemetryRecorder* active_recorder = nullptr;
+    if (settings.record_enabled) {
+        if (recorder.start()) {
+            active_recorder = &recorder;
+        } else {
+            std::cerr << "[WARNING] Telemetry recording disabled" << std::endl;
+        }
+    }
 
-    // 主线程等待（实际应用中可以添加信号处理）
+    if (settings.alloc_check) {
+        if (allocationCountingEnabled()) {
+            std::cout << "[INFO] Allocation check armed after " << settings.alloc_warmup_iterations
+                      << " iterations per thread" << std::endl;
+        } else {
+            std::cerr << "[WARNING] alloc.check requires a build with -DQ25_COUNT_ALLOCATIONS=ON, check disabled"
+                      << std::endl;
+            settings.alloc_check = false;
+        }
+    }
+
+    if (!settings.trace_file.empty()) {
+        if (traceEnabled()) {
+            traceSetBufferEvents(static_cast<size_t>(settings.trace_buffer_events));
+        } else {
+            std::cerr << "[WARNING] trace.file requires a build with -DQ25_ENABLE_TRACE=ON, no trace will be written"
+                      << std::endl;
+            settings.trace_file.clear();
+        }
+    }
+
+    std::thread proc_thread(processingThread, &packet_ring, &settings, &metrics);
+    std::thread recv_thread(receiverThread, &receiver, &packet_ring, active_recorder, &settings);
+
+    // 主线程等待 Ctrl+C，期间作为快照缓存的读者检查状态是否中断
+    std::signal(SIGINT, onSignal);
     while (running) {
-        Sleep(1000);
+        sleepMs(1000);
+        checkStaleStatus(status_cache);
     }
 
-    // Cleanup
+    // Cleanup: 接收线程按超时退出后再取消未完成的接收并关闭 socket
     running = false;
-    closesocket(sock);
     recv_thread.join();
-
-    // Cleanup Winsock
-    WSACleanup();
+    proc_thread.join();
+    recorder.stop();
+    receiver.close();
+    closeSocketHandle(sock);
 
     std::cout << std::endl;
-    std::cout << "[INFO] Total received " << packet_count << " packets" << std::endl;
+    std::cout << "[INFO] Total processed " << packet_count << " packets, "
+              << receiver.stats().datagrams << " received in "
+              << receiver.stats().syscalls << " receive calls (max batch "
+              << receiver.stats().max_batch << ")" << std::endl;
+    const ChangeDetectorStats& change_stats = status_changes.stats();
+    std::cout << "[INFO] Status changes: " << change_stats.motion_changes << "/" << change_stats.motion_packets
+              << " motion, " << change_stats.system_changes << "/" << change_stats.system_packets
+              << " system packets" << std::endl;
+    std::cout << "[INFO] Dropped " << packet_ring.stats().overflows << " packets on ring overflow, "
+              << packet_ring.stats().oversized << " oversized" << std::endl;
+    if (active_recorder != nullptr) {
+        TelemetryRecorderStats record_stats = recorder.stats();
+        std::cout << "[INFO] Recorded " << record_stats.records << " packets in "
+                  << record_stats.segments << " segment(s), dropped " << record_stats.dropped << std::endl;
+    }
+    metrics.reportTotals(std::cout);
+    if (!settings.trace_file.empty()) {
+        traceDump(settings.trace_file);
+    }
+    if (allocation_failed) {
+        std::cerr << "[ERROR] Steady-state heap allocation detected on the receive path" << std::endl;
+        return -1;
+    }
     std::cout << "[INFO] Demo finished" << std::endl;
     return 0;
 }
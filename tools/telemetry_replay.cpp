@@ -0,0 +1,250 @@
+// ====================================================================
+//          Created:    2026/10/14/ 17:40
+//	         Author:
+//	        Company:
+// ====================================================================
+
+/**
+ * @file telemetry_replay.cpp
+ * @brief 遥测记录回放工具 (Windows / Linux)
+ *
+ * 运行: telemetry_replay.exe <段文件.q25tlm> [选项]
+ *
+ *   --speed N          以 N 倍速回放（默认 1，即原始节奏）
+ *   --fast             不等待，尽快回放（用于离线压测订阅者）
+ *   --step             单步回放：回车回放下一条，输入数字回放多条，q 退出
+ *   --type T           只回放指定数据类型（1~5），可重复指定
+ *   --from SEC         跳过记录开始后的前 SEC 秒
+ *   --count N          最多回放 N 条
+ *   --target IP:PORT   指令通道：把记录的指令按原节奏发往仿真器
+ *   --quiet            不输出逐包日志，只输出统计
+ *
+ * 状态通道的记录经 StatusDispatcher::parsePacket() 交给与实时接收相同的订阅者
+ * （StatusLogger、StreamMetrics）；指令通道的记录按指令码统计，指定 --target 时
+ * 原样发送。后续段文件 (_0001, _0002, ...) 会自动接续读取。
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "net_platform.h"
+#include "q25_codec.h"
+#include "q25_protocol.h"
+#include "status_dispatcher.h"
+#include "status_logger.h"
+#include "stream_metrics.h"
+#include "telemetry_reader.h"
+#include "telemetry_replay.h"
+#include "udp_transport.h"
+
+using namespace q25;
+
+// ============ 命令行参数 ============
+struct ReplayOptions {
+    std::string path;
+    double speed;
+    bool step;
+    uint32_t type_mask;
+    double from_sec;
+    uint64_t count;
+    std::string target_ip;
+    int target_port;
+    bool quiet;
+
+    ReplayOptions()
+        : speed(1.0)
+        , step(false)
+        , type_mask(TELEMETRY_ALL_TYPES)
+        , from_sec(0.0)
+        , count(0)
+        , target_port(0)
+        , quiet(false) {}
+};
+
+void printUsage() {
+    std::cout << "Usage: telemetry_replay <segment.q25tlm> [--speed N | --fast | --step]" << std::endl;
+    std::cout << "                        [--type T]... [--from SEC] [--count N]" << std::endl;
+    std::cout << "                        [--target IP:PORT] [--quiet]" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], ReplayOptions& options) {
+    bool type_set = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--speed" && has_value) {
+            options.speed = atof(argv[++i]);
+        } else if (arg == "--fast") {
+            options.speed = 0.0;
+        } else if (arg == "--step") {
+            options.step = true;
+        } else if (arg == "--type" && has_value) {
+            if (!type_set) {
+                options.type_mask = 0;
+                type_set = true;
+            }
+            options.type_mask |= 1u << telemetryTypeSlot(static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0)));
+        } else if (arg == "--from" && has_value) {
+            options.from_sec = atof(argv[++i]);
+        } else if (arg == "--count" && has_value) {
+            options.count = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--target" && has_value) {
+            std::string target = argv[++i];
+            size_t colon = target.rfind(':');
+            if (colon == std::string::npos) {
+                std::cerr << "[ERROR] Expected IP:PORT for --target" << std::endl;
+                return false;
+            }
+            options.target_ip = target.substr(0, colon);
+            options.target_port = atoi(target.c_str() + colon + 1);
+        } else if (arg == "--quiet") {
+            options.quiet = true;
+        } else if (arg[0] != '-' && options.path.empty()) {
+            options.path = arg;
+        } else {
+            std::cerr << "[ERROR] Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return !options.path.empty();
+}
+
+// ============ 指令通道统计 ============
+// 简单指令与扩展指令的第一个字段都是指令码
+uint32_t commandCode(const TelemetryRecord& record) {
+    return peekCommandCode(record.data, record.header->length);
+}
+
+// ============ 主函数 ============
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return -1;
+    }
+
+    TelemetryReader reader;
+    if (!reader.open(options.path)) {
+        return -1;
+    }
+    reader.setTypeFilter(options.type_mask);
+    bool command_channel = reader.segmentHeader().channel == TELEMETRY_CHANNEL_COMMAND;
+    if (options.from_sec > 0.0) {
+        int64_t from_ns = reader.segmentHeader().first_recv_ns + static_cast<int64_t>(options.from_sec * 1e9);
+        if (!reader.seekTime(from_ns)) {
+            std::cerr << "[ERROR] No records after " << options.from_sec << "s" << std::endl;
+            return -1;
+        }
+    }
+
+    // 初始化网络环境（向仿真器发送指令时需要）
+    NetworkRuntime network;
+    if (!network.ok()) {
+        return -1;
+    }
+
+    UdpTransport transport;
+    if (!options.target_ip.empty() && !transport.open(options.target_ip.c_str(), options.target_port)) {
+        return -1;
+    }
+
+    std::cout << "[INFO] Replaying " << options.path << " ("
+              << (command_channel ? "command" : "status") << " channel, ";
+    if (options.step) {
+        std::cout << "step";
+    } else if (options.speed > 0.0) {
+        std::cout << options.speed << "x";
+    } else {
+        std::cout << "as fast as possible";
+    }
+    std::cout << ")" << std::endl;
+
+    // 状态通道：与实时接收相同的分发路径
+    StatusDispatcher dispatcher;
+    StatusLogger status_logger(1.0);
+    if (!options.quiet) {
+        status_logger.attach(dispatcher);
+    }
+    StreamMetrics metrics;
+
+    std::map<uint32_t, uint64_t> command_counts;
+
+    TelemetryReplayer::RecordHandler handler = [&](const TelemetryRecord& record) {
+        if (command_channel) {
+            uint32_t code = commandCode(record);
+            command_counts[code]++;
+            if (transport.isOpen()) {
+                transport.sendRaw(record.data, record.header->length);
+            }
+            if (options.step) {
+                std::cout << "[Command] 0x" << std::hex << code << std::dec
+                          << ", " << record.header->length << " bytes" << std::endl;
+            }
+            return;
+        }
+        metrics.record(record.data, record.header->length, record.header->recv_time_ns);
+        dispatcher.parsePacket(record.data, record.header->length);
+        if (!options.quiet && metrics.reportDue(record.header->recv_time_ns)) {
+            metrics.report(std::cout, record.header->recv_time_ns);
+        }
+    };
+
+    TelemetryReplayConfig replay_config;
+    replay_config.speed = options.speed;
+    replay_config.max_records = options.count;
+    TelemetryReplayer replayer(reader, replay_config);
+
+    if (options.step) {
+        // 单步：回放完一批后等待输入
+        std::string line;
+        bool more = true;
+        while (more) {
+            std::cout << "> " << std::flush;
+            if (!std::getline(std::cin, line) || line == "q") {
+                break;
+            }
+            long batch = line.empty() ? 1 : atol(line.c_str());
+            for (long i = 0; i < batch && more; i++) {
+                more = replayer.step(handler);
+            }
+        }
+    } else {
+        replayer.run(handler);
+    }
+
+    // ============ 统计 ============
+    const TelemetryReplayStats& stats = replayer.stats();
+    double recorded_sec = static_cast<double>(stats.recorded_ns) / 1e9;
+    double elapsed_sec = static_cast<double>(stats.elapsed_ns) / 1e9;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "[INFO] Replayed " << stats.records << " records covering " << recorded_sec
+              << "s in " << elapsed_sec << "s";
+    if (elapsed_sec > 0.0) {
+        std::cout << " (" << recorded_sec / elapsed_sec << "x, "
+                  << static_cast<double>(stats.records) / elapsed_sec << " records/s)";
+    }
+    std::cout << ", late " << stats.late << std::endl;
+    std::cout << "[INFO] Segments " << reader.stats().segments << ", chunks skipped "
+              << reader.stats().chunks_skipped << ", corrupt " << reader.stats().corrupt << std::endl;
+
+    if (command_channel) {
+        for (std::map<uint32_t, uint64_t>::const_iterator it = command_counts.begin();
+             it != command_counts.end(); ++it) {
+            std::cout << "[Command] 0x" << std::hex << it->first << std::dec
+                      << ": " << it->second << std::endl;
+        }
+    } else {
+        const DispatchStats& dispatch = dispatcher.stats();
+        std::cout << "[INFO] Dispatched " << dispatch.packets << " packets, "
+                  << dispatch.short_packets << " short, " << dispatch.size_mismatch << " size mismatch, "
+                  << dispatch.unknown << " unknown" << std::endl;
+        metrics.reportTotals(std::cout);
+    }
+
+    transport.close();
+    return 0;
+}